@@ -1,7 +1,10 @@
 #pragma once
 #include "Listenable.h"
 #include "Event.h"
+#include "EventObserver.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 
 class IEventManager {
 public:
@@ -12,11 +15,25 @@ public:
 				return left.second.priority > right.second.priority;
 			});
 
+		auto obs = observer.load(std::memory_order_acquire);
+		bool timeListeners = false;
+		if (obs) {
+			obs->onDispatch(T::hash, ev);
+			timeListeners = obs->wantsListenerTimes();
+		}
+
 		for (auto& pair : listeners) {
 			if (pair.first == T::hash) {
 				if (pair.second.listener->shouldListen() || pair.second.callWhileInactive) {
 					auto isCancel = ev.isCancellable();
-					(pair.second.listener->*pair.second.fptr)(ev);
+					if (timeListeners) {
+						auto start = std::chrono::steady_clock::now();
+						(pair.second.listener->*pair.second.fptr)(ev);
+						obs->onListenerTime(T::hash, pair.second.listener, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+					}
+					else {
+						(pair.second.listener->*pair.second.fptr)(ev);
+					}
 					if (isCancel) {
 						auto& cEv = reinterpret_cast<Cancellable&>(ev);
 						if (cEv.isCancelled()) {
@@ -48,8 +65,18 @@ public:
 		mutex.unlock();
 	}
 
+	// Set to trace or profile dispatches; nullptr when unused. Set from any thread; dispatches pick it up as they start.
+	void setObserver(IEventObserver* obs) {
+		observer.store(obs, std::memory_order_release);
+	}
+
+	[[nodiscard]] IEventObserver* getObserver() {
+		return observer.load(std::memory_order_acquire);
+	}
+
 	//virtual void init() = 0;
 protected:
+	std::atomic<IEventObserver*> observer = nullptr;
 	std::mutex mutex;
 	std::vector<std::pair<uint32_t, EventListener>> listeners;
 };
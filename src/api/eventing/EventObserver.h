@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+
+class Event;
+class Listener;
+
+// Optional instrumentation hook for the event manager, used for tracing and profiling dispatches.
+class IEventObserver {
+public:
+	virtual ~IEventObserver() = default;
+
+	// Called once per dispatch, before any listener runs.
+	virtual void onDispatch(uint32_t eventHash, Event& ev) = 0;
+	// Called after each listener returns, with the time it took in nanoseconds.
+	virtual void onListenerTime(uint32_t eventHash, Listener* listener, int64_t nanoseconds) = 0;
+	// Whether listener calls should be timed at all (timing every call isn't free)
+	[[nodiscard]] virtual bool wantsListenerTimes() { return false; }
+};
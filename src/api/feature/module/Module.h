@@ -26,6 +26,9 @@ public:
 	virtual void onEnable() {};
 	virtual void onDisable() {};
 	virtual void onInit() {};
+	// Called on the game thread when the client is about to eject. Anything that waits on a thread has to stop
+	// here: the rest of the teardown (including onDisable) runs in DllMain, under the loader lock.
+	virtual void onEject() {};
 
 	[[nodiscard]] KeyValue getKeybind() { return std::get<KeyValue>(key); }
 	[[nodiscard]] bool isEnabled() { return std::get<BoolValue>(enabled); };
@@ -395,6 +395,8 @@ public:
 	Condition condition;
 
 	bool visible = true;
+	// Key settings only: whether Ctrl/Shift/Alt chords can be bound
+	bool allowChords = false;
 
 	struct {
 		bool init = false;
@@ -136,27 +136,13 @@ DWORD __stdcall startThread(HINSTANCE dll) {
     int sigCount = 0;
     int deadCount = 0;
 
-    std::unordered_map<std::string, SDK::Version> versNumMap = {
-        { "1.21.20", SDK::VLATEST },
-        { "1.21.21", SDK::VLATEST },
-        //{ "1.21.0", SDK::V1_21 },
-        //{ "1.21.1", SDK::V1_21 },
-        //{ "1.21.2", SDK::V1_21 },
-        //{ "1.20.41", SDK::V1_20_40 },
-        //{ "1.20.40", SDK::V1_20_40 },
-        //{ "1.20.32", SDK::V1_20_30 },
-        //{ "1.20.31", SDK::V1_20_30 },
-        //{ "1.20.30", SDK::V1_20_30 },
-        //{ "1.19.50", SDK::V1_19_51 },
-        //{ "1.19.51", SDK::V1_19_51 },
-        //{ "1.18.12", SDK::V1_18_12 },
-        //{ "1.18.10", SDK::V1_18_12 },
-    };
+    std::unordered_map<std::string, SDK::Version> versNumMap;
+    for (auto& supported : SDK::supportedVersions) {
+        versNumMap.emplace(supported.name, supported.version);
+    }
 
     if (versNumMap.contains(Latite::get().gameVersion)) {
-        // not needed as it will always just be latest
-        //auto vers =  versNumMap[Latite::get().gameVersion];
-        //SDK::internalVers = vers;
+        SDK::internalVers = versNumMap[Latite::get().gameVersion];
     }
     else {
         std::stringstream ss;
@@ -170,6 +156,8 @@ DWORD __stdcall startThread(HINSTANCE dll) {
     }
 
     Logger::Info(XOR_STRING("Minecraft SDK version {}"), SDK::internalVers);
+    // versioned fields read their offsets from this layout from now on
+    SDK::selectLayout(SDK::internalVers);
 
     std::vector<std::pair<SigImpl*, SigImpl*>> sigList = {
         MVSIG(Misc::minecraftGamePointer),
@@ -405,14 +393,17 @@ std::optional<float> Latite::getMenuBlur() {
     return std::nullopt;
 }
 
-std::vector<std::string> Latite::getLatiteUsers() {
-    return latiteUsers;
-}
-
 void Latite::queueEject() noexcept {
     auto app = winrt::Windows::UI::ViewManagement::ApplicationView::GetForCurrentView();
     app.Title(L"");
     this->shouldEject = true;
+
+    // Stop everything that owns a thread while we're still on the game thread; see IModule::onEject
+    getPluginManager().uninitialize();
+    getModuleManager().forEach([](std::shared_ptr<IModule> mod) {
+        mod->onEject();
+        });
+
     CloseHandle(CreateThread(nullptr, 0, (LPTHREAD_START_ROUTINE)FreeLibraryAndExitThread, dllInst, 0, nullptr));
 }
 
@@ -557,7 +548,7 @@ namespace {
 void Latite::fetchLatiteUsers() {
     auto lp = SDK::ClientInstance::get()->getLocalPlayer();
     if (!lp) {
-        latiteUsers = {};
+        latiteUsers.replace({});
         return;
     }
 
@@ -570,8 +561,8 @@ void Latite::fetchLatiteUsers() {
     auto content = HttpStringContent(util::StrToWStr(XOR_STRING("{\"name\":\"")) + name + util::StrToWStr(XOR_STRING("\"}")));
     std::string medType = XOR_STRING("application/json");
     content.Headers().ContentType().MediaType(util::StrToWStr(medType));
-    auto usersDirty = &this->latiteUsersDirty;
-    client.PostAsync(requestUri, content).Completed([usersDirty](winrt::Windows::Foundation::IAsyncOperationWithProgress<HttpResponseMessage, HttpProgress> task, winrt::Windows::Foundation::AsyncStatus status) {
+    auto users = &this->latiteUsers;
+    client.PostAsync(requestUri, content).Completed([users](winrt::Windows::Foundation::IAsyncOperationWithProgress<HttpResponseMessage, HttpProgress> task, winrt::Windows::Foundation::AsyncStatus status) {
         if (status == winrt::Windows::Foundation::AsyncStatus::Completed) {
             try {
                 auto res = task.GetResults();
@@ -579,16 +570,15 @@ void Latite::fetchLatiteUsers() {
                     auto cont = res.Content();
                     auto str = cont.ReadAsStringAsync().get();
 
-                    nlohmann::json json;
                     try {
-
-                        json = nlohmann::json::parse(util::WStrToStr(str.c_str()));
-                    }
-                    catch (nlohmann::json::parse_error&) {
-                        usersDirty->clear();
+                        auto json = nlohmann::json::parse(util::WStrToStr(str.c_str()));
+                        std::vector<std::string> names;
                         for (auto& item : json) {
-                            usersDirty->push_back(item.get<std::string>());
+                            if (item.is_string()) names.push_back(item.get<std::string>());
                         }
+                        users->replace(std::move(names));
+                    }
+                    catch (nlohmann::json::parse_error&) {
                     }
                 }
             }
@@ -747,12 +737,18 @@ void Latite::queueForUIRender(std::function<void(SDK::MinecraftUIRenderContext*
     this->uiRenderQueue.push(callback);
 }
 
-void Latite::queueForClientThread(std::function<void()> callback) {
-    this->clientThreadQueue.push(callback);
+void Latite::queueForClientThread(std::function<void()> callback, JobOptions options) {
+    this->clientThreadQueue.push(std::move(callback), options);
+}
+
+void Latite::queueForDXRender(std::function<void(ID2D1DeviceContext* ctx)> callback, JobOptions options) {
+    this->dxRenderQueue.push(std::move(callback), options);
 }
 
-void Latite::queueForDXRender(std::function<void(ID2D1DeviceContext* ctx)> callback) {
-    this->dxRenderQueue.push(callback);
+void Latite::cancelQueuedJobs(void const* owner) {
+    auto key = reinterpret_cast<uintptr_t>(owner);
+    this->clientThreadQueue.cancel(key);
+    this->dxRenderQueue.cancel(key);
 }
 
 void Latite::initAsset(int resource, std::wstring const& filename) {
@@ -836,11 +832,7 @@ void Latite::onUpdate(Event& evGeneric) {
     auto now = std::chrono::system_clock::now();
     static auto lastSend = now;
 
-    while (!this->clientThreadQueue.empty()) {
-        auto& latest = this->clientThreadQueue.front();
-        latest();
-        this->clientThreadQueue.pop();
-    }
+    this->clientThreadQueue.run(client_thread_budget);
 
     auto rak = SDK::RakNetConnector::get();
 
@@ -872,8 +864,6 @@ void Latite::onUpdate(Event& evGeneric) {
         //}
     }
 
-    latiteUsers = latiteUsersDirty;
-
     if (!hasInit) {
         threadsafeInit();
         hasInit = true;
@@ -1037,11 +1027,7 @@ void Latite::onRenderOverlay(Event& evG) {
         getRenderer().updateSecondaryFont(std::get<TextValue>(secondaryFont).str);
     }
 
-    while (!this->dxRenderQueue.empty()) {
-        auto& latest = this->dxRenderQueue.front();
-        latest(ev.getDeviceContext());
-        this->dxRenderQueue.pop();
-    }
+    this->dxRenderQueue.run(dx_render_budget, ev.getDeviceContext());
 
     static auto time = std::chrono::steady_clock::now();
     auto now = std::chrono::steady_clock::now();
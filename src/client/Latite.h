@@ -5,6 +5,8 @@
 #include <optional>
 #include "misc/Timings.h"
 #include "misc/Notifications.h"
+#include "misc/UserSet.h"
+#include "misc/JobQueue.h"
 #include "localization/LocalizeData.h"
 
 namespace ui {
@@ -46,8 +48,15 @@ public:
 	void initSettings();
 
 	void queueForUIRender(std::function<void(SDK::MinecraftUIRenderContext* ctx)> callback);
-	void queueForClientThread(std::function<void()> callback);
-	void queueForDXRender(std::function<void(ID2D1DeviceContext* ctx)> callback);
+	// Safe from any thread. Jobs run a frame's budget at a time, so a burst of them may take a few frames;
+	// give a deadline (or a higher priority) to anything that can't wait, and an owner to anything that captures
+	// something which can be destroyed before then.
+	void queueForClientThread(std::function<void()> callback, JobOptions options = {});
+	void queueForDXRender(std::function<void(ID2D1DeviceContext* ctx)> callback, JobOptions options = {});
+	// Drops the jobs `owner` queued on the client thread and the DX render thread; call it before `owner` is destroyed
+	void cancelQueuedJobs(void const* owner);
+	[[nodiscard]] auto getClientThreadJobStats() const { return clientThreadQueue.getStats(); }
+	[[nodiscard]] auto getDXRenderJobStats() const { return dxRenderQueue.getStats(); }
 
 	Latite() = default;
 	~Latite() = default;
@@ -71,7 +80,7 @@ public:
 		}
 	}
 
-	std::vector<std::string> getLatiteUsers();
+	[[nodiscard]] UserSet& getLatiteUsers() { return latiteUsers; }
 
 	[[nodiscard]] KeyValue getMenuKey() {
 		return std::get<KeyValue>(menuKey);
@@ -123,12 +132,15 @@ private:
 	std::optional<LocalizeData> l10nData;
 
 	bool downloadingAssets = false;
-	std::vector<std::string> latiteUsers;
-	std::vector<std::string> latiteUsersDirty;
+	UserSet latiteUsers;
 
 	std::queue<std::function<void(SDK::MinecraftUIRenderContext* ctx)>> uiRenderQueue;
-	std::queue<std::function<void(ID2D1DeviceContext* ctx)>> dxRenderQueue;
-	std::queue<std::function<void()>> clientThreadQueue;
+	// how long each update (or overlay render) may spend on queued jobs
+	static constexpr std::chrono::microseconds client_thread_budget{ 2000 };
+	static constexpr std::chrono::microseconds dx_render_budget{ 1000 };
+
+	JobQueue<ID2D1DeviceContext*> dxRenderQueue;
+	JobQueue<> clientThreadQueue;
 
 	Timings timings{};
 	inline static std::optional<std::thread::id> gameThreadId;
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <optional>
+#include "util/ByteCodec.h"
+
+// Compact binary trace of dispatched events.
+//
+// Layout: "LTRC" magic, u16 version, then records of
+//   varint time delta (microseconds since the previous record), u32 event hash, varint payload size, payload.
+// Payloads are small per-event summaries written with PayloadWriter, and are skipped by readers that don't know the event.
+// Everything here is plain C++ so traces can be produced and consumed outside the game.
+namespace trace {
+	inline constexpr char magic[4] = { 'L', 'T', 'R', 'C' };
+	inline constexpr uint16_t version = 1;
+
+	// payloads are written and read with the shared byte codec
+	using PayloadWriter = util::ByteWriter;
+	using PayloadReader = util::ByteReader;
+
+	struct Record {
+		uint64_t timeMicros = 0;
+		uint32_t eventHash = 0;
+		std::vector<uint8_t> payload;
+	};
+
+	class TraceWriter {
+	public:
+		TraceWriter() {
+			clear();
+		}
+
+		void clear() {
+			buffer.clear();
+			buffer.insert(buffer.end(), std::begin(magic), std::end(magic));
+			buffer.push_back(static_cast<uint8_t>(version));
+			buffer.push_back(static_cast<uint8_t>(version >> 8));
+			lastTime = 0;
+			count = 0;
+		}
+
+		void add(uint64_t timeMicros, uint32_t eventHash, std::vector<uint8_t> const& payload) {
+			PayloadWriter writer{ buffer };
+			writer.putVarint(timeMicros >= lastTime ? timeMicros - lastTime : 0);
+			writer.putU32(eventHash);
+			writer.putVarint(payload.size());
+			writer.putBytes(payload.data(), payload.size());
+			lastTime = std::max(lastTime, timeMicros);
+			count++;
+		}
+
+		[[nodiscard]] std::vector<uint8_t> const& data() const { return buffer; }
+		[[nodiscard]] size_t recordCount() const { return count; }
+
+		// Writes to a temporary file first so an interrupted save never leaves a truncated trace behind.
+		bool save(std::filesystem::path const& path) const {
+			auto tmp = path;
+			tmp += ".tmp";
+			{
+				std::ofstream ofs{ tmp, std::ios::binary | std::ios::trunc };
+				if (!ofs) return false;
+				ofs.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+				if (!ofs) return false;
+			}
+			std::error_code ec;
+			std::filesystem::rename(tmp, path, ec);
+			return !ec;
+		}
+	private:
+		std::vector<uint8_t> buffer;
+		uint64_t lastTime = 0;
+		size_t count = 0;
+	};
+
+	class TraceReader {
+	public:
+		explicit TraceReader(std::vector<uint8_t> data) : buffer(std::move(data)) {
+			PayloadReader reader{ buffer.data(), buffer.size() };
+			auto head = reader.getBytes(sizeof(magic));
+			uint8_t lo = reader.getU8();
+			uint8_t hi = reader.getU8();
+			valid = reader.ok() && std::memcmp(head, magic, sizeof(magic)) == 0 && (lo | (hi << 8)) == version;
+			pos = reader.position();
+		}
+
+		[[nodiscard]] static std::optional<TraceReader> load(std::filesystem::path const& path) {
+			std::ifstream ifs{ path, std::ios::binary };
+			if (!ifs) return std::nullopt;
+			std::vector<uint8_t> data{ std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+			TraceReader reader{ std::move(data) };
+			if (!reader.isValid()) return std::nullopt;
+			return reader;
+		}
+
+		[[nodiscard]] bool isValid() const { return valid; }
+
+		// Reads the next record. Returns false at the end of the trace or if it's corrupt.
+		bool next(Record& rec) {
+			if (!valid || pos >= buffer.size()) return false;
+			PayloadReader reader{ buffer.data() + pos, buffer.size() - pos };
+			time += reader.getVarint();
+			rec.timeMicros = time;
+			rec.eventHash = reader.getU32();
+			auto len = reader.getVarint();
+			auto bytes = reader.getBytes(static_cast<size_t>(len));
+			if (!reader.ok()) {
+				valid = false;
+				return false;
+			}
+			rec.payload.assign(bytes, bytes + len);
+			pos += reader.position();
+			return true;
+		}
+	private:
+		std::vector<uint8_t> buffer;
+		size_t pos = 0;
+		uint64_t time = 0;
+		bool valid = false;
+	};
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "api/eventing/Event.h"
+#include "util/FNV32.h"
+#include <cstdint>
+
+// Stand-ins for events whose real form carries game pointers, built from a trace's payload summaries.
+// Only EventRecorder::replay dispatches these, into its own dispatcher; `timeMicros` is the record's time in the trace.
+
+class ReplayTickEvent : public Event {
+public:
+	static const uint32_t hash = TOHASH(ReplayTickEvent);
+
+	ReplayTickEvent(uint64_t timeMicros) : timeMicros(timeMicros) {}
+
+	uint64_t timeMicros;
+};
+
+class ReplayAttackEvent : public Event {
+public:
+	static const uint32_t hash = TOHASH(ReplayAttackEvent);
+
+	ReplayAttackEvent(uint64_t timeMicros, int64_t runtimeId) : timeMicros(timeMicros), runtimeId(runtimeId) {}
+
+	uint64_t timeMicros;
+	int64_t runtimeId;
+};
+
+// An ActorEventPacket the client received
+class ReplayActorEvent : public Event {
+public:
+	static const uint32_t hash = TOHASH(ReplayActorEvent);
+
+	ReplayActorEvent(uint64_t timeMicros, int64_t runtimeId, uint8_t eventId) : timeMicros(timeMicros), runtimeId(runtimeId), eventId(eventId) {}
+
+	uint64_t timeMicros;
+	int64_t runtimeId;
+	uint8_t eventId;
+};
@@ -14,6 +14,7 @@
 #include "impl/SetPrefixCommand.h"
 #include "impl/ConfigCommand.h"
 #include "impl/SignCommand.h"
+#include "impl/TraceCommand.h"
 //
 
 CommandManager::CommandManager() {
@@ -28,103 +29,67 @@ CommandManager::CommandManager() {
 	this->items.push_back(std::make_shared<ConfigCommand>());
 #if LATITE_DEBUG
 	this->items.push_back(std::make_shared<SignCommand>());
+	this->items.push_back(std::make_shared<TraceCommand>());
 #endif
+	rebuildIndex();
 }
 
 bool CommandManager::runCommand(std::string const& line) {
-	if (line.substr(0, prefix.size()) != prefix) {
+	if (!line.starts_with(prefix)) {
 		return false;
 	}
 	std::string myLine = line.substr(prefix.size());
+	CommandLine parsed{ myLine };
 
-	bool isQuoted = false;
-	bool isEscaped = false;
-	std::vector<std::string> newArgs = {};
+	if (parsed.empty()) {
+		runCommand(prefix + "help");
+		return false;
+	}
 
+	std::string label = util::ToLower(std::string(parsed[0]));
+	auto found = index.find(label);
+	if (!found) {
+		Latite::getClientMessageQueue().push(util::Format("&cUnknown command: " + std::string(parsed[0]) + "."));
+		return false;
+	}
 
-	std::string word = "";
+	auto cmd = *found;
+	std::vector<std::string> args{ parsed.tokens().begin() + 1, parsed.tokens().end() };
+	try {
+		bool result = cmd->tryRun(label, args, myLine);
+		if (!result) {
+			std::string usage = cmd->getUsage();
 
-	// parser
-	for (size_t i = 0; i < myLine.size(); i++) {
-		char ch = myLine[i];
-		if (ch == '\\' && !isEscaped) {
-			isEscaped = true;
-			continue;
-		}
-		if (!isEscaped) {
-			if (ch == '"') {
-				if (isQuoted) {
-					newArgs.push_back(word);
-					word = "";
-				}
-				isQuoted = !isQuoted;
-				continue;
+			size_t pos = 0;
+			while ((pos = usage.find("$", pos)) != std::string::npos) {
+				usage.replace(pos, strlen("$"), prefix + label);
+				pos += strlen("$");
 			}
-		}
-		if (isQuoted) {
-			word += ch;
-			continue;
-		}
-		if (!isEscaped) {
-			if (ch == ' ' || myLine.size() - i < 2) {
-				if (myLine.size() - i < 2) {
-					word += ch;
-				}
-				if (!word.empty()) {
-					newArgs.push_back(word);
-					word = "";
-				}
-				continue;
-			}
-		}
 
-		word += ch;
-		isEscaped = false;
+			Latite::getClientMessageQueue().push(util::Format("&cUsage: " + usage));
+		}
+		return result;
 	}
+	catch (std::exception& e) {
+		Logger::Warn("An unhandled exception occured while running this command: {}", e.what());
+		Latite::getClientMessageQueue().push(util::Format(std::string("&cAn unhandled exception occured while running this command: ") + e.what()));
+		return false;
+	}
+}
 
-	// Sort all commands alphabetically
+void CommandManager::rebuildIndex() {
 	std::sort(items.begin(), items.end(), [](std::shared_ptr<ICommand>& left, std::shared_ptr<ICommand>& right) {
 		return left->name() < right->name();
 		});
-	
-	if (!newArgs.empty()) {
-		std::string label = util::ToLower(newArgs[0]);
-		for (auto& cmd : this->items) {
-			for (std::string alias : cmd->getAliases()) {
-				if (alias == label /*label*/) {
-					std::vector<std::string> args;
-					for (size_t k = 1; k < newArgs.size(); k++) {
-						args.push_back(newArgs[k]);
-					}
-					try {
-						bool result = cmd->tryRun(label, args, myLine);
-						if (!result) {
-							std::string usage = cmd->getUsage();
 
-							size_t pos = 0;
-							while ((pos = usage.find("$", pos)) != std::string::npos) {
-								usage.replace(pos, strlen("$"), prefix + label);
-								pos += strlen("$");
-							}
-
-							Latite::getClientMessageQueue().push(util::Format("&cUsage: " + usage));
-						}
-						return result;
-					}
-					catch (std::exception& e) {
-						Logger::Warn("An unhandled exception occured while running this command: {}", e.what());
-						Latite::getClientMessageQueue().push(util::Format(std::string("&cAn unhandled exception occured while running this command: ") + e.what()));
-						return false;
-					}
-				}
-			}
-		}
+	index.clear();
+	// names first, so a command's name always beats another command's alias
+	for (auto& cmd : this->items) {
+		index.add(cmd->name(), cmd.get());
 	}
-	else {
-		runCommand(prefix + "help");
-		return false;
+	for (auto& cmd : this->items) {
+		for (auto& alias : cmd->getAliases()) {
+			index.add(alias, cmd.get());
+		}
 	}
-
-	Latite::getClientMessageQueue().push(util::Format("&cUnknown command: " + (newArgs.empty() ? "" : newArgs[0]) + "."));
-	return false;
 }
@@ -2,6 +2,7 @@
 #include "api/feature/command/CommandManager.h"
 #include "client/feature/command/script/JsCommand.h"
 #include "Command.h"
+#include "CommandParser.h"
 
 class CommandManager final : public ICommandManager {
 public:
@@ -11,6 +12,7 @@ public:
 	virtual ~CommandManager() = default;
 
 	bool runCommand(std::string const& line);
+
 	bool registerScriptCommand(JsCommand* cmd) {
 		for (auto& mod_ : items) {
 			if (mod_->name() == cmd->name()) {
@@ -19,6 +21,7 @@ public:
 		}
 		this->items.push_back(std::shared_ptr<JsCommand>(cmd));
 		JS::JsAddRef(cmd->obj, nullptr);
+		rebuildIndex();
 		return true;
 	}
 
@@ -26,9 +29,15 @@ public:
 		for (auto it = items.begin(); it != items.end(); it++) {
 			if (it->get() == cmd) {
 				items.erase(it);
+				rebuildIndex();
 				return true;
 			}
 		}
 		return false;
 	}
+private:
+	CommandIndex<ICommand*> index;
+
+	// Sorts the commands by name (the order help lists them in) and indexes their names and aliases
+	void rebuildIndex();
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Splits a command line into arguments in one pass.
+// Spaces and tabs separate arguments, double quotes group text (including spaces) into one argument and can
+// start or stop in the middle of one, and a backslash makes the next character literal. "" is an empty argument.
+// An unterminated quote runs to the end of the line, and a trailing backslash is kept as is.
+//
+// Unescaped text is written into a buffer owned by this object, which the tokens point into.
+class CommandLine {
+public:
+	explicit CommandLine(std::string_view line) {
+		// each token is at most as long as the line, so the buffer never reallocates under the views
+		buffer.resize(line.size());
+		char* out = buffer.data();
+		char* tokenStart = nullptr;
+		bool quoted = false;
+
+		for (size_t i = 0; i < line.size(); i++) {
+			char ch = line[i];
+			if (!quoted && (ch == ' ' || ch == '\t')) {
+				if (tokenStart) {
+					argv.emplace_back(tokenStart, static_cast<size_t>(out - tokenStart));
+					tokenStart = nullptr;
+				}
+				continue;
+			}
+
+			if (!tokenStart) tokenStart = out;
+			if (ch == '"') {
+				quoted = !quoted;
+			}
+			else if (ch == '\\' && i + 1 < line.size()) {
+				*out++ = line[++i];
+			}
+			else {
+				*out++ = ch;
+			}
+		}
+
+		if (tokenStart) argv.emplace_back(tokenStart, static_cast<size_t>(out - tokenStart));
+		unterminated = quoted;
+	}
+
+	CommandLine(CommandLine const&) = delete;
+	CommandLine& operator=(CommandLine const&) = delete;
+
+	[[nodiscard]] std::span<std::string_view const> tokens() const { return argv; }
+	[[nodiscard]] size_t size() const { return argv.size(); }
+	[[nodiscard]] bool empty() const { return argv.empty(); }
+	[[nodiscard]] std::string_view operator[](size_t i) const { return argv[i]; }
+
+	[[nodiscard]] bool hasUnterminatedQuote() const { return unterminated; }
+private:
+	std::string buffer;
+	std::vector<std::string_view> argv;
+	bool unterminated = false;
+};
+
+// Case-insensitive (ASCII) lookup of command names and aliases.
+// Build it once whenever the set of commands changes; lookups don't allocate.
+// When two commands share a name, the one added first wins.
+template <typename T>
+class CommandIndex {
+public:
+	void clear() {
+		entries.clear();
+		byName.clear();
+	}
+
+	// Returns false if the name was already taken
+	bool add(std::string_view name, T value) {
+		if (byName.contains(name)) return false;
+
+		auto idx = static_cast<uint32_t>(entries.size());
+		entries.push_back(std::move(value));
+		byName.emplace(std::string(name), idx);
+		return true;
+	}
+
+	[[nodiscard]] T const* find(std::string_view name) const {
+		auto it = byName.find(name);
+		return it == byName.end() ? nullptr : &entries[it->second];
+	}
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+private:
+	static char lower(char ch) {
+		return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+	}
+
+	struct Hash {
+		using is_transparent = void;
+		size_t operator()(std::string_view str) const {
+			uint64_t hash = 0xcbf29ce484222325ull;
+			for (char ch : str) {
+				hash = (hash ^ static_cast<unsigned char>(lower(ch))) * 0x100000001b3ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	struct Equal {
+		using is_transparent = void;
+		bool operator()(std::string_view a, std::string_view b) const {
+			return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return lower(x) == lower(y); });
+		}
+	};
+
+	std::vector<T> entries;
+	std::unordered_map<std::string, uint32_t, Hash, Equal> byName;
+};
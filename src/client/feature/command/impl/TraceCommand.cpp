@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "TraceCommand.h"
+#include "util/Util.h"
+#include "client/misc/ReplayProbes.h"
+
+TraceCommand::TraceCommand() : Command("trace", LocalizeString::get("client.commands.trace.desc"),
+	"\n$ record\n$ stop [name]\n$ replay <name>") {
+}
+
+std::filesystem::path TraceCommand::getTracePath(std::string const& name) {
+	return util::GetLatitePath() / "Traces" / (name + ".ltrace");
+}
+
+bool TraceCommand::execute(std::string const label, std::vector<std::string> args) {
+	if (args.empty()) return false;
+
+	if (args[0] == "record") {
+		if (recorder.isRecording()) {
+			message(LocalizeString::get("client.commands.trace.alreadyRecording.name"), true);
+			return true;
+		}
+		recorder.startRecording();
+		message(LocalizeString::get("client.commands.trace.record.name"));
+		return true;
+	}
+
+	if (args[0] == "stop") {
+		if (args.size() > 2) return false;
+		if (!recorder.isRecording()) {
+			message(LocalizeString::get("client.commands.trace.notRecording.name"), true);
+			return true;
+		}
+		std::string name = args.size() == 2 ? args[1] : "latest";
+		if (auto count = recorder.stopRecording(getTracePath(name))) {
+			message(util::FormatWString(LocalizeString::get("client.commands.trace.saved.name"),
+				{ std::to_wstring(*count), util::StrToWStr(name) }));
+		}
+		else {
+			message(LocalizeString::get("client.commands.trace.saveError.name"), true);
+		}
+		return true;
+	}
+
+	if (args[0] == "replay") {
+		if (args.size() != 2) return false;
+		if (recorder.isRecording()) {
+			message(LocalizeString::get("client.commands.trace.alreadyRecording.name"), true);
+			return true;
+		}
+
+		// A dispatcher of its own, so replayed keys and chat can't eject, run commands or toggle modules. What's
+		// profiled is the module logic in ReplayProbes, running on state of its own against the replayed events.
+		IEventManager harness;
+		ReplayProbes probes{ harness };
+		auto result = recorder.replay(getTracePath(args[1]), harness);
+		if (!result) {
+			message(util::FormatWString(LocalizeString::get("client.commands.trace.notFound.name"), { util::StrToWStr(args[1]) }), true);
+			return true;
+		}
+
+		message(util::FormatWString(LocalizeString::get("client.commands.trace.replayed.name"),
+			{ std::to_wstring(result->replayed), std::to_wstring(result->skipped) }));
+
+		constexpr size_t maxShown = 8;
+		for (size_t i = 0; i < result->listeners.size() && i < maxShown; i++) {
+			auto& st = result->listeners[i];
+			std::string name;
+			if (auto probe = dynamic_cast<ReplayProbe*>(st.listener)) {
+				name = probe->name();
+			}
+			else {
+				std::stringstream ss;
+				ss << "0x" << std::hex << reinterpret_cast<uintptr_t>(st.listener);
+				name = ss.str();
+			}
+
+			std::stringstream ss;
+			ss << std::fixed << std::setprecision(3) << name << " &7(event 0x" << std::hex << st.eventHash << std::dec << ")&r: "
+				<< st.calls << " calls, " << (static_cast<double>(st.totalNanos) / 1'000'000.0) << "ms total, "
+				<< (static_cast<double>(st.maxNanos) / 1'000'000.0) << "ms max";
+			message(ss.str());
+		}
+		return true;
+	}
+	return false;
+}
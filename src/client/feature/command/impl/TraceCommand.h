@@ -0,0 +1,15 @@
+#pragma once
+#include "../Command.h"
+#include "client/misc/EventRecorder.h"
+
+class TraceCommand final : public Command {
+public:
+	TraceCommand();
+	~TraceCommand() = default;
+
+	bool execute(std::string const label, std::vector<std::string> args) override;
+private:
+	static std::filesystem::path getTracePath(std::string const& name);
+
+	EventRecorder recorder;
+};
@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "Module.h"
+#include "ModuleManager.h"
+#include "client/Latite.h"
 
 void Module::loadConfig(SettingGroup& resolvedGroup) {
 	resolvedGroup.forEach([&](std::shared_ptr<Setting> set) {
@@ -44,3 +46,7 @@ std::shared_ptr<Setting> Module::addSliderSetting(std::string const& internalNam
 	settings->addSetting(set);
 	return set;
 }
+
+void Module::onKeybindChanged(Setting&) {
+	Latite::getModuleManager().invalidateKeybinds();
+}
@@ -31,6 +31,8 @@ public:
                                                  LocalizeString::get("client.module.props.key.desc"));
 			set->value = &key;
 			set->defaultValue = KeyValue(keybind);
+			set->allowChords = true;
+			set->callback = &Module::onKeybindChanged;
 
 			settings->addSetting(set);
 		}
@@ -52,4 +54,5 @@ public:
 	std::shared_ptr<Setting> addEnumSetting(std::string const& internalName, std::wstring const& displayName, std::wstring const& desc, EnumData& dat, Setting::Condition condition = Setting::Condition());
 	std::shared_ptr<Setting> addSliderSetting(std::string const& internalName, std::wstring const& displayName, std::wstring const& desc, ValueType& val, ValueType min, ValueType max, ValueType interval, Setting::Condition condition = Setting::Condition());
 protected:
+	static void onKeybindChanged(Setting& set);
 };
\ No newline at end of file
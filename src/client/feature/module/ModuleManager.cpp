@@ -44,6 +44,7 @@
 #include "impl/hud/ReachDisplay.h"
 #include "impl/hud/MovableBossbar.h"
 #include "impl/hud/ItemCounter.h"
+#include "impl/hud/Minimap.h"
 #include "impl/hud/Chat.h"
 #include "impl/hud/ComboCounter.h"
 #include "impl/hud/CustomCoordinates.h"
@@ -88,6 +89,7 @@ ModuleManager::ModuleManager() {
 	this->items.push_back(std::make_shared<EnvironmentChanger>());
 	this->items.push_back(std::make_shared<CommandShortcuts>());
 	this->items.push_back(std::make_shared<ItemCounter>());
+	this->items.push_back(std::make_shared<Minimap>());
 	//this->items.push_back(std::make_shared<Chat>());
 	this->items.push_back(std::make_shared<TextHotkey>());
 	this->items.push_back(std::make_shared<Freelook>());
@@ -100,6 +102,8 @@ ModuleManager::ModuleManager() {
 		mod->onInit();
 	}
 	Eventing::get().listen<KeyUpdateEvent>(this, (EventListenerFunc) & ModuleManager::onKey);
+	// above everything that cancels key events (ClickGUI, the eject key), so a modifier released in a menu isn't stuck
+	Eventing::get().listen<KeyUpdateEvent>(this, (EventListenerFunc) & ModuleManager::onKeyState, 4);
 }
 
 ModuleManager::~ModuleManager() {
@@ -108,23 +112,36 @@ ModuleManager::~ModuleManager() {
 	}
 }
 
+void ModuleManager::rebuildKeybinds() {
+	keybinds.clear();
+	for (auto& mod : items) {
+		keybinds.bind(mod->getKeybind(), mod.get(), mod->shouldHoldToToggle());
+	}
+	keybindsDirty = false;
+}
+
+void ModuleManager::onKeyState(Event& evGeneric) {
+	auto& ev = reinterpret_cast<KeyUpdateEvent&>(evGeneric);
+	keybinds.updateKeyState(ev.getKey(), ev.isDown());
+}
+
 void ModuleManager::onKey(Event& evGeneric) {
 	auto& ev = reinterpret_cast<KeyUpdateEvent&>(evGeneric);
-	for (auto& mod : items) {
-		if (ev.inUI()) return;
-		if (mod->getKeybind() == ev.getKey()) {
-			if (mod->shouldHoldToToggle()) {
-				if (!mod->isEnabled() && ev.isDown()) {
-					mod->setEnabled(true);
-				}
-				else if (mod->isEnabled() && !ev.isDown()) {
-					mod->setEnabled(false);
-				}
-				continue;
-			}
-			else if (ev.isDown()) {
-				mod->setEnabled(!mod->isEnabled());
-			}
+	if (keybindsDirty) rebuildKeybinds();
+
+	if (ev.inUI()) return;
+
+	keybinds.onKey(ev.getKey(), ev.isDown(), [](IModule* mod, KeybindTable<IModule*>::Action action) {
+		switch (action) {
+		case KeybindTable<IModule*>::Action::Enable:
+			if (!mod->isEnabled()) mod->setEnabled(true);
+			break;
+		case KeybindTable<IModule*>::Action::Disable:
+			if (mod->isEnabled()) mod->setEnabled(false);
+			break;
+		case KeybindTable<IModule*>::Action::Toggle:
+			mod->setEnabled(!mod->isEnabled());
+			break;
 		}
-	}
+		});
 }
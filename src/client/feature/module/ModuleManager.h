@@ -4,6 +4,7 @@
 #include "api/eventing/Listenable.h"
 #include "Module.h"
 #include "script/JsModule.h"
+#include "client/input/KeybindTable.h"
 
 class ModuleManager : public Listener, public IModuleManager {
 public:
@@ -20,6 +21,8 @@ public:
 		mod->onInit();
 		this->items.push_back(std::shared_ptr<JsModule>(mod));
 		JS::JsAddRef(mod->object, nullptr);
+		invalidateKeybinds();
+		generation++;
 		return true;
 	}
 
@@ -27,11 +30,25 @@ public:
 		for (auto it = items.begin(); it != items.end(); it++) {
 			if (it->get() == mod) {
 				items.erase(it);
+				invalidateKeybinds();
+				generation++;
 				return true;
 			}
 		}
 		return false;
 	}
 
+	// Marks the keybind table as stale; it gets rebuilt on the next key event.
+	void invalidateKeybinds() { keybindsDirty = true; }
+	// Changes whenever a module is added or removed, so callers can cache the module list
+	[[nodiscard]] uint64_t getGeneration() const { return generation; }
+
 	void onKey(Event& ev);
+	void onKeyState(Event& ev);
+private:
+	void rebuildKeybinds();
+
+	KeybindTable<IModule*> keybinds;
+	bool keybindsDirty = true;
+	uint64_t generation = 1;
 };
\ No newline at end of file
@@ -46,17 +46,19 @@ void TextModule::onInit() {
 
 void TextModule::render(DrawUtil& dc, bool isDefault, bool inEditor) {
 	//dc.setTextShadow(textShadow);
-	int textPadding = std::get<BoolValue>(fillBg) ? static_cast<int>(std::get<FloatValue>(padX)) : 0;
-	int textPaddingY = std::get<BoolValue>(fillBg) ? static_cast<int>(std::get<FloatValue>(padY) * 2.f) : 0;
-
-	float textSize = std::get<FloatValue>(textSizeS);//this->getTextSize();
+	updateLayoutKey(dc, isDefault, inEditor);
 
+	if (!layout.valid || isTextDirty(isDefault, inEditor)) {
+		std::wstring raw = this->text(isDefault, inEditor).str();
+		if (!layout.valid || raw != layout.rawText) {
+			layout.rawText = std::move(raw);
+			layout.valid = false;
+		}
+	}
 
-	std::wstringstream text = this->text(isDefault, inEditor);
-	text = processText(text);
+	if (!layout.valid) relayout(dc);
 
-	std::wstring str = text.str();
-	lastText = str;
+	float textSize = layout.key.textSize;
 
 	auto sCol = std::get<ColorValue>(bgColor).getMainColor();
 	d2d::Color realCol = sCol;
@@ -65,43 +67,20 @@ void TextModule::render(DrawUtil& dc, bool isDefault, bool inEditor) {
 	auto sOCol = std::get<ColorValue>(outlineColor).getMainColor();
 	d2d::Color realOCol = sOCol;
 
-	float rad = 0.f;
-
 	//if (textScaled && customSize) textSize = dc.scaleTextInBounds(str.c_str(), 100.f, rect.getWidth(), 4.f, rect.getHeight());
 
 	DWRITE_TEXT_ALIGNMENT align = alignment.getSelectedKey() == alignment_center ? DWRITE_TEXT_ALIGNMENT_CENTER :
 		alignment.getSelectedKey() == alignment_left ? DWRITE_TEXT_ALIGNMENT_LEADING : DWRITE_TEXT_ALIGNMENT_TRAILING;
-	if (std::get<BoolValue>(customSize)) {
-		d2d::Rect rc = d2d::Rect(0, 0, std::get<FloatValue>(bgX), std::get<FloatValue>(bgY));
-		if (!text.str().empty()) {
-			Vec2 ts = dc.getTextSize(str.c_str(), Renderer::FontSelection::SecondaryLight, textSize, false);
-			Vec2 drawPos = rc.center(ts);
-
-			rad = (std::get<FloatValue>(radius).value / 10.f) * (rc.getHeight() / 2.f);
-
-			if (std::get<BoolValue>(showOutline)) dc.drawRoundedRectangle(rc, realOCol, rad, std::get<FloatValue>(outlineThickness));
-			if (std::get<BoolValue>(fillBg)) dc.fillRoundedRectangle(rc, realCol, rad);
-			dc.drawText(rc, str.c_str(), realTCol, Renderer::FontSelection::SecondaryLight, textSize, align, DWRITE_PARAGRAPH_ALIGNMENT_CENTER, !isDefault && !inEditor && cacheText);
-		}
-		this->rect.right = rect.left + std::get<FloatValue>(bgX);
-		this->rect.bottom = rect.top + std::get<FloatValue>(bgY);
 
+	d2d::Rect rc = layout.bgRect;
+	if (!lastText.empty()) {
+		if (std::get<BoolValue>(showOutline)) dc.drawRoundedRectangle(rc, realOCol, layout.radius, std::get<FloatValue>(outlineThickness));
+		if (layout.key.fillBg) dc.fillRoundedRectangle(rc, realCol, layout.radius);
+		dc.drawText(rc, lastText, realTCol, layout.key.font, textSize, align, DWRITE_PARAGRAPH_ALIGNMENT_CENTER, !isDefault && !inEditor && cacheText);
 	}
-	else {
-		Vec2 drawPos = { static_cast<float>(textPadding), static_cast<float>(textPaddingY) };
-		Vec2 ts = dc.getTextSize(str.c_str(), Renderer::FontSelection::SecondaryLight, textSize, false);
-		d2d::Rect rc = d2d::Rect(0, 0, ts.x + (textPadding * 2), ts.y + (textPaddingY * 2));
-
-		if (!text.str().empty()) {
-			rad = (std::get<FloatValue>(radius).value / 10.f) * (rc.getHeight() / 2.f);
-			if (std::get<BoolValue>(showOutline)) dc.drawRoundedRectangle(rc, realOCol, rad, std::get<FloatValue>(outlineThickness));
-			if (std::get<BoolValue>(fillBg)) dc.fillRoundedRectangle(rc, std::get<ColorValue>(bgColor).getMainColor(), rad);
-			dc.drawText(rc, str.c_str(), realTCol, Renderer::FontSelection::SecondaryLight, textSize, align, DWRITE_PARAGRAPH_ALIGNMENT_CENTER, !isDefault && !inEditor && cacheText);
-		}
 
-		this->rect.right = rect.left + rc.right;
-		this->rect.bottom = rect.top + rc.bottom;
-	}
+	this->rect.right = rect.left + rc.right;
+	this->rect.bottom = rect.top + rc.bottom;
 
 	//d2d::Rect rc = { 0.f, 0.f, rect.getWidth(), rect.getHeight() };
 
@@ -109,10 +88,58 @@ void TextModule::render(DrawUtil& dc, bool isDefault, bool inEditor) {
 	dc.flush();
 }
 
-std::wstringstream TextModule::processText(std::wstringstream& stream) {
-	std::wstringstream str;
-	str << std::get<TextValue>(prefix).str;
-	str << stream.str();
-	str << std::get<TextValue>(suffix).str;
-	return str;
+void TextModule::updateLayoutKey(DrawUtil& dc, bool isDefault, bool inEditor) {
+	LayoutKey key;
+	key.isDefault = isDefault;
+	key.inEditor = inEditor;
+	key.minecraftRenderer = dc.isMinecraft();
+	key.guiScale = SDK::ClientInstance::get()->getGuiData()->guiScaleFrac;
+	key.font = font;
+	key.fontGeneration = Latite::getRenderer().getFontGeneration();
+	key.textSize = std::get<FloatValue>(textSizeS);
+	key.fillBg = std::get<BoolValue>(fillBg);
+	key.customSize = std::get<BoolValue>(customSize);
+	key.bgX = std::get<FloatValue>(bgX);
+	key.bgY = std::get<FloatValue>(bgY);
+	key.padX = std::get<FloatValue>(padX);
+	key.padY = std::get<FloatValue>(padY);
+	key.radius = std::get<FloatValue>(radius);
+
+	if (!(key == layout.key)) {
+		layout.key = key;
+		layout.valid = false;
+	}
+
+	auto& pre = std::get<TextValue>(prefix).str;
+	auto& suf = std::get<TextValue>(suffix).str;
+	if (pre != layout.prefix) {
+		layout.prefix = pre;
+		layout.valid = false;
+	}
+	if (suf != layout.suffix) {
+		layout.suffix = suf;
+		layout.valid = false;
+	}
+}
+
+void TextModule::relayout(DrawUtil& dc) {
+	auto& key = layout.key;
+
+	lastText.clear();
+	lastText.reserve(layout.prefix.size() + layout.rawText.size() + layout.suffix.size());
+	lastText.append(layout.prefix).append(layout.rawText).append(layout.suffix);
+
+	int textPadding = key.fillBg ? static_cast<int>(key.padX) : 0;
+	int textPaddingY = key.fillBg ? static_cast<int>(key.padY * 2.f) : 0;
+
+	layout.textSize = dc.getTextSize(lastText, key.font, key.textSize, false, false);
+
+	if (key.customSize) {
+		layout.bgRect = d2d::Rect(0, 0, key.bgX, key.bgY);
+	}
+	else {
+		layout.bgRect = d2d::Rect(0, 0, layout.textSize.x + (textPadding * 2), layout.textSize.y + (textPaddingY * 2));
+	}
+	layout.radius = (key.radius / 10.f) * (layout.bgRect.getHeight() / 2.f);
+	layout.valid = true;
 }
@@ -48,9 +48,48 @@ public:
 	std::wstring getLastText() { return lastText; }
 protected:
 	virtual std::wstringstream text(bool isDefault, bool inEditor) = 0;
+	// Cheap per-frame check for whether text() needs to be called again.
+	// Modules that know when their text changes should override this; the default rebuilds the text every frame.
+	virtual bool isTextDirty(bool isDefault, bool inEditor) { return true; }
+
 	bool cacheText;
 	std::wstring lastText;
+	// what the text is measured and drawn with
+	Renderer::FontSelection font = Renderer::FontSelection::SecondaryLight;
 	FloatValue maxBGX = 0.f;
 private:
-	std::wstringstream processText(std::wstringstream& stream);
+	// Everything the measured layout depends on, besides the text itself
+	struct LayoutKey {
+		bool isDefault = false;
+		bool inEditor = false;
+		bool minecraftRenderer = false;
+		float guiScale = 0.f;
+		Renderer::FontSelection font = Renderer::FontSelection::SecondaryLight;
+		// the font family (or anything else about the text formats) changed since this was measured
+		uint32_t fontGeneration = 0;
+		float textSize = 0.f;
+		bool fillBg = false;
+		bool customSize = false;
+		float bgX = 0.f;
+		float bgY = 0.f;
+		float padX = 0.f;
+		float padY = 0.f;
+		float radius = 0.f;
+
+		bool operator==(LayoutKey const&) const = default;
+	};
+
+	struct {
+		bool valid = false;
+		LayoutKey key;
+		std::wstring prefix;
+		std::wstring suffix;
+		std::wstring rawText;
+		Vec2 textSize = {};
+		d2d::Rect bgRect = {};
+		float radius = 0.f;
+	} layout;
+
+	void updateLayoutKey(DrawUtil& dc, bool isDefault, bool inEditor);
+	void relayout(DrawUtil& dc);
 };
\ No newline at end of file
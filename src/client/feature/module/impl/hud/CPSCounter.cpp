@@ -17,7 +17,16 @@ CPSCounter::CPSCounter() : TextModule("CPS", LocalizeString::get("client.textmod
     std::get<TextValue>(this->prefix).str = L"CPS: ";
 }
 
+bool CPSCounter::isTextDirty(bool isDefault, bool inEditor) {
+	auto& timings = Latite::get().getTimings();
+	return mode.getSelectedKey() != lastMode || timings.getCPSL() != lastCPSL || timings.getCPSR() != lastCPSR;
+}
+
 std::wstringstream CPSCounter::text(bool isDefault, bool inEditor) {
+	lastMode = mode.getSelectedKey();
+	lastCPSL = Latite::get().getTimings().getCPSL();
+	lastCPSR = Latite::get().getTimings().getCPSR();
+
 	std::wstringstream wss;
 	switch (mode.getSelectedKey()) {
 	case 0:
@@ -7,6 +7,11 @@ public:
 	CPSCounter();
 
 	std::wstringstream text(bool isDefault, bool inEditor) override;
+	bool isTextDirty(bool isDefault, bool inEditor) override;
 
 	EnumData mode;
+private:
+	int lastMode = -1;
+	int lastCPSL = -1;
+	int lastCPSR = -1;
 };
\ No newline at end of file
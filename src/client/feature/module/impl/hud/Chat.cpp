@@ -53,28 +53,24 @@ void Chat::render(DrawUtil& ctx, bool isDefault, bool inEditor) {
 		}
 	}
 
+	float guiScale = ctx.isMinecraft() ? static_cast<MCDrawUtil&>(ctx).guiScale : 1.f;
+	uint32_t fontGeneration = Latite::getRenderer().getFontGeneration();
+	if (guiScale != glyphGuiScale || ctx.isMinecraft() != glyphMinecraft || textSize != glyphTextSize
+		|| fontGeneration != glyphFontGeneration) {
+		glyphGuiScale = guiScale;
+		glyphMinecraft = ctx.isMinecraft();
+		glyphTextSize = textSize;
+		glyphFontGeneration = fontGeneration;
+		lineBreaker.clear();
+		for (auto& msg : messages) {
+			msg.wrapWidth = -1.f;
+		}
+	}
+
 	float y = windowHeight;
 	for (size_t i = 0; i < std::min(messages.size(), static_cast<size_t>(maxMessages)); i++) {
 		auto& msg = messages[i];
 
-		auto textWrap = [](DrawUtil& util, std::wstring txt, float tSize, float width) -> std::wstring {
-			std::wstring ret = txt;
-			std::wstring work = ret;
-
-			size_t retIndex = 1;
-			for (size_t i = retIndex; i < work.size(); i++) {
-				float size = util.getTextSize(work.substr(0, i), Renderer::FontSelection::PrimaryRegular, tSize).x;
-				if (size > width) {
-					ret.insert(ret.begin() + (retIndex - 1), L'\n');
-					i = 1;
-					work = ret.substr(retIndex);
-				}
-				retIndex++;
-			}
-
-			return ret;
-			};
-
 		auto sineCurve = [](float x) {
 			return sin(x * 0.5f * pi_f);
 		};
@@ -89,13 +85,9 @@ void Chat::render(DrawUtil& ctx, bool isDefault, bool inEditor) {
 			msg.animation = 1.f;
 		}
 
-		std::string content = msg.content;
-		if (msg.duplicate > 1) {
-			content += " \xC2\xA7\x37[" + std::to_string(msg.duplicate) + "]";
-		}
-
-		std::wstring text = textWrap(ctx, util::StrToWStr(content), textSize, windowWidth);
-		auto tSize = ctx.getTextSize(text, Renderer::FontSelection::PrimaryRegular, textSize);
+		wrapMessage(ctx, msg, windowWidth);
+		auto& text = msg.wrapped;
+		auto tSize = msg.wrappedSize;
 
 		d2d::Rect tRect = { 0, y - tSize.y,
 			windowWidth, y};
@@ -116,6 +108,22 @@ void Chat::render(DrawUtil& ctx, bool isDefault, bool inEditor) {
 	rect.bottom = rect.top + windowHeight;
 }
 
+void Chat::wrapMessage(DrawUtil& ctx, ChatMessage& msg, float width) {
+	if (msg.wrapWidth == width && msg.wrapDuplicate == msg.duplicate) return;
+
+	std::string content = msg.content;
+	if (msg.duplicate > 1) {
+		content += " \xC2\xA7\x37[" + std::to_string(msg.duplicate) + "]";
+	}
+
+	msg.wrapped = lineBreaker.wrapToString(util::StrToWStr(content), width, [&](wchar_t ch) {
+		return ctx.getTextSize(std::wstring(1, ch), Renderer::FontSelection::PrimaryRegular, textSize).x;
+		});
+	msg.wrappedSize = ctx.getTextSize(msg.wrapped, Renderer::FontSelection::PrimaryRegular, textSize);
+	msg.wrapWidth = width;
+	msg.wrapDuplicate = msg.duplicate;
+}
+
 void Chat::onText(Event& evG) {
 	auto& ev = reinterpret_cast<ChatMessageEvent&>(evG);
 	//auto pkt = ev.getTextPacket();
@@ -1,6 +1,7 @@
 #pragma once
 #include <client/feature/module/HUDModule.h>
 #include <sdk/common/client/gui/controls/UIControl.h>
+#include "util/LineBreaker.h"
 
 class Chat : public HUDModule {
 public:
@@ -15,6 +16,7 @@ private:
 	void onRenderLayer(Event&);
 
 	void addMessage(std::string const& message);
+	void wrapMessage(DrawUtil& ctx, ChatMessage& msg, float width);
 
 	struct ChatMessage {
 		std::chrono::system_clock::time_point timeCreated;
@@ -22,6 +24,12 @@ private:
 		int duplicate = 1;
 		float animation = 0.f;
 
+		// wrapped text, only redone when the width or duplicate count change, or the glyph cache is reset
+		std::wstring wrapped;
+		Vec2 wrappedSize = {};
+		float wrapWidth = -1.f;
+		int wrapDuplicate = 0;
+
 		ChatMessage(std::string content) : content(std::move(content)) {
 			timeCreated = std::chrono::system_clock::now();
 		}
@@ -47,4 +55,12 @@ private:
 
 	float textSize = 30.f;
 	float messageHeight = textSize;
+
+	LineBreaker lineBreaker;
+	// what the cached glyph advances were measured with
+	float glyphGuiScale = 0.f;
+	bool glyphMinecraft = false;
+	float glyphTextSize = 0.f;
+	// Renderer::getFontGeneration(), which changes with the font family
+	uint32_t glyphFontGeneration = 0;
 };
\ No newline at end of file
@@ -12,46 +12,28 @@ ComboCounter::ComboCounter() : TextModule("ComboCounter", LocalizeString::get("c
 }
 
 std::wstringstream ComboCounter::text(bool isDefault, bool inEditor) {
-    return std::wstringstream() << combo;
+    return std::wstringstream() << tracker.get();
 }
 
 void ComboCounter::onAttack(Event& evG) {
     auto& ev = reinterpret_cast<AttackEvent&>(evG);
     
-    auto ent = ev.getActor();
-
-    if (ent->getRuntimeID() != lastRuntimeId) {
-        combo = 0;
-    }
-
-    lastRuntimeId = ent->getRuntimeID();
-    lastHurt = std::chrono::system_clock::now();
-    hasHit = true;
+    tracker.attack(ev.getActor()->getRuntimeID(), std::chrono::system_clock::now());
 }
 
 void ComboCounter::onPacketReceive(Event& evG) {
     auto& ev = reinterpret_cast<PacketReceiveEvent&>(evG);
     auto pkt = ev.getPacket();
 
-    if (pkt->getID() == SDK::PacketID::ACTOR_EVENT && hasHit) {
+    if (pkt->getID() == SDK::PacketID::ACTOR_EVENT) {
         auto actorEvent = static_cast<SDK::ActorEventPacket*>(pkt);
 
-        if (actorEvent->eventID == SDK::ActorEventID::HURT_ANIMATION && actorEvent->runtimeID == lastRuntimeId) {
-            combo++;
-            hasHit = false;
+        if (actorEvent->eventID == SDK::ActorEventID::HURT_ANIMATION) {
+            tracker.hurt(actorEvent->runtimeID);
         }
     }
 }
 
 void ComboCounter::onTick(Event&) {
-    auto now = std::chrono::system_clock::now();
-
-    if (now - lastHurt > 3s) {
-        lastRuntimeId = 0;
-        combo = 0;
-    }
-
-    if (SDK::ClientInstance::get()->getLocalPlayer()->invulnerableTime > 8) {
-        combo = 0;
-    }
+    tracker.tick(std::chrono::system_clock::now(), SDK::ClientInstance::get()->getLocalPlayer()->invulnerableTime > 8);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <client/feature/module/TextModule.h>
+#include "ComboTracker.h"
 
 class ComboCounter : public TextModule {
 public:
@@ -12,8 +13,5 @@ public:
 	void onPacketReceive(Event& ev);
 	void onTick(Event& ev);
 private:
-	int combo = 0;
-	std::chrono::system_clock::time_point lastHurt{};
-	uint64_t lastRuntimeId = 0;
-	bool hasHit = false;
+	ComboTracker tracker;
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// The combo counting behind ComboCounter, without the game: a hit on the entity that was attacked last adds to the
+// combo once the server confirms it with a hurt animation, and it resets after three seconds without one, when
+// attacking something else, or while the local player is invulnerable. Time is passed in so traces can replay it.
+class ComboTracker {
+public:
+	using Clock = std::chrono::system_clock;
+
+	static constexpr std::chrono::seconds timeout{ 3 };
+
+	void attack(uint64_t runtimeId, Clock::time_point now) {
+		if (runtimeId != lastRuntimeId) {
+			combo = 0;
+		}
+
+		lastRuntimeId = runtimeId;
+		lastHurt = now;
+		hasHit = true;
+	}
+
+	// A hurt animation for `runtimeId`
+	void hurt(uint64_t runtimeId) {
+		if (hasHit && runtimeId == lastRuntimeId) {
+			combo++;
+			hasHit = false;
+		}
+	}
+
+	void tick(Clock::time_point now, bool invulnerable) {
+		if (now - lastHurt > timeout) {
+			lastRuntimeId = 0;
+			combo = 0;
+		}
+
+		if (invulnerable) {
+			combo = 0;
+		}
+	}
+
+	[[nodiscard]] int get() const { return combo; }
+private:
+	int combo = 0;
+	Clock::time_point lastHurt{};
+	uint64_t lastRuntimeId = 0;
+	bool hasHit = false;
+};
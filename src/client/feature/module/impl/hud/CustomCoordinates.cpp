@@ -10,25 +10,37 @@ CustomCoordinates::CustomCoordinates() : TextModule("CustomCoordinates",
                LocalizeString::get("client.textmodule.customCoordinates.showDimension.desc"), this->showDimension);
 }
 
-std::wstringstream CustomCoordinates::text(bool isDefault, bool inEditor) {
-    if (!SDK::ClientInstance::get()->getLocalPlayer()) return std::wstringstream(L"");
+std::array<int, 3> CustomCoordinates::getBlockPos(SDK::LocalPlayer* localPlayer) {
+    return { static_cast<int>(localPlayer->getPos().x),
+        static_cast<int>(lroundf(localPlayer->getPos().y - 1.62f)), // very hacky fix to get vanilla y coordinate (probably not 100% accurate)
+        static_cast<int>(localPlayer->getPos().z) };
+}
+
+bool CustomCoordinates::isTextDirty(bool isDefault, bool inEditor) {
+    SDK::LocalPlayer* localPlayer = SDK::ClientInstance::get()->getLocalPlayer();
+    if (!localPlayer || !lastShown) return localPlayer || lastShown;
+
+    bool dimension = std::get<BoolValue>(showDimension);
+    return dimension != lastShown->showDimension || getBlockPos(localPlayer) != lastShown->pos
+        || (dimension && localPlayer->dimension->dimensionName != lastShown->dimension);
+}
 
+std::wstringstream CustomCoordinates::text(bool isDefault, bool inEditor) {
+    // TextModule keeps the last text and layout, so this only runs when the position, dimension or setting changes
     SDK::LocalPlayer* localPlayer = SDK::ClientInstance::get()->getLocalPlayer();
+    if (!localPlayer) {
+        lastShown = std::nullopt;
+        return std::wstringstream(L"");
+    }
 
-    int playerPosX = static_cast<int>(localPlayer->getPos().x);
-    int playerPosY = lroundf(localPlayer->getPos().y - 1.62f); // very hacky fix to get vanilla y coordinate (probably not 100% accurate)
-    int playerPosZ = static_cast<int>(localPlayer->getPos().z);
-    std::wstring dimensionName = util::StrToWStr(localPlayer->dimension->dimensionName);
+    lastShown = Shown{ getBlockPos(localPlayer), std::get<BoolValue>(showDimension) };
+    if (lastShown->showDimension) lastShown->dimension = localPlayer->dimension->dimensionName;
 
-    std::wstring moduleText = util::StrToWStr(
-        std::format(
-            "X: {}\nY: {}\nZ: {}",
-            playerPosX,
-            playerPosY,
-            playerPosZ
-        ));
+    auto [playerPosX, playerPosY, playerPosZ] = lastShown->pos;
+    moduleText.clear();
 
-    if (std::get<BoolValue>(showDimension)) {
+    if (lastShown->showDimension) {
+        std::wstring dimensionName = util::StrToWStr(lastShown->dimension);
         if (dimensionName == L"Overworld")
             dimensionName = LocalizeString::get("client.textmodule.customCoordinates.dimensionDisplay.overworld.name");
         else if (dimensionName == L"Nether")
@@ -36,14 +48,12 @@ std::wstringstream CustomCoordinates::text(bool isDefault, bool inEditor) {
         else if (dimensionName == L"TheEnd")
             dimensionName = LocalizeString::get("client.textmodule.customCoordinates.dimensionDisplay.theEnd.name");
 
-        moduleText = util::FormatWString(L"X: {}\nY: {}\nZ: {}\n{}: {}", {
-            std::to_wstring(playerPosX),
-            std::to_wstring(playerPosY),
-            std::to_wstring(playerPosZ),
-            LocalizeString::get("client.textmodule.customCoordinates.dimension.name"),
-            dimensionName
-        });
+        dimensionFormat.format(moduleText, playerPosX, playerPosY, playerPosZ,
+            LocalizeString::get("client.textmodule.customCoordinates.dimension.name"), dimensionName);
+    }
+    else {
+        coordsFormat.format(moduleText, playerPosX, playerPosY, playerPosZ);
     }
 
     return std::wstringstream(moduleText);
-}
\ No newline at end of file
+}
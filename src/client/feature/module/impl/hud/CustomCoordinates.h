@@ -1,11 +1,27 @@
 #pragma once
 #include "../../TextModule.h"
+#include "util/FormatTemplate.h"
 
 class CustomCoordinates : public TextModule {
 public:
 	CustomCoordinates();
 
 	std::wstringstream text(bool isDefault, bool inEditor) override;
+	bool isTextDirty(bool isDefault, bool inEditor) override;
 private:
+	// what the text was last built from
+	struct Shown {
+		std::array<int, 3> pos{};
+		bool showDimension = false;
+		std::string dimension;
+	};
+
+	static std::array<int, 3> getBlockPos(SDK::LocalPlayer* localPlayer);
+
 	ValueType showDimension = BoolValue(false);
+
+	FormatTemplate coordsFormat{ L"X: {}\nY: {}\nZ: {}" };
+	FormatTemplate dimensionFormat{ L"X: {}\nY: {}\nZ: {}\n{}: {}" };
+	std::wstring moduleText;
+	std::optional<Shown> lastShown;
 };
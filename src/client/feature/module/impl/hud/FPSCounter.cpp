@@ -9,6 +9,11 @@ FPSCounter::FPSCounter() : TextModule("FPS", LocalizeString::get("client.textmod
 
 std::wstringstream FPSCounter::text(bool isDefault, bool inEditor) {
 	std::wstringstream wss;
-	wss << Latite::get().getTimings().getFPS();
+	lastFPS = Latite::get().getTimings().getFPS();
+	wss << lastFPS;
 	return wss;
 }
+
+bool FPSCounter::isTextDirty(bool isDefault, bool inEditor) {
+	return Latite::get().getTimings().getFPS() != lastFPS;
+}
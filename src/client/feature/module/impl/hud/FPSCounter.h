@@ -6,4 +6,7 @@ public:
 	FPSCounter();
 
 	std::wstringstream text(bool isDefault, bool inEditor) override;
+	bool isTextDirty(bool isDefault, bool inEditor) override;
+private:
+	int lastFPS = -1;
 };
\ No newline at end of file
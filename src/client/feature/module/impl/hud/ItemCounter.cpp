@@ -1,44 +1,21 @@
 #include "pch.h"
 #include "ItemCounter.h"
+#include "client/misc/InventoryTracker.h"
 
 
 namespace {
 	class ItemCount {
 	public:
 		std::string texture;
-		bool isHash = false;
 		ValueType& setting;
-		int64_t hash = 0;
-		std::string inString = "";
+		// in InventoryTracker
+		size_t group;
 
-		ItemCount(std::string texture, ValueType& setting, bool hashed, int64_t hash = 0, std::string include = "") : texture(texture), isHash(hashed), inString(include), setting(setting), hash(hash) {
+		ItemCount(std::string texture, ValueType& setting, InventoryTotals::Predicate predicate) : texture(texture), setting(setting), group(InventoryTracker::get().addGroup(std::move(predicate))) {
 		}
 	};
 
 	std::vector<ItemCount> counterList;
-
-	int getCountStr(SDK::Inventory* inv, std::string incl) {
-		int count = 0;
-		for (int i = 0; i < 36; i++) {
-			auto stack = inv->getItem(i);
-			if (auto it = stack->item) {
-				auto tName = (*it)->id.getString();
-				if (tName.find(incl) != std::string::npos) count += stack->itemCount;
-			}
-		}
-		return count;
-	}
-
-	int getCountHashed(SDK::Inventory* inv, int64_t hash) {
-		int count = 0;
-		for (int i = 0; i < 36; i++) {
-			auto stack = inv->getItem(i);
-			if (auto it = stack->item) {
-				if ((*it)->id.hash == hash)  count += stack->itemCount;
-			}
-		}
-		return count;
-	}
 }
 
 
@@ -57,11 +34,11 @@ ItemCounter::ItemCounter() : HUDModule("ItemCounter", LocalizeString::get("clien
 	addSetting("totems", LocalizeString::get("client.hudmodule.itemCounter.totems.name"), L"", totems);
 	addSetting("bottles", LocalizeString::get("client.hudmodule.itemCounter.xpBottles.name"), L"", xpBottles);
 
-	counterList.emplace_back(potionT, potions, false, 0, "potion");
-	counterList.emplace_back(arrowT, arrow, false, 0, "arrow");
-	counterList.emplace_back(totemT, totems, false, 0, "totem");
-	counterList.emplace_back(xpT, xpBottles, false, 0, "experience_bottle");
-	counterList.emplace_back(crystalT, crystals, false, 0, "end_crystal");
+	counterList.emplace_back(potionT, potions, InventoryTotals::contains("potion"));
+	counterList.emplace_back(arrowT, arrow, InventoryTotals::contains("arrow"));
+	counterList.emplace_back(totemT, totems, InventoryTotals::contains("totem"));
+	counterList.emplace_back(xpT, xpBottles, InventoryTotals::contains("experience_bottle"));
+	counterList.emplace_back(crystalT, crystals, InventoryTotals::contains("end_crystal"));
 }
 
 void ItemCounter::render(DrawUtil& ct, bool isDefault, bool inEditor) {
@@ -74,9 +51,7 @@ void ItemCounter::render(DrawUtil& ct, bool isDefault, bool inEditor) {
 	this->rect.bottom = rect.top + 16.f;
 
 
-	auto lp = SDK::ClientInstance::get()->getLocalPlayer();
-	auto supplies = lp->supplies;
-	auto inv = supplies->inventory;
+	auto& totals = InventoryTracker::get().refresh();
 
 	Vec2 pos;
 
@@ -84,7 +59,7 @@ void ItemCounter::render(DrawUtil& ct, bool isDefault, bool inEditor) {
 
 	for (auto& counters : counterList) {
 		if (std::get<BoolValue>(counters.setting) == false) continue;
-		int count = counters.isHash ? getCountHashed(inv, counters.hash) : getCountStr(inv, counters.inString);
+		int count = totals.getGroupCount(counters.group);
 
 		if (count || std::get<BoolValue>(alwaysShow)) {
 			SDK::TexturePtr text{};
@@ -68,13 +68,7 @@ Vec2 Keystrokes::drawKeystroke(DrawUtil& ctx, Vec2 const& pos, Keystroke& stroke
 
 void Keystrokes::onClick(Event& evG) {
 	auto& ev = reinterpret_cast<ClickEvent&>(evG);
-
-	if (ev.getMouseButton() == 1) {
-		primaryClickState = ev.isDown();
-	}
-	else if (ev.getMouseButton() == 2) {
-		secondaryClickState = ev.isDown();
-	}
+	mouse.onClick(ev.getMouseButton(), ev.isDown());
 }
 
 void Keystrokes::render(DrawUtil& dc, bool, bool inEditor) {
@@ -88,7 +82,7 @@ void Keystrokes::render(DrawUtil& dc, bool, bool inEditor) {
 	// W, S, A, D keys
 	// + sneak, space, LMB, RMB
 
-	static std::array<Stroke, 2> mouseButtons = { Stroke(primaryClickState), Stroke(secondaryClickState) };
+	static std::array<Stroke, 2> mouseButtons = { Stroke(mouse.primary), Stroke(mouse.secondary) };
 
 	static std::array<Keystroke, 6> keystrokes = { Keystroke("forward", input->front), Keystroke("left", input->left),
 		Keystroke("back", input->back), Keystroke("right", input->right), Keystroke("sneak", input->sneak), Keystroke("jump", input->jump)};
@@ -6,6 +6,21 @@ public:
 	Keystrokes();
 
 	void render(DrawUtil& dc, bool, bool) override;
+
+	// Which mouse buttons are held, from click events
+	struct MouseState {
+		bool primary = false;
+		bool secondary = false;
+
+		void onClick(int button, bool down) {
+			if (button == 1) {
+				primary = down;
+			}
+			else if (button == 2) {
+				secondary = down;
+			}
+		}
+	};
 private:
 	ValueType mouseButtons = BoolValue(true);
 	ValueType cps = BoolValue(false);
@@ -51,6 +66,5 @@ private:
 
 	void onClick(Event& evG);
 
-	bool primaryClickState = false;
-	bool secondaryClickState = false;
+	MouseState mouse;
 };
\ No newline at end of file
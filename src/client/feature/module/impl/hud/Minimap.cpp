@@ -0,0 +1,176 @@
+#include "pch.h"
+#include "Minimap.h"
+#include "client/event/impl/TickEvent.h"
+#include "client/event/impl/RendererCleanupEvent.h"
+#include "sdk/common/world/level/BlockSource.h"
+#include "sdk/common/world/level/block/Block.h"
+
+namespace {
+	class RegionBlocks : public MinimapTiles::BlockSource {
+	public:
+		explicit RegionBlocks(SDK::BlockSource* region) : region(region) {}
+
+		uintptr_t getBlock(int x, int y, int z) const override {
+			auto block = region->getBlock(x, y, z);
+			return block ? reinterpret_cast<uintptr_t>(block->legacyBlock) : 0;
+		}
+
+		std::string getName(uintptr_t block) const override {
+			return reinterpret_cast<SDK::BlockLegacy*>(block)->name;
+		}
+	private:
+		SDK::BlockSource* region;
+	};
+
+	int floorDiv(int value, int by) {
+		return (value >= 0 ? value : value - (by - 1)) / by;
+	}
+
+	int wrap(int value, int by) {
+		return ((value % by) + by) % by;
+	}
+}
+
+Minimap::Minimap() : HUDModule("Minimap", LocalizeString::get("client.hudmodule.minimap.name"),
+                               LocalizeString::get("client.hudmodule.minimap.desc"), HUD) {
+	addSliderSetting("range", LocalizeString::get("client.hudmodule.minimap.range.name"),
+	                 LocalizeString::get("client.hudmodule.minimap.range.desc"), range, FloatValue(32.f), FloatValue(160.f), FloatValue(16.f));
+
+	listen<TickEvent>(static_cast<EventListenerFunc>(&Minimap::onTick));
+	listen<RendererCleanupEvent>(static_cast<EventListenerFunc>(&Minimap::onCleanup), true);
+}
+
+void Minimap::onTick(Event&) {
+	auto lp = SDK::ClientInstance::get()->getLocalPlayer();
+	auto region = SDK::ClientInstance::get()->getRegion();
+	if (!lp || !region) return;
+
+	if (region != lastRegion) {
+		// another world or dimension
+		tiles.clear();
+		lastRegion = region;
+
+		std::lock_guard lock{ shownMutex };
+		shown.clear();
+		slotChunks.assign(slotChunks.size(), std::nullopt);
+	}
+
+	auto& pos = lp->getPos();
+	int x = static_cast<int>(std::floor(pos.x)), y = static_cast<int>(std::floor(pos.y)), z = static_cast<int>(std::floor(pos.z));
+	int radius = getRadius();
+	tiles.update(RegionBlocks(region), x, z, radius, std::min(y + scan_above, 319), std::max(y - scan_below, -64), scan_budget);
+
+	// copied out before locking, so render only waits for the map to be updated
+	std::vector<std::pair<std::pair<int, int>, ShownTile>> changed;
+	tiles.takeChanged(x, z, [&](int chunkX, int chunkZ, MinimapTiles::Tile const& tile) {
+		changed.push_back({ { chunkX, chunkZ }, ShownTile{ tile.pixels } });
+		});
+
+	int centerX = floorDiv(x, MinimapTiles::tile_size), centerZ = floorDiv(z, MinimapTiles::tile_size);
+	std::vector<std::pair<int, int>> dropped;
+	{
+		std::lock_guard lock{ shownMutex };
+		for (auto& [chunk, tile] : changed) {
+			shown[chunk] = tile;
+		}
+		std::erase_if(shown, [&](auto const& entry) {
+			auto [chunkX, chunkZ] = entry.first;
+			if (std::abs(chunkX - centerX) <= radius && std::abs(chunkZ - centerZ) <= radius) return false;
+			dropped.push_back(entry.first);
+			return true;
+			});
+	}
+
+	// so they're published again if they come back into range
+	for (auto [chunkX, chunkZ] : dropped) {
+		if (auto tile = tiles.find(chunkX, chunkZ)) tile->changed = true;
+	}
+}
+
+void Minimap::onCleanup(Event&) {
+	std::lock_guard lock{ shownMutex };
+	atlas = nullptr;
+	slotChunks.clear();
+	atlasSlots = 0;
+}
+
+bool Minimap::updateAtlas(D2DUtil& dc, int minX, int minZ, int maxX, int maxZ) {
+	int slots = 2 * getRadius() + 1;
+	if (!atlas || slots != atlasSlots) {
+		atlas = nullptr;
+		auto side = static_cast<UINT32>(slots * MinimapTiles::tile_size);
+		auto props = D2D1::BitmapProperties1(D2D1_BITMAP_OPTIONS_NONE, D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+		if (FAILED(dc.ctx->CreateBitmap(D2D1::SizeU(side, side), nullptr, 0, props, atlas.GetAddressOf()))) return false;
+		atlasSlots = slots;
+		slotChunks.assign(static_cast<size_t>(slots * slots), std::nullopt);
+	}
+
+	for (int cz = minZ; cz <= maxZ; cz++) {
+		for (int cx = minX; cx <= maxX; cx++) {
+			auto it = shown.find({ cx, cz });
+			if (it == shown.end()) continue;
+			auto& tile = it->second;
+
+			int sx = wrap(cx, atlasSlots), sz = wrap(cz, atlasSlots);
+			auto& slot = slotChunks[static_cast<size_t>(sz * atlasSlots + sx)];
+			if (!tile.changed && slot == std::pair(cx, cz)) continue;
+
+			auto dest = D2D1::RectU(sx * MinimapTiles::tile_size, sz * MinimapTiles::tile_size,
+				(sx + 1) * MinimapTiles::tile_size, (sz + 1) * MinimapTiles::tile_size);
+			// opaque or fully transparent, so these are already premultiplied
+			atlas->CopyFromMemory(&dest, tile.pixels.data(), MinimapTiles::tile_size * sizeof(uint32_t));
+			tile.changed = false;
+			slot = { cx, cz };
+		}
+	}
+	return true;
+}
+
+void Minimap::render(DrawUtil& ctx, bool isDefault, bool inEditor) {
+	rect.right = rect.left + map_size;
+	rect.bottom = rect.top + map_size;
+	if (ctx.isMinecraft()) return;
+
+	auto& dc = static_cast<D2DUtil&>(ctx);
+	d2d::Rect bounds = { 0.f, 0.f, map_size, map_size };
+	dc.fillRectangle(bounds, d2d::Color(0.f, 0.f, 0.f, 0.5f));
+
+	auto lp = SDK::ClientInstance::get()->getLocalPlayer();
+	if (lp && !isDefault) {
+		auto& pos = lp->getPos();
+		float blockRange = std::get<FloatValue>(range);
+		float scale = map_size / (blockRange * 2.f);
+		int minX = floorDiv(static_cast<int>(std::floor(pos.x - blockRange)), MinimapTiles::tile_size);
+		int minZ = floorDiv(static_cast<int>(std::floor(pos.z - blockRange)), MinimapTiles::tile_size);
+		int maxX = floorDiv(static_cast<int>(std::floor(pos.x + blockRange)), MinimapTiles::tile_size);
+		int maxZ = floorDiv(static_cast<int>(std::floor(pos.z + blockRange)), MinimapTiles::tile_size);
+
+		std::lock_guard lock{ shownMutex };
+		if (updateAtlas(dc, minX, minZ, maxX, maxZ)) {
+			dc.ctx->PushAxisAlignedClip(dc.getRect(bounds), D2D1_ANTIALIAS_MODE_ALIASED);
+			for (int cz = minZ; cz <= maxZ; cz++) {
+				for (int cx = minX; cx <= maxX; cx++) {
+					int sx = wrap(cx, atlasSlots), sz = wrap(cz, atlasSlots);
+					if (slotChunks[static_cast<size_t>(sz * atlasSlots + sx)] != std::pair(cx, cz)) continue;
+
+					float left = (static_cast<float>(cx * MinimapTiles::tile_size) - pos.x) * scale + map_size / 2.f;
+					float top = (static_cast<float>(cz * MinimapTiles::tile_size) - pos.z) * scale + map_size / 2.f;
+					float size = MinimapTiles::tile_size * scale;
+					auto dest = D2D1::RectF(left, top, left + size, top + size);
+					auto src = D2D1::RectF(static_cast<float>(sx * MinimapTiles::tile_size), static_cast<float>(sz * MinimapTiles::tile_size),
+						static_cast<float>((sx + 1) * MinimapTiles::tile_size), static_cast<float>((sz + 1) * MinimapTiles::tile_size));
+					dc.ctx->DrawBitmap(atlas.Get(), &dest, 1.f, D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, &src);
+				}
+			}
+			dc.ctx->PopAxisAlignedClip();
+		}
+	}
+
+	// the player, and where they're facing (yaw 0 is south, which is down)
+	Vec2 center = { map_size / 2.f, map_size / 2.f };
+	float yaw = lp ? lp->getRot().y * (pi_f / 180.f) : 0.f;
+	dc.brush->SetColor(d2d::Colors::WHITE.get());
+	dc.ctx->DrawLine({ center.x, center.y }, { center.x - std::sin(yaw) * 8.f, center.y + std::cos(yaw) * 8.f }, dc.brush, 2.f);
+	dc.ctx->FillEllipse(D2D1::Ellipse({ center.x, center.y }, 3.f, 3.f), dc.brush);
+	dc.drawRectangle(bounds, d2d::Colors::BLACK, 1.f);
+}
@@ -1,19 +1,48 @@
 #pragma once
 #include "../../HUDModule.h"
-#include "util/Math.h"
-#include <unordered_map>
+#include "MinimapTiles.h"
+#include <map>
+#include <mutex>
+#include <optional>
 
 class Minimap : public HUDModule {
 public:
 	Minimap();
 
+	void render(DrawUtil& ctx, bool isDefault, bool inEditor) override;
 private:
-	struct IBlock {
+	static constexpr float map_size = 160.f;
+	// block lookups per tick
+	static constexpr size_t scan_budget = 16384;
+	// how far above and below the player to look for the top block
+	static constexpr int scan_above = 48;
+	static constexpr int scan_below = 80;
 
+	ValueType range = FloatValue(64.f);
+
+	// Only used on the tick thread. A scan can make thousands of block lookups, so it isn't done under the lock render takes.
+	MinimapTiles tiles{ 256 };
+	SDK::BlockSource* lastRegion = nullptr;
+
+	// What render draws from: copies of the tiles in range, with the ones that changed published after every scan
+	struct ShownTile {
+		std::array<uint32_t, MinimapTiles::tile_area> pixels;
+		// not copied into the atlas yet
+		bool changed = true;
 	};
+	std::mutex shownMutex;
+	std::map<std::pair<int, int>, ShownTile> shown;
+
+	// Tiles are copied into slots of one bitmap, wrapping around as the player moves, and drawn from there.
+	// A slot is only copied into again when its tile changed or it's holding a different chunk.
+	ComPtr<ID2D1Bitmap1> atlas;
+	int atlasSlots = 0;
+	std::vector<std::optional<std::pair<int, int>>> slotChunks;
 
-	std::unordered_map<BlockPos, 
+	// chunks around the player to keep scanned, enough to cover the range wherever the player is in their chunk
+	[[nodiscard]] int getRadius() { return static_cast<int>(std::get<FloatValue>(range)) / MinimapTiles::tile_size + 1; }
 
-	void scanChunks();
-	void onUpdate(Event& ev);
-};
\ No newline at end of file
+	void onTick(Event& ev);
+	void onCleanup(Event& ev);
+	bool updateAtlas(D2DUtil& dc, int minX, int minZ, int maxX, int maxZ);
+};
@@ -0,0 +1,293 @@
+#pragma once
+#include "util/LRUCache.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The world side of the minimap, kept apart from the game so it can run against any block source.
+//
+// A tile is one chunk's 16x16 columns of top-block colours, cached by chunk coordinate and evicted least recently used.
+// Every tick, update() samples columns around the player until it has spent a budget of block lookups, nearest tiles
+// first: new tiles and columns marked dirty, then re-checking the tile that was scanned longest ago.
+// A tile keeps showing its old colours while it's rescanned, and is flagged as changed when any of them do,
+// so the display only has to redraw those tiles.
+class MinimapTiles {
+public:
+	// Stands in for the world. A block is any non-zero id for its type (like a pointer); 0 is air.
+	class BlockSource {
+	public:
+		virtual ~BlockSource() = default;
+		[[nodiscard]] virtual uintptr_t getBlock(int x, int y, int z) const = 0;
+		// Only asked for the first time a block type is seen
+		[[nodiscard]] virtual std::string getName(uintptr_t block) const = 0;
+	};
+
+	static constexpr int tile_size = 16;
+	static constexpr int tile_area = tile_size * tile_size;
+
+	struct Tile {
+		// 0xAARRGGBB by row (z) then column (x); fully transparent where nothing was found
+		std::array<uint32_t, tile_area> pixels = {};
+		std::array<int16_t, tile_area> heights = {};
+		// columns that still have to be sampled
+		std::bitset<tile_area> dirty;
+		// the tick the last full scan finished on
+		uint64_t scannedAt = 0;
+		// whether any pixel changed since the display last took it; new tiles start out changed, so whatever the
+		// display was showing for that chunk (from another dimension, or before it was evicted) is replaced
+		bool changed = true;
+	};
+
+	struct Stats {
+		uint64_t lookups = 0;
+		uint64_t columns = 0;
+		uint64_t tilesCreated = 0;
+		uint64_t evictions = 0;
+		size_t tiles = 0;
+		size_t capacity = 0;
+	};
+
+	// The cache grows past `capacity` if that's needed to hold every tile in the radius
+	explicit MinimapTiles(size_t capacity, uint64_t refreshTicks = 200) : tiles(capacity), capacity(capacity), refreshTicks(refreshTicks) {}
+
+	// Samples columns within `radius` chunks of the block column (x, z), looking down from topY to bottomY, until about
+	// `budget` lookups are used; a column that's been started is always finished, so it can go over by one column.
+	// Returns how many lookups it used.
+	size_t update(BlockSource const& source, int x, int z, int radius, int topY, int bottomY, size_t budget) {
+		tick++;
+		setRadius(radius);
+		Scan scan{ source, topY, bottomY, budget, 0 };
+		run(scan, floorDiv(x), floorDiv(z));
+		stats.lookups += scan.used;
+		return scan.used;
+	}
+
+	// Samples the column at (x, z) again the next time its tile is in range
+	void markDirty(int x, int z) {
+		if (auto tile = tiles.get(key(floorDiv(x), floorDiv(z)))) {
+			tile->dirty.set(index(x, z));
+		}
+	}
+
+	// Calls fn(chunkX, chunkZ, tile) for each tile within the last update's radius of (x, z) that changed since it was
+	// last taken, and clears its flag
+	template <typename Fn>
+	void takeChanged(int x, int z, Fn&& fn) {
+		int centerX = floorDiv(x), centerZ = floorDiv(z);
+		for (auto [dx, dz] : offsets) {
+			auto tile = find(centerX + dx, centerZ + dz);
+			if (!tile || !tile->changed) continue;
+			fn(centerX + dx, centerZ + dz, std::as_const(*tile));
+			tile->changed = false;
+		}
+	}
+
+	// Forgets every tile, e.g. when the dimension changes. Block colours are kept.
+	void clear() {
+		tiles.clear();
+	}
+
+	// The tile for a chunk, if it's cached
+	[[nodiscard]] Tile* find(int chunkX, int chunkZ) {
+		return tiles.get(key(chunkX, chunkZ));
+	}
+
+	[[nodiscard]] Stats getStats() const {
+		auto cacheStats = tiles.getStats();
+		Stats ret = stats;
+		ret.evictions = cacheStats.evictions;
+		ret.tiles = cacheStats.size;
+		ret.capacity = cacheStats.capacity;
+		return ret;
+	}
+
+	// The map colour (0xAARRGGBB) for a block name; 0 for blocks the map looks through, like air
+	[[nodiscard]] static uint32_t getColor(std::string_view name) {
+		struct Rule {
+			std::string_view part;
+			uint32_t color;
+		};
+		// "air" would also match stairs
+		if (name == "air") return 0;
+
+		// first match wins, so more specific names go first
+		static constexpr Rule rules[] = {
+			{ "structure_void", 0 },
+			{ "barrier", 0 },
+			{ "light_block", 0 },
+			{ "tallgrass", 0 },
+			{ "short_grass", 0 },
+			{ "water", 0xFF4040FF },
+			{ "lava", 0xFFFF0000 },
+			{ "leaves", 0xFF007C00 },
+			{ "grass_path", 0xFF976D4D },
+			{ "grass", 0xFF7FB238 },
+			{ "snow", 0xFFFFFFFF },
+			{ "ice", 0xFFA0A0FF },
+			{ "red_sand", 0xFFD87F33 },
+			{ "sand", 0xFFF7E9A3 },
+			{ "end_stone", 0xFFF7E9A3 },
+			{ "mycelium", 0xFF7F3FB2 },
+			{ "dirt", 0xFF976D4D },
+			{ "farmland", 0xFF976D4D },
+			{ "podzol", 0xFF815631 },
+			{ "mud", 0xFF815631 },
+			{ "log", 0xFF8F7748 },
+			{ "wood", 0xFF8F7748 },
+			{ "planks", 0xFF8F7748 },
+			{ "clay", 0xFFA4A8B8 },
+			{ "soul_s", 0xFF664C33 },
+			{ "netherrack", 0xFF700200 },
+			{ "obsidian", 0xFF191919 },
+		};
+		for (auto& rule : rules) {
+			if (name.find(rule.part) != std::string_view::npos) return rule.color;
+		}
+		return 0xFF707070;
+	}
+private:
+	struct Scan {
+		BlockSource const& source;
+		int topY;
+		int bottomY;
+		size_t budget;
+		size_t used;
+	};
+
+	static int floorDiv(int value) {
+		return (value >= 0 ? value : value - (tile_size - 1)) / tile_size;
+	}
+
+	static int index(int x, int z) {
+		return (z - floorDiv(z) * tile_size) * tile_size + (x - floorDiv(x) * tile_size);
+	}
+
+	static uint64_t key(int chunkX, int chunkZ) {
+		return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkZ);
+	}
+
+	void setRadius(int newRadius) {
+		newRadius = std::max(newRadius, 0);
+		if (newRadius == radius && !offsets.empty()) return;
+		radius = newRadius;
+
+		offsets.clear();
+		for (int dz = -radius; dz <= radius; dz++) {
+			for (int dx = -radius; dx <= radius; dx++) offsets.emplace_back(dx, dz);
+		}
+		std::stable_sort(offsets.begin(), offsets.end(), [](auto const& a, auto const& b) {
+			return a.first * a.first + a.second * a.second < b.first * b.first + b.second * b.second;
+			});
+		// every tile in range has to fit, or scanning them would evict each other
+		tiles.setCapacity(std::max(capacity, offsets.size()));
+	}
+
+	void run(Scan& scan, int centerX, int centerZ) {
+		// new and dirty tiles
+		for (auto [dx, dz] : offsets) {
+			auto& tile = get(centerX + dx, centerZ + dz);
+			if (tile.dirty.any()) scanTile(scan, tile, centerX + dx, centerZ + dz);
+			if (scan.used >= scan.budget) return;
+		}
+
+		// nothing left to do, so look again at the stalest tile, in case the world changed under it
+		Tile* stalest = nullptr;
+		int stalestX = 0, stalestZ = 0;
+		for (auto [dx, dz] : offsets) {
+			auto& tile = get(centerX + dx, centerZ + dz);
+			if (tick - tile.scannedAt < refreshTicks) continue;
+			if (!stalest || tile.scannedAt < stalest->scannedAt) {
+				stalest = &tile;
+				stalestX = centerX + dx;
+				stalestZ = centerZ + dz;
+			}
+		}
+		if (stalest) {
+			stalest->dirty.set();
+			scanTile(scan, *stalest, stalestX, stalestZ);
+		}
+	}
+
+	Tile& get(int chunkX, int chunkZ) {
+		auto k = key(chunkX, chunkZ);
+		if (auto tile = tiles.get(k)) return *tile;
+		stats.tilesCreated++;
+		Tile tile;
+		tile.dirty.set();
+		return tiles.put(k, tile);
+	}
+
+	uint32_t resolve(BlockSource const& source, uintptr_t block) {
+		auto it = colors.find(block);
+		if (it == colors.end()) it = colors.emplace(block, getColor(source.getName(block))).first;
+		return it->second;
+	}
+
+	void scanTile(Scan& scan, Tile& tile, int chunkX, int chunkZ) {
+		for (int i = 0; i < tile_area && scan.used < scan.budget; i++) {
+			if (!tile.dirty.test(i)) continue;
+			tile.dirty.reset(i);
+			stats.columns++;
+
+			int x = chunkX * tile_size + i % tile_size;
+			int z = chunkZ * tile_size + i / tile_size;
+			uint32_t color = 0;
+			int height = scan.bottomY;
+			for (int y = scan.topY; y >= scan.bottomY; y--) {
+				scan.used++;
+				auto block = scan.source.getBlock(x, y, z);
+				if (!block) continue;
+				color = resolve(scan.source, block);
+				if (color) {
+					height = y;
+					break;
+				}
+			}
+
+			// shade by the slope to the north, like a map item
+			if (color && i >= tile_size && tile.pixels[i - tile_size]) {
+				int north = tile.heights[i - tile_size];
+				if (height > north) color = shade(color, 255);
+				else if (height < north) color = shade(color, 180);
+				else color = shade(color, 220);
+			}
+			else if (color) {
+				color = shade(color, 220);
+			}
+
+			if (tile.heights[i] != height && i + tile_size < tile_area) {
+				// the column south of this one is shaded by it
+				tile.dirty.set(i + tile_size);
+			}
+			tile.heights[i] = static_cast<int16_t>(height);
+			if (tile.pixels[i] != color) {
+				tile.pixels[i] = color;
+				tile.changed = true;
+			}
+		}
+		if (tile.dirty.none()) tile.scannedAt = tick;
+	}
+
+	static uint32_t shade(uint32_t color, uint32_t amount) {
+		uint32_t r = ((color >> 16) & 0xFF) * amount / 255;
+		uint32_t g = ((color >> 8) & 0xFF) * amount / 255;
+		uint32_t b = (color & 0xFF) * amount / 255;
+		return (color & 0xFF000000) | (r << 16) | (g << 8) | b;
+	}
+
+	LRUCache<uint64_t, Tile> tiles;
+	size_t capacity;
+	uint64_t refreshTicks;
+	std::unordered_map<uintptr_t, uint32_t> colors;
+	// chunk offsets within the radius, nearest first
+	std::vector<std::pair<int, int>> offsets;
+	int radius = -1;
+	uint64_t tick = 0;
+	Stats stats;
+};
@@ -10,16 +10,18 @@ PingDisplay::PingDisplay() : TextModule("PingDisplay", LocalizeString::get("clie
 	listen<AveragePingEvent>((EventListenerFunc)&PingDisplay::onAvgPing, true);
 }
 
-std::wstringstream PingDisplay::text(bool isDefault, bool inEditor) {
-	std::wstringstream wss;
-	int dPing = 0;
+int PingDisplay::getDisplayPing() {
+	return SDK::RakNetConnector::get() ? ping : 0;
+}
 
-	auto inst = SDK::RakNetConnector::get();
-	if (inst) {
-		dPing = ping;
-	}
+bool PingDisplay::isTextDirty(bool isDefault, bool inEditor) {
+	return getDisplayPing() != lastPing;
+}
 
-	wss << dPing;
+std::wstringstream PingDisplay::text(bool isDefault, bool inEditor) {
+	std::wstringstream wss;
+	lastPing = getDisplayPing();
+	wss << lastPing;
 
 	return wss;
 }
@@ -6,8 +6,12 @@ public:
 	PingDisplay();
 
 	std::wstringstream text(bool isDefault, bool inEditor) override;
+	bool isTextDirty(bool isDefault, bool inEditor) override;
 
 	void onAvgPing(Event& ev);
 private:
 	int ping = 0;
+	int lastPing = -1;
+
+	[[nodiscard]] int getDisplayPing();
 };
\ No newline at end of file
@@ -21,8 +21,6 @@ void TabList::onRenderOverlay(Event& evG) {
 	D2DUtil dc;
 	auto lvl = SDK::ClientInstance::get()->minecraft->getLevel();
 
-	size_t size = lvl->getPlayerList()->size();
-
 	float textP = 20.f;
 
 	std::wstring txt;
@@ -39,17 +37,38 @@ void TabList::onRenderOverlay(Event& evG) {
 	float logoSize = sectionHeight;
 	float logoPad = 4.f;
 
-	float longestText = dc.getTextSize(txt, font, textP).x;
-	for (auto& ent : *lvl->getPlayerList()) {
-		auto w = dc.getTextSize(util::StrToWStr(ent.second.name), font, textP).x + 3.f;
-		auto const& name = util::StrToWStr(ent.second.name);
-		for (auto& user : Latite::get().getLatiteUsers()) {
-			if (user == ent.second.name) {
-				w += logoPad + logoSize;
+	auto playerList = lvl->getPlayerList();
+	auto userVersion = Latite::get().getLatiteUsers().getVersion();
+	bool valid = rowsValid && rowsUserVersion == userVersion && rows.size() == playerList->size();
+	if (valid) {
+		size_t i = 0;
+		for (auto& ent : *playerList) {
+			if (rows[i++].name != ent.second.name) {
+				valid = false;
+				break;
 			}
 		}
+	}
 
-		if (w > longestText) longestText = w;
+	if (!valid) {
+		auto users = Latite::get().getLatiteUsers().get();
+		rows.clear();
+		for (auto& ent : *playerList) {
+			Row row{ ent.second.name, util::StrToWStr(ent.second.name) };
+			row.isLatiteUser = users->contains(row.name);
+			row.width = dc.getTextSize(row.displayName, font, textP).x + 3.f;
+			if (row.isLatiteUser) row.width += logoPad + logoSize;
+			rows.push_back(std::move(row));
+		}
+		rowsUserVersion = userVersion;
+		rowsValid = true;
+	}
+
+	size_t size = rows.size();
+
+	float longestText = dc.getTextSize(txt, font, textP).x;
+	for (auto& row : rows) {
+		if (row.width > longestText) longestText = row.width;
 	}
 
 	float sectionSize = longestText;
@@ -81,21 +100,18 @@ void TabList::onRenderOverlay(Event& evG) {
 	dc.drawText({ 0.f, 0.f, calcWidth, oY }, txt, std::get<ColorValue>(this->textCol).getMainColor(), font, textP, DWRITE_TEXT_ALIGNMENT_CENTER);
 
 
-	for (auto& ent : *lvl->getPlayerList()) {
-		auto const& name = util::StrToWStr(ent.second.name);
+	for (auto& row : rows) {
 		d2d::Rect rc = { x, y, x + longestText, y + sectionHeight };
-		for (auto& user : Latite::get().getLatiteUsers()) {
-			if (user == ent.second.name) {
-				rc.left += logoSize + logoPad;
-				d2d::Rect logoRc = { x, y, x + logoSize, y + logoSize };
-				dc.ctx->DrawBitmap(Latite::getAssets().logoWhite.getBitmap(), logoRc);
-			}
+		if (row.isLatiteUser) {
+			rc.left += logoSize + logoPad;
+			d2d::Rect logoRc = { x, y, x + logoSize, y + logoSize };
+			dc.ctx->DrawBitmap(Latite::getAssets().logoWhite.getBitmap(), logoRc);
 		}
 
 		// render
 		//dc.drawRectangle(rc, d2d::Colors::BLACK, 0.5f);
 
-		dc.drawText(rc, name, std::get<ColorValue>(textCol).getMainColor(), font, textP, DWRITE_TEXT_ALIGNMENT_LEADING, DWRITE_PARAGRAPH_ALIGNMENT_NEAR, false);
+		dc.drawText(rc, row.displayName, std::get<ColorValue>(textCol).getMainColor(), font, textP, DWRITE_TEXT_ALIGNMENT_LEADING, DWRITE_PARAGRAPH_ALIGNMENT_NEAR, false);
 
 		idx++;
 		if (idx < maxPerTab) {
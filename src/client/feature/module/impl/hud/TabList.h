@@ -6,9 +6,24 @@ public:
 	TabList();
 
 	void onRenderOverlay(Event&);
+	// text is measured again every time the list is opened
+	void onEnable() override { rowsValid = false; }
 	bool shouldHoldToToggle() override { return true; }
 private:
+	struct Row {
+		std::string name;
+		std::wstring displayName;
+		// including the logo
+		float width = 0.f;
+		bool isLatiteUser = false;
+	};
+
 	ValueType textCol = ColorValue(1.f, 1.f, 1.f, 1.f);
 	ValueType bgCol = ColorValue(0.f, 0.f, 0.f, 0.5f);
+
+	// one per player, rebuilt when the player list or the Latite users change
+	std::vector<Row> rows;
+	uint64_t rowsUserVersion = 0;
+	bool rowsValid = false;
 };
 
@@ -5,6 +5,7 @@
 #include "client/render/Renderer.h"
 #include "client/event/impl/DrawHUDModulesEvent.h"
 #include "client/event/impl/RenderLayerEvent.h"
+#include "client/event/impl/TickEvent.h"
 
 #include "sdk/common/world/level/HitResult.h"
 #include "sdk/common/client/gui/ScreenView.h"
@@ -15,129 +16,132 @@
 DebugInfo::DebugInfo() : Module("DebugInfo", LocalizeString::get("client.module.debugInfo.name"),
                                 LocalizeString::get("client.module.debugInfo.desc"), GAME, VK_F3) {
     listen<RenderLayerEvent>(static_cast<EventListenerFunc>(&DebugInfo::onRenderOverlay));
+    listen<TickEvent>(static_cast<EventListenerFunc>(&DebugInfo::onTick));
     listen<DrawHUDModulesEvent>(static_cast<EventListenerFunc>(&DebugInfo::onRenderHUDModules), false, 2);
 }
 
 namespace {
-    std::string getMinecraftVersion() {
-        return std::format("Latite Client {}, Minecraft {}", Latite::get().version, Latite::get().gameVersion);
-    }
-    std::string getFPS() {
-        return std::format("FPS: {}", Latite::get().getTimings().getFPS());
-    }
-    std::string getDimension() {
-        return std::format("Dimension: {}", SDK::ClientInstance::get()->getLocalPlayer()->dimension->dimensionName);
-    }
-    std::string getCoordinates() {
-        Vec3 position = SDK::ClientInstance::get()->getLocalPlayer()->getPos();
-        std::string ln1 = std::format("XYZ: {:.1f} / {:.1f} / {:.1f}", position.x, position.y, position.z);
-        std::string ln2;
-        if (SDK::ClientInstance::get()->getLocalPlayer()->dimension->dimensionName == "Nether") ln2 = std::format("Overworld: {:.1f} / {:.1f} / {:.1f}", position.x * 8.f, position.y, position.z * 8.f);
-        return ln1 + "\n" + ln2;
-    }
-    std::string getVelocity() {
-        Vec3 velocity = SDK::ClientInstance::get()->getLocalPlayer()->getVelocity();
-        return std::format("Velocity: {:.3f} / {:.3f} / {:.3f}", velocity.x, velocity.y, velocity.z);
-    }
-    std::string getRotation() {
-        Vec2 rotation = SDK::ClientInstance::get()->getLocalPlayer()->getRot();
-        return std::format("Facing: {:.3f} / {:.3f}", rotation.x, rotation.y);
-    }
-    std::string getLookingAt() {
-        auto lvl = SDK::ClientInstance::get()->minecraft->getLevel();
-        std::string fin;
-        if (lvl->getHitResult()->hitType == SDK::HitType::BLOCK) {
-            BlockPos solidBlock = lvl->getHitResult()->hitBlock;
-            fin += std::format("Looking at block: {} {} {}\n", solidBlock.x, solidBlock.y, solidBlock.z);
-        }
-        if (lvl->getLiquidHitResult()->hitType == SDK::HitType::BLOCK) {
-            BlockPos liquidBlock = lvl->getLiquidHitResult()->liquidBlock;
-            fin += std::format("Looking at liquid: {} {} {}", liquidBlock.x, liquidBlock.y, liquidBlock.z);
-        }
-        return fin;
-    }
-    // TODO: block info, tps info, tick speed info, biome info, days ran on server.
+    constexpr double bytes_per_gb = 1024.0 * 1024.0 * 1024.0;
 
+    // to the precision a line shows, so it isn't formatted again for changes nobody can see
+    int64_t toKey(double value, double scale) {
+        return std::llround(value * scale);
+    }
+}
+// TODO: block info, tick speed info, biome info, days ran on server.
 
-    std::string getMemUsage() {
-        // Get the total available memory
-        MEMORYSTATUSEX memStatus;
-        memStatus.dwLength = sizeof(memStatus);
-        GlobalMemoryStatusEx(&memStatus);
+void DebugInfo::onEnable() {
+    stats.start(sample_interval);
+}
 
-        // Convert memory usage values to GB
-        double usedMemoryGB = static_cast<double>(memStatus.ullTotalPhys - memStatus.ullAvailPhys) / (1024 * 1024 * 1024); // Convert to GB
-        double totalMemoryGB = static_cast<double>(memStatus.ullTotalPhys) / (1024 * 1024 * 1024); // Convert to GB
+void DebugInfo::onDisable() {
+    stats.stop();
+}
 
-        // Calculate the ratio of used memory to total memory
-        double memoryUsageRatio = usedMemoryGB / totalMemoryGB;
+void DebugInfo::onEject() {
+    // onDisable runs again from DllMain, where waiting on the collector would deadlock; by then it's a no-op
+    stats.stop();
+}
 
-        return std::format("Memory Usage: {:.2f} GB / {:.2f} GB", usedMemoryGB, totalMemoryGB);
-    }
-    std::string getGpuInfo() {
-        return std::format("Display: Unknown (DirectX{})", Latite::getRenderer().isDX11ByDefault() ? "11/10.1" : "12");
-    }
-    std::string getCpuInfo() {
-        std::string cpuInfo = util::GetProcessorInfo();
-        SYSTEM_INFO inf;
-        GetSystemInfo(&inf);
-        cpuInfo = std::to_string(inf.dwNumberOfProcessors) + "x " + cpuInfo;
-        return cpuInfo;
-    }
-    std::string getRenderPerfInfo() {
-        static std::vector<float> arpPerf = {};
-        static std::vector<float> d2dPerf = {};
-        static std::vector<float> d3dPerf = {};
-
-        auto chkVec = [](std::vector<float>& vec, float add) -> float {
-            vec.insert(vec.begin(), add);
-            if (vec.size() > 100) {
-                vec.pop_back();
-            }
-
-            float avg = 0.f;
-            for (auto& a : vec) {
-                avg += a;
-            }
-            return avg / (float)vec.size();
-        };
-
-        float arp = chkVec(arpPerf, Latite::getRenderer().arpPerf / 1000.f);
-        float d2d = chkVec(d2dPerf, Latite::getRenderer().d2dPerf / 1000.f);
-        float d3d = chkVec(d3dPerf, Latite::getRenderer().d3dPerf / 1000.f);
-
-        return std::format("\nAverages:\nAcquireWrappedResources: {:.3f}ms\nLatite Direct2D total: {:.3f}ms \nLatite Direct3D total: {:.3f}ms", arp, d2d, d3d);
-    }
+void DebugInfo::onTick(Event&) {
+    stats.countTick();
 }
-#undef GETFPS
 
 void DebugInfo::onRenderOverlay(Event& evG) {
     RenderLayerEvent& ev = reinterpret_cast<RenderLayerEvent&>(evG);
     MCDrawUtil dc{ ev.getUIRenderContext(), Latite::get().getFont() };
 
-    if (!SDK::ClientInstance::get()->getLocalPlayer()) return;
+    auto lp = SDK::ClientInstance::get()->getLocalPlayer();
+    if (!lp) return;
+
+    auto& renderer = Latite::getRenderer();
+    stats.setFrame(Latite::get().getTimings().getFPS(), renderer.arpPerf / 1000.f, renderer.d2dPerf / 1000.f, renderer.d3dPerf / 1000.f);
 
     if (ev.getScreenView()->visualTree->rootControl->name == "hud_screen") {
         auto [width, height] = SDK::ClientInstance::get()->getGuiData()->screenSize;
         d2d::Rect rect = { 0.f, 0.f, width, height };
+        auto& snapshot = stats.read();
+
+        bool leftChanged = version.update([] {
+            return util::StrToWStr(std::format("Latite Client {}, Minecraft {}", Latite::get().version, Latite::get().gameVersion));
+            });
+        leftChanged |= fps.update([&] { return std::format(L"FPS: {}", snapshot.fps); }, snapshot.fps);
+        leftChanged |= tickRate.update([&] { return std::format(L"TPS: {:.1f}", snapshot.tickRate); }, static_cast<int>(toKey(snapshot.tickRate, 10.0)));
+
+        auto& dimensionName = lp->dimension->dimensionName;
+        leftChanged |= dimension.update([&] { return L"Dimension: " + util::StrToWStr(dimensionName); }, dimensionName);
+
+        Vec3 position = lp->getPos();
+        bool nether = dimensionName == "Nether";
+        leftChanged |= coordinates.update([&] {
+            auto text = std::format(L"XYZ: {:.1f} / {:.1f} / {:.1f}\n", position.x, position.y, position.z);
+            if (nether) text += std::format(L"Overworld: {:.1f} / {:.1f} / {:.1f}", position.x * 8.f, position.y, position.z * 8.f);
+            return text;
+            }, toKey(position.x, 10.0), toKey(position.y, 10.0), toKey(position.z, 10.0), nether);
+
+        Vec2 rot = lp->getRot();
+        leftChanged |= rotation.update([&] { return std::format(L"Facing: {:.3f} / {:.3f}", rot.x, rot.y); }, toKey(rot.x, 1000.0), toKey(rot.y, 1000.0));
+
+        auto lvl = SDK::ClientInstance::get()->minecraft->getLevel();
+        bool hitBlock = lvl->getHitResult()->hitType == SDK::HitType::BLOCK;
+        bool hitLiquid = lvl->getLiquidHitResult()->hitType == SDK::HitType::BLOCK;
+        BlockPos solidBlock = hitBlock ? lvl->getHitResult()->hitBlock : BlockPos{};
+        BlockPos liquidBlock = hitLiquid ? lvl->getLiquidHitResult()->liquidBlock : BlockPos{};
+        leftChanged |= lookingAt.update([&] {
+            std::wstring text;
+            if (hitBlock) text += std::format(L"Looking at block: {} {} {}\n", solidBlock.x, solidBlock.y, solidBlock.z);
+            if (hitLiquid) text += std::format(L"Looking at liquid: {} {} {}", liquidBlock.x, liquidBlock.y, liquidBlock.z);
+            return text;
+            }, hitBlock, solidBlock.x, solidBlock.y, solidBlock.z, hitLiquid, liquidBlock.x, liquidBlock.y, liquidBlock.z);
+
+        if (leftChanged) {
+            topLeft = std::format(L"{}\n{}\n{}\n\n{}\n{}\n{}\n{}", version.get(), fps.get(), tickRate.get(), dimension.get(),
+                coordinates.get(), rotation.get(), lookingAt.get());
+        }
+
+        double usedGB = static_cast<double>(snapshot.systemMemoryUsed) / bytes_per_gb;
+        double totalGB = static_cast<double>(snapshot.systemMemoryTotal) / bytes_per_gb;
+        bool rightChanged = memory.update([&] { return std::format(L"Memory Usage: {:.2f} GB / {:.2f} GB", usedGB, totalGB); },
+            toKey(usedGB, 100.0), toKey(totalGB, 100.0));
+
+        bool dx11 = renderer.isDX11ByDefault();
+        rightChanged |= display.update([&] { return std::format(L"Display: Unknown (DirectX{})", dx11 ? L"11/10.1" : L"12"); }, dx11);
+        auto& acquire = snapshot.acquire;
+        auto& d2dTime = snapshot.d2d;
+        auto& d3dTime = snapshot.d3d;
+        rightChanged |= frameTimes.update([&] {
+            return std::format(L"Frame (avg/p95 ms): acquire {:.2f}/{:.2f}, D2D {:.2f}/{:.2f}, D3D {:.2f}/{:.2f}",
+                acquire.mean, acquire.p95, d2dTime.mean, d2dTime.p95, d3dTime.mean, d3dTime.p95);
+            }, toKey(acquire.mean, 100.0), toKey(acquire.p95, 100.0), toKey(d2dTime.mean, 100.0), toKey(d2dTime.p95, 100.0),
+            toKey(d3dTime.mean, 100.0), toKey(d3dTime.p95, 100.0));
+        rightChanged |= cpu.update([&] {
+            auto& info = stats.getInfo();
+            return util::StrToWStr(std::to_string(info.cores) + "x " + info.cpu);
+            });
+
+        auto cacheStats = renderer.getLayoutCacheStats();
+        rightChanged |= layoutCache.update([&] {
+            return std::format(L"Text layouts: {}/{} (hits: {}, misses: {}, evictions: {})", cacheStats.size, cacheStats.capacity,
+                cacheStats.hits, cacheStats.misses, cacheStats.evictions);
+            }, cacheStats.size, cacheStats.capacity, cacheStats.hits, cacheStats.misses, cacheStats.evictions);
+
+        auto clientJobs = Latite::get().getClientThreadJobStats();
+        auto dxJobs = Latite::get().getDXRenderJobStats();
+        rightChanged |= jobs.update([&] {
+            return std::format(L"Jobs (queued, wait/cost p95 ms): client {} {:.1f}/{:.2f}, DX {} {:.1f}/{:.2f}",
+                clientJobs.depth, clientJobs.waitP95, clientJobs.costP95, dxJobs.depth, dxJobs.waitP95, dxJobs.costP95);
+            }, clientJobs.depth, toKey(clientJobs.waitP95, 10.0), toKey(clientJobs.costP95, 100.0),
+            dxJobs.depth, toKey(dxJobs.waitP95, 10.0), toKey(dxJobs.costP95, 100.0));
+
+        if (rightChanged) {
+            topRight = std::format(L"{}\n{}\n{}\n{}\n{}\n{}\n", memory.get(), display.get(), frameTimes.get(), cpu.get(),
+                layoutCache.get(), jobs.get());
+        }
 
-        const std::wstring topLeftDebugInfo = util::StrToWStr(std::format("{}\n{}\n\n{}\n{}\n{}\n{}",
-            getMinecraftVersion(),
-            getFPS(),
-            getDimension(),
-            getCoordinates(),
-            //getVelocity(),
-            getRotation(),
-            getLookingAt()));
-        const std::wstring topRightDebugInfo = util::StrToWStr(std::format("{}\n{}\n{}\n",
-            getMemUsage(),
-            getGpuInfo(),
-            getCpuInfo()));
-
-        dc.drawText(rect, topLeftDebugInfo, d2d::Colors::WHITE, Renderer::FontSelection::PrimaryRegular,
+        dc.drawText(rect, topLeft, d2d::Colors::WHITE, Renderer::FontSelection::PrimaryRegular,
             28, DWRITE_TEXT_ALIGNMENT_LEADING, DWRITE_PARAGRAPH_ALIGNMENT_NEAR, false);
 
-        dc.drawText(rect, topRightDebugInfo, d2d::Colors::WHITE, Renderer::FontSelection::PrimaryRegular,
+        dc.drawText(rect, topRight, d2d::Colors::WHITE, Renderer::FontSelection::PrimaryRegular,
             28, DWRITE_TEXT_ALIGNMENT_TRAILING, DWRITE_PARAGRAPH_ALIGNMENT_NEAR, false);
 
         dc.flush(true, false);
@@ -1,12 +1,64 @@
 #pragma once
 #include "../../Module.h"
+#include "client/misc/SystemStats.h"
+#include <optional>
+#include <tuple>
 
 class DebugInfo : public Module {
 public:
 	DebugInfo();
 	virtual ~DebugInfo() = default;
 
+	void onEnable() override;
+	void onDisable() override;
+	void onEject() override;
 private:
+	// A line of text that's only formatted again when the values it shows change.
+	// Keys are what the line shows, at the precision it shows them.
+	template <typename... Keys>
+	class CachedLine {
+	public:
+		// Returns whether the text changed
+		template <typename Format>
+		bool update(Format&& format, Keys... keys) {
+			std::tuple<Keys...> next{ std::move(keys)... };
+			if (last == next) return false;
+			last = std::move(next);
+			text = format();
+			return true;
+		}
+
+		[[nodiscard]] std::wstring const& get() const { return text; }
+	private:
+		std::optional<std::tuple<Keys...>> last;
+		std::wstring text;
+	};
+
+	static constexpr std::chrono::milliseconds sample_interval{ 250 };
+
+	SystemStats stats;
+
+	CachedLine<> version;
+	CachedLine<int> fps;
+	CachedLine<int> tickRate;
+	CachedLine<std::string> dimension;
+	CachedLine<int64_t, int64_t, int64_t, bool> coordinates;
+	CachedLine<int64_t, int64_t> rotation;
+	// whether there's a block, and where; then the same for liquid
+	CachedLine<bool, int, int, int, bool, int, int, int> lookingAt;
+	std::wstring topLeft;
+
+	CachedLine<int64_t, int64_t> memory;
+	CachedLine<bool> display;
+	// mean and p95 of acquire, D2D and D3D
+	CachedLine<int64_t, int64_t, int64_t, int64_t, int64_t, int64_t> frameTimes;
+	CachedLine<> cpu;
+	CachedLine<size_t, size_t, uint64_t, uint64_t, uint64_t> layoutCache;
+	// queued jobs, and p95 wait and cost, for the client thread then the DX render thread
+	CachedLine<size_t, int64_t, int64_t, size_t, int64_t, int64_t> jobs;
+	std::wstring topRight;
+
+	void onTick(Event& ev);
 	void onRenderOverlay(Event& ev);
 	void onRenderHUDModules(Event& ev);
 };
@@ -5,30 +5,43 @@ Nickname::Nickname() : Module("Nickname", LocalizeString::get("client.module.nic
                               LocalizeString::get("client.module.nickname.desc"), GAME) {
 	addSetting("nick", LocalizeString::get("client.module.nickname.name"),
                LocalizeString::get("client.module.nickname.newNick.desc"), this->nickname);
+    addSetting("ignoreCase", LocalizeString::get("client.module.nickname.ignoreCase.name"),
+               LocalizeString::get("client.module.nickname.ignoreCase.desc"), this->ignoreCase);
+    addSetting("filter", LocalizeString::get("client.module.nickname.filter.name"),
+               LocalizeString::get("client.module.nickname.filter.desc"), this->filterWords);
 
     listen<ClientTextEvent>((EventListenerFunc)&Nickname::onClientTextPacket);
 }
 
+void Nickname::updateRules(std::string const& playerName) {
+    RuleSource source{ playerName, std::get<TextValue>(this->nickname).str, std::get<BoolValue>(this->ignoreCase), std::get<TextValue>(this->filterWords).str };
+    if (compiledFrom == source) return;
+
+    std::vector<TextRewriter::Rule> rules;
+    rules.push_back({ playerName, util::WStrToStr(source.nickname), source.ignoreCase, false });
+
+    // comma separated, each hidden behind as many asterisks as it has characters
+    std::wstringstream words{ source.filterWords };
+    std::wstring word;
+    while (std::getline(words, word, L',')) {
+        auto first = word.find_first_not_of(L' ');
+        if (first == std::wstring::npos) continue;
+        word = word.substr(first, word.find_last_not_of(L' ') - first + 1);
+        rules.push_back({ util::WStrToStr(word), std::string(word.size(), '*'), true, true });
+    }
+
+    rewriter.compile(std::move(rules));
+    compiledFrom = std::move(source);
+}
+
 void Nickname::onClientTextPacket(Event& evG) {
     auto textPacket = reinterpret_cast<ClientTextEvent&>(evG).getTextPacket();
 
-    if (!SDK::ClientInstance::get()->getLocalPlayer()) return;
-
-    auto message = textPacket->str.str();
-    auto source = textPacket->source.str();
-
-    auto replaceAll = [](std::string& s, std::string from, std::string to) {
-        if (!from.empty())
-            for (size_t pos = 0; (pos = s.find(from, pos)) != std::string::npos; pos += to.size())
-                s.replace(pos, from.size(), to);
-        return s;
-    };
-
-    std::string newName = util::WStrToStr(std::get<TextValue>(this->nickname).str);
-    auto& currentPlayerName = SDK::ClientInstance::get()->getLocalPlayer()->playerName;
-    replaceAll(message, currentPlayerName, newName);
-    replaceAll(source, currentPlayerName, newName);
+    auto lp = SDK::ClientInstance::get()->getLocalPlayer();
+    if (!lp) return;
 
-    textPacket->str.setString(message.c_str());
-    textPacket->source.setString(source.c_str());
+    updateRules(lp->playerName);
+    // only touch the packet if something matched
+    if (rewriter.rewrite(textPacket->str.view(), rewritten)) textPacket->str.setString(rewritten.c_str());
+    if (rewriter.rewrite(textPacket->source.view(), rewritten)) textPacket->source.setString(rewritten.c_str());
 }
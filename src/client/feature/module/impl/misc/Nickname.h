@@ -1,5 +1,6 @@
 #pragma once
 #include "../../Module.h"
+#include "util/TextRewriter.h"
 #include <sdk/common/network/packet/TextPacket.h>
 
 class Nickname : public Module {
@@ -10,4 +11,22 @@ public:
 	void onClientTextPacket(Event& evG);
 private:
 	ValueType nickname = TextValue(L"Nickname");
-};
\ No newline at end of file
+	ValueType ignoreCase = BoolValue(false);
+	ValueType filterWords = TextValue(L"");
+
+	// what the rules were last compiled from
+	struct RuleSource {
+		std::string playerName;
+		std::wstring nickname;
+		bool ignoreCase;
+		std::wstring filterWords;
+
+		bool operator==(RuleSource const&) const = default;
+	};
+
+	std::optional<RuleSource> compiledFrom;
+	TextRewriter rewriter;
+	std::string rewritten;
+
+	void updateRules(std::string const& playerName);
+};
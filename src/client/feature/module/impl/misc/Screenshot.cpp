@@ -3,28 +3,21 @@
 #include "client/event/impl/KeyUpdateEvent.h"
 #include "client/event/impl/UpdateEvent.h"
 #include "client/event/impl/RenderOverlayEvent.h"
+#include "client/event/impl/RendererCleanupEvent.h"
 #include "client/Latite.h"
 #include "client/render/Renderer.h"
 #include "client/misc/ClientMessageQueue.h"
 
-#include <SHCore.h>
-
-#include <winrt/windows.storage.h>
-#include <winrt/windows.storage.streams.h>
 #include <util/DxContext.h>
 
-using namespace winrt;
-using namespace winrt::Windows::Web::Http;
-using namespace winrt::Windows::Web::Http::Filters;
-using namespace winrt::Windows::Storage::Streams;
-using namespace winrt::Windows::Storage;
-
 Screenshot::Screenshot() : Module("Screenshot", L"Screenshot", L"Take a screenshot with a key.", GAME, nokeybind) {
     listen<KeyUpdateEvent>((EventListenerFunc)&Screenshot::onKey);
     listen<UpdateEvent>((EventListenerFunc)&Screenshot::onUpdate);
     listen<RenderOverlayEvent>((EventListenerFunc)&Screenshot::onRenderOverlay, false, 0 /*lowest priority so that Latite renders everything else*/);
+    listen<RendererCleanupEvent>((EventListenerFunc)&Screenshot::onCleanup, true);
 
     addSetting("ssKey", L"Screenshot key", L"The key you press to take a screenshot", this->screenshotKey);
+    addSetting("fastEncode", L"Fast saving", L"Save screenshots faster, but with bigger files", this->fastEncode);
 }
 
 namespace {
@@ -45,8 +38,9 @@ void Screenshot::onKey(Event& evG) {
 void Screenshot::onRenderOverlay(Event& ev) {
     D2DUtil dc;
     if (queueToScreenshot) {
-        takeScreenshot(screenshotPath);
-        Latite::getClientMessageQueue().push(std::format("Screenshot saved to {}", (screenshotPath / "screenshot.png").string()));
+        if (!takeScreenshot(screenshotPath)) {
+            Latite::getClientMessageQueue().push("Couldn't take a screenshot, try again in a moment.");
+        }
         queueToScreenshot = false;
     }
 
@@ -76,82 +70,59 @@ void Screenshot::onUpdate(Event& ev) {
     }
 }
 
-winrt::Windows::Foundation::IAsyncAction Screenshot::takeScreenshot(std::filesystem::path const& path) {
-    // file
-    auto folder = co_await StorageFolder::GetFolderFromPathAsync(path.wstring());
-    auto file = co_await folder.CreateFileAsync(L"screenshot.png", CreationCollisionOption::OpenIfExists);
-    ComPtr<ID2D1Bitmap1> bmp = Latite::getRenderer().copyCurrentBitmap();
-
-    auto ctx = Latite::getRenderer().getDeviceContext();
-    ctx->Flush();// MC won't let me flush (???)s
-
-    IRandomAccessStream raStream = file.OpenAsync(FileAccessMode::ReadWrite).get();
-    ComPtr<IStream> stream;
-    ThrowIfFailed(
-        CreateStreamOverRandomAccessStream(raStream.as<IUnknown>().get(), IID_PPV_ARGS(&stream))
-    );
-
-    auto wicFactory = Latite::getRenderer().getImagingFactory();
-
-    // https://learn.microsoft.com/en-us/windows/win32/direct2d/save-direct2d-content-to-an-image-file
-
-    ComPtr<IWICBitmapEncoder> wicBitmapEncoder;
-    ThrowIfFailed(
-        wicFactory->CreateEncoder(
-            GUID_ContainerFormatPng,
-            nullptr,    // No preferred codec vendor.
-            wicBitmapEncoder.GetAddressOf()
-        )
-    );
-
-    ThrowIfFailed(
-        wicBitmapEncoder->Initialize(
-            stream.Get(),
-            WICBitmapEncoderNoCache
-        )
-    );
-
-    ComPtr<IWICBitmapFrameEncode> wicFrameEncode;
-    ThrowIfFailed(
-        wicBitmapEncoder->CreateNewFrame(
-            &wicFrameEncode,
-            nullptr     // No encoder options.
-        )
-    );
-
-    ThrowIfFailed(
-        wicFrameEncode->Initialize(nullptr)
-    );
-
-    ComPtr<IWICImageEncoder> imageEncoder;
-    ThrowIfFailed(
-        wicFactory->CreateImageEncoder(
-            Latite::getRenderer().getDevice(),
-            &imageEncoder
-        )
-    );
-
-    ThrowIfFailed(
-        imageEncoder->WriteFrame(
-            bmp.Get(),
-            wicFrameEncode.Get(),
-            nullptr     // Use default WICImageParameter options.
-        )
-    );
-
-    ThrowIfFailed(
-        wicFrameEncode->Commit()
-    );
-
-    ThrowIfFailed(
-        wicBitmapEncoder->Commit()
-    );
-
-    // Flush all memory buffers to the next-level storage object.
-    ThrowIfFailed(
-        stream->Commit(STGC_DEFAULT)
-    );
-
-    //savedBitmap = std::move(bmp);
-    co_return;
+void Screenshot::onEject() {
+    writer.stop();
+}
+
+void Screenshot::onCleanup(Event&) {
+    stagingBitmap = nullptr;
+}
+
+bool Screenshot::takeScreenshot(std::filesystem::path const& path) {
+    auto& renderer = Latite::getRenderer();
+    auto ctx = renderer.getDeviceContext();
+    auto source = renderer.getBitmap();
+    auto size = source->GetPixelSize();
+    auto pixelFormat = source->GetPixelFormat();
+
+    auto order = ScreenshotWriter::getPixelOrder(pixelFormat.format);
+    if (!order) {
+        Logger::Warn("Can't take a screenshot of a back buffer in format {}", static_cast<int>(pixelFormat.format));
+        return false;
+    }
+
+    if (!stagingBitmap || stagingBitmap->GetPixelSize().width != size.width || stagingBitmap->GetPixelSize().height != size.height) {
+        stagingBitmap = nullptr;
+        auto props = D2D1::BitmapProperties1(D2D1_BITMAP_OPTIONS_CPU_READ | D2D1_BITMAP_OPTIONS_CANNOT_DRAW,
+            D2D1::PixelFormat(pixelFormat.format, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        if (FAILED(ctx->CreateBitmap(size, nullptr, 0, props, stagingBitmap.GetAddressOf()))) return false;
+    }
+
+    // make sure everything drawn so far is in the back buffer
+    ctx->Flush();
+    if (FAILED(stagingBitmap->CopyFromBitmap(nullptr, source, nullptr))) return false;
+
+    D2D1_MAPPED_RECT mapped;
+    if (FAILED(stagingBitmap->Map(D2D1_MAP_OPTIONS_READ, &mapped))) return false;
+
+    ScreenshotWriter::Frame frame;
+    frame.width = size.width;
+    frame.height = size.height;
+    frame.order = *order;
+    frame.folder = path;
+    frame.fast = std::get<BoolValue>(fastEncode);
+
+    // copy rows into a tightly packed buffer; screenshots are opaque, whatever the back buffer's alpha is
+    size_t rowSize = static_cast<size_t>(size.width) * 4;
+    frame.pixels = writer.acquireBuffer(rowSize * size.height);
+    for (uint32_t y = 0; y < size.height; y++) {
+        auto dst = frame.pixels.data() + rowSize * y;
+        std::memcpy(dst, mapped.bits + static_cast<size_t>(mapped.pitch) * y, rowSize);
+        for (size_t x = 3; x < rowSize; x += 4) {
+            dst[x] = 0xFF;
+        }
+    }
+    stagingBitmap->Unmap();
+
+    return writer.submit(std::move(frame));
 }
@@ -1,17 +1,28 @@
 #pragma once
 #include "../../Module.h"
 #include "client/event/Eventing.h"
+#include "client/misc/ScreenshotWriter.h"
 #include <filesystem>
 
 class Screenshot : public Module {
 public:
 	Screenshot();
+
+	void onEject() override;
 private:
 	void onKey(Event& ev);
 	void onRenderOverlay(Event& ev);
 	void onUpdate(Event& ev);
-	winrt::Windows::Foundation::IAsyncAction takeScreenshot(std::filesystem::path const& path);
+	void onCleanup(Event& ev);
+	// Copies the back buffer to the CPU and hands it to the writer. Returns false if it couldn't.
+	bool takeScreenshot(std::filesystem::path const& path);
 	ValueType screenshotKey = KeyValue(VK_F2);
+	ValueType fastEncode = BoolValue(false);
+
+	// its thread only starts with the first screenshot
+	ScreenshotWriter writer;
+	// CPU readable copy of the back buffer, kept between screenshots
+	ComPtr<struct ID2D1Bitmap1> stagingBitmap;
 
 	bool queueToScreenshot = false;
 	std::filesystem::path screenshotPath{};
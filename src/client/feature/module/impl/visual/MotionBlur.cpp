@@ -26,46 +26,31 @@ void MotionBlur::onDisable() {
 void MotionBlur::onRender(Event& genericEv) {
 	auto& ev = reinterpret_cast<RenderOverlayEvent&>(genericEv);
 	auto ctx = ev.getDeviceContext();
-
+	auto& renderer = Latite::getRenderer();
 
 	if (this->isEnabled()) {
-		auto grainOfSalt = Latite::getRenderer().copyCurrentBitmap();
-		if (motionBlurList.size() > 0) {
-			for (auto& map : motionBlurList) {
-				if (map) {
-					auto ss = Latite::getRenderer().getScreenSize();
-					auto rc = D2D1::RectF(0.f, 0.f, ss.width, ss.height);
-					ctx->DrawBitmap(map, &rc, (std::get<FloatValue>(intensity) / 10.f) - 0.05f);
-					ctx->DrawBitmap(grainOfSalt, &rc, std::get<FloatValue>(antiBleed));
-				}
-			}
+		// frame 0 is last frame's blended output; capturing pushes it back to frame 1
+		auto grainOfSalt = renderer.captureFrame();
+		auto previous = renderer.getHistoryFrame(1);
+		if (grainOfSalt && previous) {
+			auto ss = renderer.getScreenSize();
+			auto rc = D2D1::RectF(0.f, 0.f, ss.width, ss.height);
+			ctx->DrawBitmap(previous, &rc, (std::get<FloatValue>(intensity) / 10.f) - 0.05f);
+			ctx->DrawBitmap(grainOfSalt, &rc, std::get<FloatValue>(antiBleed));
 			ctx->Flush();
-			SafeRelease(&motionBlurList.front());
-			motionBlurList.erase(motionBlurList.begin());
 		}
-		motionBlurList.push_back(Latite::getRenderer().copyCurrentBitmap());
-		SafeRelease(&grainOfSalt);
+		(void)renderer.captureFrame();
+		hasHistory = true;
 	}
-	else {
-		if (motionBlurList.size() > 0) {
-			for (auto& map : motionBlurList) {
-				if (map) SafeRelease(&map);
-			}
-		}
-		motionBlurList.clear();
+	else if (hasHistory) {
+		renderer.releaseFrameHistory();
+		hasHistory = false;
 	}
 }
 
 void MotionBlur::onCleanup(Event&) {
-	//auto& ev = reinterpret_cast<RendererCleanupEvent&>(genericEv);
-	//SafeRelease(&mbBitmap);
-	//SafeRelease(&oBitmap);
-
-	for (auto& bmp : this->motionBlurList) {
-		if (bmp) bmp->Release();
-	}
-
-	motionBlurList.clear();
+	// the renderer releases the history bitmaps itself
+	hasHistory = false;
 }
 
 void MotionBlur::onRendererInit(Event& genericEv) {
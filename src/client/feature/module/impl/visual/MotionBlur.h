@@ -16,9 +16,7 @@ public:
 	void onCleanup(Event& genericEv);
 	void onRendererInit(Event& genericEv);
 private:
-	std::vector<ID2D1Bitmap1*> motionBlurList = {};
-	ID2D1Bitmap1* mbBitmap = nullptr;
-	ID2D1Bitmap1* oBitmap = nullptr;
+	bool hasHistory = false;
 	ValueType intensity = FloatValue(7.f);
 	ValueType antiBleed = FloatValue(0.3f);
 };
\ No newline at end of file
@@ -15,10 +15,17 @@ JsHUDModule::JsHUDModule(std::string const& name, std::wstring const& displayNam
 	this->eventListeners[L"render"] = {};
 }
 
+JsHUDModule::~JsHUDModule() {
+	// a queued enable/disable may still point at this
+	Latite::get().cancelQueuedJobs(this);
+	// FIXME: check if no leak
+	//JS::JsRelease(object, nullptr);
+}
+
 void JsHUDModule::onEnable() {
 
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"enable", {  } };
@@ -26,7 +33,7 @@ void JsHUDModule::onEnable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 	Chakra::SetContext(ctx);
@@ -39,7 +46,7 @@ void JsHUDModule::onEnable() {
 
 void JsHUDModule::onDisable() {
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"disable", {  } };
@@ -47,7 +54,7 @@ void JsHUDModule::onDisable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 
@@ -8,10 +8,7 @@ public:
 	JsHUDModule(std::string const& name, std::wstring const& displayName,
 		std::wstring const& desc, int key, bool resizable);
 
-	~JsHUDModule() {
-		// FIXME: check if no leak
-		//JS::JsRelease(object, nullptr);
-	}
+	~JsHUDModule();
 
 	void onEnable() override;
 	void onDisable() override;
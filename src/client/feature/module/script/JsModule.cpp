@@ -11,10 +11,17 @@ JsModule::JsModule(std::string const& name, std::wstring const& displayName, std
 }
 
 
+JsModule::~JsModule() {
+	// a queued enable/disable may still point at this
+	Latite::get().cancelQueuedJobs(this);
+	// FIXME: check if no leak
+	//JS::JsRelease(object, nullptr);
+}
+
 void JsModule::onEnable() {
 
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"enable", {  } };
@@ -22,7 +29,7 @@ void JsModule::onEnable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 	Chakra::SetContext(ctx);
@@ -35,7 +42,7 @@ void JsModule::onEnable() {
 
 void JsModule::onDisable() {
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"disable", {  } };
@@ -43,7 +50,7 @@ void JsModule::onDisable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 
@@ -8,10 +8,7 @@ public:
 	JsModule(std::string const& name, std::wstring const& displayName, 
 		std::wstring const& desc, int key);
 
-	~JsModule() {
-		// FIXME: check if no leak
-		//JS::JsRelease(object, nullptr);
-	}
+	~JsModule();
 
 	void onEnable() override;
 	void onDisable() override;
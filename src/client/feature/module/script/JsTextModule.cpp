@@ -17,10 +17,17 @@ JsTextModule::JsTextModule(std::string const& name,
 
 
 
+JsTextModule::~JsTextModule() {
+	// a queued enable/disable may still point at this
+	Latite::get().cancelQueuedJobs(this);
+	// FIXME: check if no leak
+	//JS::JsRelease(object, nullptr);
+}
+
 void JsTextModule::onEnable() {
 
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"enable", {  } };
@@ -28,7 +35,7 @@ void JsTextModule::onEnable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 	Chakra::SetContext(ctx);
@@ -41,7 +48,7 @@ void JsTextModule::onEnable() {
 
 void JsTextModule::onDisable() {
 	if (!Latite::isMainThread()) {
-		// hey lets hope that the js module doesnt disappear by the time this code executes
+		// the destructor cancels this if the script unloads first
 		Latite::get().queueForClientThread([this]() {
 			Chakra::SetContext(ctx);
 			Event ev{ L"disable", {  } };
@@ -49,7 +56,7 @@ void JsTextModule::onDisable() {
 			if (ret != JS_INVALID_REFERENCE) {
 				Chakra::Release(ret);
 			}
-			});
+			}, { .priority = JobPriority::High, .owner = reinterpret_cast<uintptr_t>(this) });
 		return;
 	}
 
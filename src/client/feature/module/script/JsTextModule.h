@@ -8,10 +8,7 @@ public:
 	JsTextModule(std::string const& name, std::wstring const& displayName,
 		std::wstring const& desc, int key);
 
-	~JsTextModule() {
-		// FIXME: check if no leak
-		//JS::JsRelease(object, nullptr);
-	}
+	~JsTextModule();
 
 	void onEnable() override;
 	void onDisable() override;
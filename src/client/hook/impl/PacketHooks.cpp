@@ -93,58 +93,65 @@ void PacketHooks::PacketHandlerDispatcherInstance_handle(void* instance, void* n
 		else if (packetId == SDK::PacketID::TEXT) {
 			auto pkt = std::static_pointer_cast<SDK::TextPacket>(packet).get();
 
-			PluginManager::Event::Value typ{ L"type" };
-			typ.val = L"Unknown";
-			switch (pkt->type) {
-			case SDK::TextPacketType::RAW:
-				typ.val = L"raw";
-				break;
-			case SDK::TextPacketType::CHAT:
-				typ.val = L"chat";
-				break;
-			case SDK::TextPacketType::TRANSLATION:
-				typ.val = L"translation";
-				break;
-			case SDK::TextPacketType::JUKEBOX_POPUP:
-				typ.val = L"jukebox";
-				break;
-			case SDK::TextPacketType::TIP:
-				typ.val = L"tip";
-				break;
-			case SDK::TextPacketType::SYSTEM_MESSAGE:
-				typ.val = L"system_message";
-				break;
-			case SDK::TextPacketType::WHISPER:
-				typ.val = L"whisper";
-				break;
-			case SDK::TextPacketType::ANNOUNCEMENT:
-				typ.val = L"announcement";
-				break;
-			case SDK::TextPacketType::TEXT_OBJECT:
-				typ.val = L"text_object";
-				break;
-			case SDK::TextPacketType::OBJECT_WHISPER:
-				typ.val = L"object_whisper";
-				break;
-			}
-
-			PluginManager::Event::Value val{ L"message" };
-			val.val = util::StrToWStr(pkt->str);
-
-			PluginManager::Event::Value val2{ L"sender" };
-			val2.val = util::StrToWStr(pkt->source);
-
-			PluginManager::Event::Value val3{ L"xuid" };
-			val3.val = util::StrToWStr(pkt->xboxUserId);
-
-			PluginManager::Event::Value isChat{ L"isChat" };
-			isChat.val = (pkt->type == SDK::TextPacketType::CHAT || pkt->type == SDK::TextPacketType::RAW
-				|| pkt->type == SDK::TextPacketType::SYSTEM_MESSAGE || pkt->type == SDK::TextPacketType::WHISPER
-				|| pkt->type == SDK::TextPacketType::OBJECT_WHISPER || pkt->type == SDK::TextPacketType::ANNOUNCEMENT);
-
-			PluginManager::Event sEv{ L"receive-chat", { typ, val, val2, val3, isChat }, true };
-			if (Latite::getPluginManager().dispatchEvent(sEv)) {
-				return;
+			auto& plugins = Latite::getPluginManager();
+			if (plugins.hasListeners(L"receive-chat")) {
+				std::string_view type = "Unknown";
+				switch (pkt->type) {
+				case SDK::TextPacketType::RAW:
+					type = "raw";
+					break;
+				case SDK::TextPacketType::CHAT:
+					type = "chat";
+					break;
+				case SDK::TextPacketType::TRANSLATION:
+					type = "translation";
+					break;
+				case SDK::TextPacketType::JUKEBOX_POPUP:
+					type = "jukebox";
+					break;
+				case SDK::TextPacketType::TIP:
+					type = "tip";
+					break;
+				case SDK::TextPacketType::SYSTEM_MESSAGE:
+					type = "system_message";
+					break;
+				case SDK::TextPacketType::WHISPER:
+					type = "whisper";
+					break;
+				case SDK::TextPacketType::ANNOUNCEMENT:
+					type = "announcement";
+					break;
+				case SDK::TextPacketType::TEXT_OBJECT:
+					type = "text_object";
+					break;
+				case SDK::TextPacketType::OBJECT_WHISPER:
+					type = "object_whisper";
+					break;
+				}
+
+				// The strings are views over the packet, which outlives the dispatch.
+				// The value list is reused so a chat flood doesn't allocate per message.
+				static std::vector<PluginManager::Event::Value> values;
+				values.resize(5);
+				values[0].name = L"type";
+				values[0].val = type;
+				values[1].name = L"message";
+				values[1].val = pkt->str.view();
+				values[2].name = L"sender";
+				values[2].val = pkt->source.view();
+				values[3].name = L"xuid";
+				values[3].val = pkt->xboxUserId.view();
+				values[4].name = L"isChat";
+				values[4].val = (pkt->type == SDK::TextPacketType::CHAT || pkt->type == SDK::TextPacketType::RAW
+					|| pkt->type == SDK::TextPacketType::SYSTEM_MESSAGE || pkt->type == SDK::TextPacketType::WHISPER
+					|| pkt->type == SDK::TextPacketType::OBJECT_WHISPER || pkt->type == SDK::TextPacketType::ANNOUNCEMENT);
+
+				PluginManager::Event sEv{ L"receive-chat", std::move(values), true };
+				bool cancelled = plugins.dispatchEvent(sEv);
+				values = std::move(sEv.values);
+				if (cancelled) {
+					return;
+				}
 			}
 
 			ClientTextEvent ev{ pkt };
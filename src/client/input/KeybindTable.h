@@ -0,0 +1,155 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+
+// Keybinds are stored in a KeyValue as a virtual key in the low byte, with optional
+// modifier bits above it. Plain keys (< 0x100) keep their old meaning, so existing configs load as-is.
+namespace keybind {
+	enum Modifier : int {
+		None = 0,
+		Ctrl = 1 << 8,
+		Shift = 1 << 9,
+		Alt = 1 << 10,
+	};
+
+	inline constexpr int keyMask = 0xFF;
+	inline constexpr int modifierMask = Ctrl | Shift | Alt;
+
+	[[nodiscard]] constexpr int getKey(int bind) { return bind & keyMask; }
+	[[nodiscard]] constexpr int getModifiers(int bind) { return bind & modifierMask; }
+	[[nodiscard]] constexpr int makeChord(int key, int modifiers) { return (key & keyMask) | (modifiers & modifierMask); }
+
+	// The modifier a virtual key represents, if any (VK_SHIFT/VK_CONTROL/VK_MENU and their left/right variants)
+	[[nodiscard]] constexpr int modifierOf(int key) {
+		switch (key) {
+		case 0x10: case 0xA0: case 0xA1:
+			return Shift;
+		case 0x11: case 0xA2: case 0xA3:
+			return Ctrl;
+		case 0x12: case 0xA4: case 0xA5:
+			return Alt;
+		default:
+			return None;
+		}
+	}
+
+	// Builds a keybind from the keys pressed while one is being set. Without chords, it's the first key pressed.
+	// With chords, modifiers held when another key is pressed become part of its keybind, so a modifier is only
+	// bound on its own if it's released before any other key is pressed.
+	class Capture {
+	public:
+		void start(bool allowChords) {
+			chords = allowChords;
+			pendingModifier = 0;
+		}
+
+		// `heldModifiers` are the modifiers down as of this key. Returns the keybind once it's decided, or 0.
+		[[nodiscard]] int onKey(int key, bool down, int heldModifiers) {
+			key &= keyMask;
+			if (!chords) return down ? key : 0;
+
+			if (modifierOf(key) != None) {
+				// -1 once more than one modifier is involved, as releasing one then is most likely a change of mind
+				if (down) pendingModifier = (pendingModifier == 0 || pendingModifier == key) ? key : -1;
+				else if (key == pendingModifier) return key;
+				return 0;
+			}
+			return down ? makeChord(key, heldModifiers) : 0;
+		}
+	private:
+		bool chords = false;
+		int pendingModifier = 0;
+	};
+}
+
+// Maps a virtual key to the targets bound to it, so a key press only visits the bound targets.
+// It tracks its own key state from the keys fed to it, so it doesn't depend on the game
+// and can be driven with synthetic key sequences.
+template <typename T>
+class KeybindTable {
+public:
+	enum class Action {
+		Enable,
+		Disable,
+		Toggle,
+	};
+
+	struct Binding {
+		T target;
+		int modifiers;
+		bool holdToToggle;
+	};
+
+	KeybindTable() = default;
+
+	void clear() {
+		for (auto& list : table) list.clear();
+	}
+
+	// Binds a target to a keybind (key + modifier bits). A keybind of 0 is ignored.
+	void bind(int keybind, T target, bool holdToToggle = false) {
+		int key = keybind::getKey(keybind);
+		if (key == 0) return;
+		table[key].push_back(Binding{ target, keybind::getModifiers(keybind), holdToToggle });
+	}
+
+	[[nodiscard]] std::vector<Binding> const& getBindings(int key) const {
+		return table[key & keybind::keyMask];
+	}
+
+	// Modifiers currently held, according to the keys fed to this table
+	[[nodiscard]] int getHeldModifiers() const {
+		int mods = keybind::None;
+		for (int i = 0; i < static_cast<int>(keyState.size()); i++) {
+			if (keyState[i]) mods |= keybind::modifierOf(i);
+		}
+		return mods;
+	}
+
+	[[nodiscard]] bool isKeyDown(int key) const {
+		return keyState[key & keybind::keyMask];
+	}
+
+	// Call whenever key state changes, even if the bindings aren't going to be acted on, so modifier state stays correct.
+	void updateKeyState(int key, bool down) {
+		keyState[key & keybind::keyMask] = down;
+	}
+
+	// Updates key state and calls callback(target, action) for every binding the key triggers.
+	// Chords must match the held modifiers exactly; a plain binding on the same key only fires if no chord matched.
+	// Hold-to-toggle bindings are released on key up no matter which modifiers are held.
+	template <typename Callback>
+	void onKey(int key, bool down, Callback&& callback) {
+		key &= keybind::keyMask;
+		updateKeyState(key, down);
+
+		auto& list = table[key];
+		if (list.empty()) return;
+
+		if (!down) {
+			for (auto& binding : list) {
+				if (binding.holdToToggle) callback(binding.target, Action::Disable);
+			}
+			return;
+		}
+
+		int mods = getHeldModifiers() & ~keybind::modifierOf(key);
+
+		bool chordMatched = false;
+		for (auto& binding : list) {
+			if (binding.modifiers != keybind::None && binding.modifiers == mods) {
+				chordMatched = true;
+				break;
+			}
+		}
+
+		for (auto& binding : list) {
+			if (chordMatched ? binding.modifiers != mods : binding.modifiers != keybind::None) continue;
+			callback(binding.target, binding.holdToToggle ? Action::Enable : Action::Toggle);
+		}
+	}
+private:
+	std::array<std::vector<Binding>, 0x100> table = {};
+	std::array<bool, 0x100> keyState = {};
+};
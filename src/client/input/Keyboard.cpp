@@ -76,7 +76,7 @@ void Keyboard::findTextInput() {
 }
 
 bool Keyboard::isKeyDown(int vKey) {
-	return keyMap[vKey];
+	return keyMap[keybind::getKey(vKey)];
 }
 
 int Keyboard::getMappedKey(std::string const& name) {
@@ -1,6 +1,7 @@
 #pragma once
 #include "client/event/Eventing.h"
 #include "client/event/impl/KeyUpdateEvent.h"
+#include "KeybindTable.h"
 
 class Keyboard final : public Listener {
 public:
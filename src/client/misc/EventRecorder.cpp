@@ -0,0 +1,220 @@
+#include "pch.h"
+#include "EventRecorder.h"
+#include "client/event/Eventing.h"
+#include "client/event/impl/KeyUpdateEvent.h"
+#include "client/event/impl/ClickEvent.h"
+#include "client/event/impl/CharEvent.h"
+#include "client/event/impl/ChatMessageEvent.h"
+#include "client/event/impl/PacketReceiveEvent.h"
+#include "client/event/impl/SendPacketEvent.h"
+#include "client/event/impl/AttackEvent.h"
+#include "client/event/impl/TickEvent.h"
+#include "client/event/impl/ReplayEvents.h"
+#include "sdk/common/network/Packet.h"
+#include "sdk/common/network/packet/ActorEventPacket.h"
+
+EventRecorder::~EventRecorder() {
+	detach();
+}
+
+void EventRecorder::attach(IEventManager& manager) {
+	attachedTo = &manager;
+	manager.setObserver(this);
+}
+
+void EventRecorder::detach() {
+	if (attachedTo && attachedTo->getObserver() == this) {
+		attachedTo->setObserver(nullptr);
+	}
+	attachedTo = nullptr;
+}
+
+void EventRecorder::startRecording() {
+	std::lock_guard lock{ mutex };
+	writer.clear();
+	startTime = std::chrono::steady_clock::now();
+	recording.store(true, std::memory_order_release);
+	attach(Eventing::get());
+}
+
+std::optional<size_t> EventRecorder::stopRecording(std::filesystem::path const& path) {
+	std::lock_guard lock{ mutex };
+	if (!recording.load(std::memory_order_acquire)) return std::nullopt;
+	recording.store(false, std::memory_order_release);
+	detach();
+
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	if (!writer.save(path)) return std::nullopt;
+	return writer.recordCount();
+}
+
+void EventRecorder::onDispatch(uint32_t eventHash, Event& ev) {
+	if (!recording.load(std::memory_order_acquire)) return;
+
+	std::lock_guard lock{ mutex };
+	if (!recording.load(std::memory_order_relaxed)) return;
+
+	payload.clear();
+	trace::PayloadWriter out{ payload };
+	switch (eventHash) {
+	case KeyUpdateEvent::hash:
+	{
+		auto& kev = reinterpret_cast<KeyUpdateEvent&>(ev);
+		out.putVarint(static_cast<uint32_t>(kev.getKey()));
+		out.putU8(kev.isDown());
+		break;
+	}
+	case ClickEvent::hash:
+	{
+		auto& cev = reinterpret_cast<ClickEvent&>(ev);
+		out.putVarint(static_cast<uint32_t>(cev.getMouseButton()));
+		out.putSVarint(cev.getWheelDelta());
+		break;
+	}
+	case CharEvent::hash:
+	{
+		auto& cev = reinterpret_cast<CharEvent&>(ev);
+		out.putVarint(static_cast<uint32_t>(cev.getChar()));
+		out.putU8(cev.isChar());
+		break;
+	}
+	case ChatMessageEvent::hash:
+		out.putString(reinterpret_cast<ChatMessageEvent&>(ev).getMessage());
+		break;
+	case PacketReceiveEvent::hash:
+	{
+		auto pkt = reinterpret_cast<PacketReceiveEvent&>(ev).getPacket();
+		out.putU8(static_cast<uint8_t>(pkt->getID()));
+		if (pkt->getID() == SDK::PacketID::ACTOR_EVENT) {
+			auto actorEvent = static_cast<SDK::ActorEventPacket*>(pkt);
+			out.putSVarint(actorEvent->runtimeID);
+			out.putU8(static_cast<uint8_t>(actorEvent->eventID));
+		}
+		break;
+	}
+	case AttackEvent::hash:
+		out.putSVarint(reinterpret_cast<AttackEvent&>(ev).getActor()->getRuntimeID());
+		break;
+	case SendPacketEvent::hash:
+		out.putU8(static_cast<uint8_t>(reinterpret_cast<SendPacketEvent&>(ev).getPacket()->getID()));
+		break;
+	default:
+		// only the timestamp is recorded (ticks, render events etc.)
+		break;
+	}
+
+	auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	writer.add(static_cast<uint64_t>(now), eventHash, payload);
+}
+
+void EventRecorder::onListenerTime(uint32_t eventHash, Listener* listener, int64_t nanoseconds) {
+	std::lock_guard lock{ mutex };
+	auto& st = stats[{ listener, eventHash }];
+	st.listener = listener;
+	st.eventHash = eventHash;
+	st.calls++;
+	st.totalNanos += nanoseconds;
+	st.maxNanos = std::max(st.maxNanos, nanoseconds);
+}
+
+bool EventRecorder::dispatchRecord(trace::Record const& rec, IEventManager& dispatcher) {
+	trace::PayloadReader in{ rec.payload.data(), rec.payload.size() };
+	switch (rec.eventHash) {
+	case KeyUpdateEvent::hash:
+	{
+		int key = static_cast<int>(in.getVarint());
+		bool down = in.getU8();
+		if (!in.ok()) return false;
+		KeyUpdateEvent ev{ key, down };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case ClickEvent::hash:
+	{
+		int button = static_cast<int>(in.getVarint());
+		char dod = static_cast<char>(in.getSVarint());
+		if (!in.ok()) return false;
+		ClickEvent ev{ button, dod };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case CharEvent::hash:
+	{
+		wchar_t ch = static_cast<wchar_t>(in.getVarint());
+		bool isChar = in.getU8();
+		if (!in.ok()) return false;
+		CharEvent ev{ ch, isChar };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case ChatMessageEvent::hash:
+	{
+		auto msg = in.getString();
+		if (!in.ok()) return false;
+		ChatMessageEvent ev{ std::string(msg) };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case TickEvent::hash:
+	{
+		ReplayTickEvent ev{ rec.timeMicros };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case AttackEvent::hash:
+	{
+		int64_t runtimeId = in.getSVarint();
+		if (!in.ok()) return false;
+		ReplayAttackEvent ev{ rec.timeMicros, runtimeId };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	case PacketReceiveEvent::hash:
+	{
+		// only actor events are kept with enough detail to replay
+		auto id = static_cast<SDK::PacketID>(in.getU8());
+		if (!in.ok() || id != SDK::PacketID::ACTOR_EVENT) return false;
+		int64_t runtimeId = in.getSVarint();
+		uint8_t eventId = in.getU8();
+		if (!in.ok()) return false;
+		ReplayActorEvent ev{ rec.timeMicros, runtimeId, eventId };
+		dispatcher.dispatch(ev);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+std::optional<EventRecorder::ReplayResult> EventRecorder::replay(std::filesystem::path const& path, IEventManager& dispatcher) {
+	auto reader = trace::TraceReader::load(path);
+	if (!reader) return std::nullopt;
+
+	{
+		std::lock_guard lock{ mutex };
+		if (recording.load(std::memory_order_relaxed) || &dispatcher == &Eventing::get()) return std::nullopt;
+		stats.clear();
+		profiling.store(true, std::memory_order_release);
+	}
+	attach(dispatcher);
+
+	ReplayResult result{};
+	trace::Record rec;
+	while (reader->next(rec)) {
+		if (dispatchRecord(rec, dispatcher)) result.replayed++;
+		else result.skipped++;
+	}
+
+	detach();
+
+	std::lock_guard lock{ mutex };
+	profiling.store(false, std::memory_order_release);
+	for (auto& [_, st] : stats) {
+		result.listeners.push_back(st);
+	}
+	std::sort(result.listeners.begin(), result.listeners.end(), [](ListenerStats const& a, ListenerStats const& b) {
+		return a.totalNanos > b.totalNanos;
+		});
+	return result;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "api/eventing/EventManager.h"
+#include "client/event/EventTrace.h"
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+
+// Records dispatched events into a trace file, and replays traces into a dispatcher of their own while timing every
+// listener registered there (see ReplayProbes). Replays never go through the live client's listeners: replayed keys
+// and chat would eject, run commands again and toggle modules.
+// Events that carry game pointers are recorded with a summary payload. Ticks, attacks and actor event packets are
+// replayed as the stand-ins in ReplayEvents.h; the rest (render events, other packets) can't be replayed.
+class EventRecorder final : public IEventObserver {
+public:
+	struct ListenerStats {
+		Listener* listener = nullptr;
+		uint32_t eventHash = 0;
+		uint64_t calls = 0;
+		int64_t totalNanos = 0;
+		int64_t maxNanos = 0;
+	};
+
+	struct ReplayResult {
+		size_t replayed = 0;
+		size_t skipped = 0;
+		std::vector<ListenerStats> listeners;
+	};
+
+	EventRecorder() = default;
+	~EventRecorder();
+
+	void startRecording();
+	// Stops recording and saves the trace. Returns the number of records written, or nullopt if saving failed.
+	std::optional<size_t> stopRecording(std::filesystem::path const& path);
+	[[nodiscard]] bool isRecording() const { return recording.load(std::memory_order_acquire); }
+
+	// Replays the replayable events in a trace into `dispatcher`, which must not be the client's own.
+	// Returns nullopt if the trace can't be read, or `dispatcher` is the client's.
+	std::optional<ReplayResult> replay(std::filesystem::path const& path, IEventManager& dispatcher);
+
+	// IEventObserver
+	void onDispatch(uint32_t eventHash, Event& ev) override;
+	void onListenerTime(uint32_t eventHash, Listener* listener, int64_t nanoseconds) override;
+	bool wantsListenerTimes() override { return profiling.load(std::memory_order_acquire); }
+private:
+	void attach(IEventManager& manager);
+	void detach();
+	static bool dispatchRecord(trace::Record const& rec, IEventManager& dispatcher);
+
+	struct PairHash {
+		size_t operator()(std::pair<Listener*, uint32_t> const& p) const {
+			return std::hash<Listener*>{}(p.first) ^ (static_cast<size_t>(p.second) * 0x9E3779B97F4A7C15ull);
+		}
+	};
+
+	std::mutex mutex;
+	trace::TraceWriter writer;
+	std::vector<uint8_t> payload;
+	std::chrono::steady_clock::time_point startTime;
+	std::unordered_map<std::pair<Listener*, uint32_t>, ListenerStats, PairHash> stats;
+	// read on every dispatch, from whichever thread is dispatching
+	std::atomic<bool> recording = false;
+	std::atomic<bool> profiling = false;
+	IEventManager* attachedTo = nullptr;
+};
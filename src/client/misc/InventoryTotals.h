@@ -0,0 +1,151 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Running item totals for an inventory, updated only for the slots that changed since the last update.
+//
+// Each slot is compared by a cheap fingerprint (item hash, count and aux). Totals are kept per item hash, and per group:
+// a group is a predicate on item names ("contains potion", an exact id, a set of ids standing in for a tag...).
+// An item's name is only looked up and matched against the groups the first time its hash is seen.
+class InventoryTotals {
+public:
+	struct Slot {
+		// 0 if the slot is empty
+		int64_t item = 0;
+		int count = 0;
+		int aux = 0;
+
+		bool operator==(Slot const&) const = default;
+	};
+
+	// Where the slots come from: the game's inventory, or a fake one
+	class SlotProvider {
+	public:
+		virtual ~SlotProvider() = default;
+		[[nodiscard]] virtual size_t size() const = 0;
+		[[nodiscard]] virtual Slot getSlot(size_t slot) const = 0;
+		// The name of the item in a slot, only asked for items that haven't been seen before
+		[[nodiscard]] virtual std::string getName(size_t slot) const = 0;
+	};
+
+	using Predicate = std::function<bool(std::string_view name)>;
+
+	[[nodiscard]] static Predicate contains(std::string text) {
+		return [text = std::move(text)](std::string_view name) { return name.find(text) != std::string_view::npos; };
+	}
+
+	[[nodiscard]] static Predicate exactly(std::vector<std::string> names) {
+		return [names = std::move(names)](std::string_view name) {
+			for (auto& candidate : names) {
+				if (candidate == name) return true;
+			}
+			return false;
+		};
+	}
+
+	// Returns the group's id for getGroupCount. Items already seen are matched against it straight away.
+	size_t addGroup(Predicate predicate) {
+		size_t id = groups.size();
+		groups.push_back({ std::move(predicate), 0 });
+		for (auto& [hash, item] : items) {
+			if (groups[id].predicate(item.name)) {
+				item.groups.push_back(static_cast<uint32_t>(id));
+				groups[id].total += item.total;
+			}
+		}
+		version++;
+		return id;
+	}
+
+	// Brings the totals up to date with `provider` and returns how many slots changed
+	size_t update(SlotProvider const& provider) {
+		size_t count = provider.size();
+		size_t changed = 0;
+		if (slots.size() > count) {
+			for (size_t i = count; i < slots.size(); i++) {
+				if (slots[i].item) changed++;
+				remove(slots[i]);
+			}
+		}
+		slots.resize(count);
+
+		for (size_t i = 0; i < count; i++) {
+			auto slot = provider.getSlot(i);
+			if (slot.item == 0 || slot.count <= 0) slot = {};
+			if (slot == slots[i]) continue;
+
+			changed++;
+			remove(slots[i]);
+			slots[i] = slot;
+			if (slot.item) add(slot, provider, i);
+		}
+		if (changed) version++;
+		return changed;
+	}
+
+	// Forgets the slots (and so every total), but keeps the groups and the names of items seen before
+	void clear() {
+		bool hadItems = false;
+		for (auto& slot : slots) {
+			if (slot.item) hadItems = true;
+			remove(slot);
+		}
+		slots.clear();
+		if (hadItems) version++;
+	}
+
+	[[nodiscard]] int getCount(int64_t item) const {
+		auto it = items.find(item);
+		return it == items.end() ? 0 : it->second.total;
+	}
+
+	[[nodiscard]] int getGroupCount(size_t group) const {
+		return group < groups.size() ? groups[group].total : 0;
+	}
+
+	[[nodiscard]] size_t getSlotCount() const { return slots.size(); }
+	// Changes whenever a total might have, so readers can cache whatever they build from the totals
+	[[nodiscard]] uint64_t getVersion() const { return version; }
+private:
+	struct Item {
+		std::string name;
+		std::vector<uint32_t> groups;
+		int total = 0;
+	};
+
+	struct Group {
+		Predicate predicate;
+		int total = 0;
+	};
+
+	void add(Slot const& slot, SlotProvider const& provider, size_t index) {
+		auto it = items.find(slot.item);
+		if (it == items.end()) {
+			Item item{ provider.getName(index), {}, 0 };
+			for (size_t g = 0; g < groups.size(); g++) {
+				if (groups[g].predicate(item.name)) item.groups.push_back(static_cast<uint32_t>(g));
+			}
+			it = items.emplace(slot.item, std::move(item)).first;
+		}
+
+		it->second.total += slot.count;
+		for (auto g : it->second.groups) groups[g].total += slot.count;
+	}
+
+	void remove(Slot const& slot) {
+		if (!slot.item) return;
+		auto& item = items.at(slot.item);
+		item.total -= slot.count;
+		for (auto g : item.groups) groups[g].total -= slot.count;
+	}
+
+	std::vector<Slot> slots;
+	// every item seen so far, even once its total drops to 0
+	std::unordered_map<int64_t, Item> items;
+	std::vector<Group> groups;
+	uint64_t version = 0;
+};
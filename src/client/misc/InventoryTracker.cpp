@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "InventoryTracker.h"
+
+namespace {
+	class PlayerSlots : public InventoryTotals::SlotProvider {
+	public:
+		explicit PlayerSlots(SDK::Inventory* inv) : inv(inv) {}
+
+		size_t size() const override {
+			// hotbar and main inventory
+			return 36;
+		}
+
+		InventoryTotals::Slot getSlot(size_t slot) const override {
+			auto item = getItem(slot);
+			if (!item) return {};
+			auto stack = inv->getItem(static_cast<int>(slot));
+			return { item->id.hash, stack->itemCount, stack->aux };
+		}
+
+		std::string getName(size_t slot) const override {
+			auto item = getItem(slot);
+			return item ? item->id.getString() : "";
+		}
+	private:
+		SDK::Item* getItem(size_t slot) const {
+			auto stack = inv->getItem(static_cast<int>(slot));
+			if (!stack || !stack->item) return nullptr;
+			return *stack->item;
+		}
+
+		SDK::Inventory* inv;
+	};
+}
+
+InventoryTracker& InventoryTracker::get() {
+	static InventoryTracker tracker;
+	return tracker;
+}
+
+InventoryTotals const& InventoryTracker::refresh() {
+	auto lp = SDK::ClientInstance::get()->getLocalPlayer();
+	if (!lp || !lp->supplies || !lp->supplies->inventory) {
+		totals.clear();
+		return totals;
+	}
+
+	totals.update(PlayerSlots(lp->supplies->inventory));
+	return totals;
+}
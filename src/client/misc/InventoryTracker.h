@@ -0,0 +1,19 @@
+#pragma once
+#include "InventoryTotals.h"
+
+// Item totals for the local player's inventory, shared by the HUD modules that count items.
+// Readers call refresh() when they need the totals; it only re-reads slots, and only counts the ones that changed.
+class InventoryTracker final {
+public:
+	[[nodiscard]] static InventoryTracker& get();
+
+	// See InventoryTotals::addGroup
+	size_t addGroup(InventoryTotals::Predicate predicate) { return totals.addGroup(std::move(predicate)); }
+
+	// Catches up with the hotbar and main inventory. Everything is 0 when there's no local player.
+	InventoryTotals const& refresh();
+private:
+	InventoryTracker() = default;
+
+	InventoryTotals totals;
+};
@@ -0,0 +1,283 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "RollingStats.h"
+
+enum class JobPriority : uint8_t {
+	High,
+	Normal,
+	Low,
+};
+
+struct JobOptions {
+	JobPriority priority = JobPriority::Normal;
+	std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+	// anything that identifies who the job belongs to, for JobQueue::cancel(); 0 means nobody
+	uintptr_t owner = 0;
+};
+
+// Work handed to one thread (the client thread, the render thread) from any number of others, run a frame's budget
+// at a time so a burst of it is spread over several frames instead of landing in one.
+//
+// Producers push onto an intrusive MPSC queue (one atomic exchange, never a lock or a wait). At the start of each
+// run() the consumer sorts everything pushed so far into its own lanes, one per priority, and runs jobs in order of
+// priority, then deadline, then the order they arrived in, until the budget is spent. What's left carries over.
+// At least one job runs per frame, so a job that's longer than the budget can't stall the queue, and jobs that are
+// past their deadline keep running after the budget's gone (as long as they're at the top).
+// Jobs pushed while run() is running wait for the next one.
+//
+// Since a job can wait several frames, one that points at something that can go away (a script module, a texture
+// the script's finalizer deletes) is pushed with an owner, and the owner cancels its jobs before it's destroyed.
+template <typename... Args>
+class JobQueue {
+public:
+	using Clock = std::chrono::steady_clock;
+	using Job = std::function<void(Args...)>;
+	// Replaceable so the queue can be driven with a fake clock
+	using Now = Clock::time_point(*)();
+
+	static constexpr size_t window = 256;
+
+	struct Stats {
+		// everything pushed and not run yet, including what hasn't been picked up
+		size_t depth = 0;
+		// jobs run by the last run(), and how long it took
+		size_t ran = 0;
+		float runMs = 0.f;
+		uint64_t totalRan = 0;
+		// run() calls that stopped with jobs left over
+		uint64_t carriedFrames = 0;
+		// from push to starting to run, in milliseconds, over the last `window` jobs
+		float waitMean = 0.f;
+		float waitP95 = 0.f;
+		// how long each job took, in milliseconds, over the last `window` jobs
+		float costMean = 0.f;
+		float costP95 = 0.f;
+	};
+
+	explicit JobQueue(Now now = &Clock::now) : now(now) {}
+
+	JobQueue(JobQueue const&) = delete;
+	JobQueue& operator=(JobQueue const&) = delete;
+
+	// Jobs that never ran are dropped without being called
+	~JobQueue() {
+		while (auto node = pop()) delete node;
+	}
+
+	// Safe from any thread
+	void push(Job job, JobOptions options = {}) {
+		auto node = new Node{ {}, { std::move(job), options.priority, options.deadline.value_or(Clock::time_point::max()),
+			now(), 0, options.owner } };
+		depth.fetch_add(1, std::memory_order_relaxed);
+		link(node);
+	}
+
+	// Runs jobs until `budget` is used up or there are none left; consumer thread only
+	void run(Clock::duration budget, Args... args) {
+		std::lock_guard lock{ runMutex };
+		auto start = now();
+		takeInbox();
+
+		size_t ran = 0;
+		auto time = start;
+		while (auto lane = nextLane()) {
+			// without a deadline, a job goes after every one that has one
+			bool fromHeap = !lane->deadlines.empty();
+			auto deadline = fromHeap ? lane->deadlines.front().deadline : Clock::time_point::max();
+			if (ran > 0 && time - start >= budget && deadline > time) break;
+
+			Entry entry;
+			if (fromHeap) {
+				std::pop_heap(lane->deadlines.begin(), lane->deadlines.end(), Later{});
+				entry = std::move(lane->deadlines.back());
+				lane->deadlines.pop_back();
+			}
+			else {
+				entry = std::move(lane->fifo.front());
+				lane->fifo.pop_front();
+			}
+			depth.fetch_sub(1, std::memory_order_relaxed);
+
+			auto wait = toMs(time - entry.queued);
+			entry.job(args...);
+			auto end = now();
+			{
+				std::lock_guard statsLock{ statsMutex };
+				waits.add(wait);
+				costs.add(toMs(end - time));
+			}
+			time = end;
+			ran++;
+		}
+
+		std::lock_guard statsLock{ statsMutex };
+		lastRan = ran;
+		lastRun = time - start;
+		totalRan += ran;
+		if (nextLane()) carriedFrames++;
+	}
+
+	// Drops every job `owner` pushed that hasn't started. Safe from any thread: if run() is going on another thread
+	// this waits for it to finish (at most about a budget), so once it returns none of the owner's jobs is running or
+	// will run. From inside a job it doesn't wait, and the job that's running is the only one left.
+	// Don't call it from a job on a queue whose own jobs cancel on this one; the two would wait on each other.
+	void cancel(uintptr_t owner) {
+		if (!owner) return;
+		std::lock_guard lock{ runMutex };
+		takeInbox();
+		size_t dropped = 0;
+		for (auto& lane : lanes) {
+			auto ownedBy = [owner](Entry const& entry) { return entry.owner == owner; };
+			dropped += std::erase_if(lane.fifo, ownedBy);
+			auto before = lane.deadlines.size();
+			std::erase_if(lane.deadlines, ownedBy);
+			if (lane.deadlines.size() != before) {
+				std::make_heap(lane.deadlines.begin(), lane.deadlines.end(), Later{});
+				dropped += before - lane.deadlines.size();
+			}
+		}
+		depth.fetch_sub(dropped, std::memory_order_relaxed);
+	}
+
+	// Safe from any thread, but it's only a snapshot: producers may be pushing
+	[[nodiscard]] size_t size() const { return depth.load(std::memory_order_relaxed); }
+
+	// Safe from any thread; the timings are as of the last run() to finish
+	[[nodiscard]] Stats getStats() const {
+		std::lock_guard lock{ statsMutex };
+		Stats ret;
+		ret.depth = size();
+		ret.ran = lastRan;
+		ret.runMs = static_cast<float>(toMs(lastRun));
+		ret.totalRan = totalRan;
+		ret.carriedFrames = carriedFrames;
+		ret.waitMean = static_cast<float>(waits.mean());
+		ret.waitP95 = static_cast<float>(waits.percentile(0.95));
+		ret.costMean = static_cast<float>(costs.mean());
+		ret.costP95 = static_cast<float>(costs.percentile(0.95));
+		return ret;
+	}
+private:
+	struct Entry {
+		Job job;
+		JobPriority priority;
+		Clock::time_point deadline;
+		Clock::time_point queued;
+		uint64_t order;
+		uintptr_t owner;
+	};
+
+	struct Node {
+		std::atomic<Node*> next;
+		Entry entry;
+	};
+
+	// heap order: the job that should run first is the "largest"
+	struct Later {
+		bool operator()(Entry const& a, Entry const& b) const {
+			if (a.deadline != b.deadline) return a.deadline > b.deadline;
+			return a.order > b.order;
+		}
+	};
+
+	// Jobs without a deadline already arrive in order, so only the ones with one need a heap
+	struct Lane {
+		std::vector<Entry> deadlines;
+		std::deque<Entry> fifo;
+	};
+
+	static double toMs(Clock::duration duration) {
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	// Sorts everything pushed so far into the lanes; only with runMutex held
+	void takeInbox() {
+		while (auto node = pop()) {
+			node->entry.order = arrivals++;
+			auto& lane = lanes[static_cast<size_t>(node->entry.priority)];
+			if (node->entry.deadline == Clock::time_point::max()) {
+				lane.fifo.push_back(std::move(node->entry));
+			}
+			else {
+				lane.deadlines.push_back(std::move(node->entry));
+				std::push_heap(lane.deadlines.begin(), lane.deadlines.end(), Later{});
+			}
+			delete node;
+		}
+	}
+
+	Lane* nextLane() {
+		for (auto& lane : lanes) {
+			if (!lane.deadlines.empty() || !lane.fifo.empty()) return &lane;
+		}
+		return nullptr;
+	}
+
+	void link(Node* node) {
+		node->next.store(nullptr, std::memory_order_relaxed);
+		auto prev = head.exchange(node, std::memory_order_acq_rel);
+		// until this store, the consumer sees the queue end at `prev`
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	// Takes the oldest node, or null if there isn't one, or the one after it is still being linked in by its
+	// producer (it's picked up next time).
+	Node* pop() {
+		auto tail = this->tail;
+		auto next = tail->next.load(std::memory_order_acquire);
+		if (tail == &stub) {
+			if (!next) return nullptr;
+			this->tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next) {
+			this->tail = next;
+			return tail;
+		}
+		if (tail != head.load(std::memory_order_acquire)) return nullptr;
+
+		// tail is the last node; put the stub behind it so it can be taken without emptying the list
+		link(&stub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next) {
+			this->tail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+
+	Now now;
+
+	// Producers swap themselves into `head`; the consumer walks from `tail`. The stub keeps the list from ever
+	// being empty, so neither end is ever null.
+	Node stub{ nullptr, {} };
+	std::atomic<Node*> head = &stub;
+	Node* tail = &stub;
+	std::atomic<size_t> depth = 0;
+
+	// Held by run() the whole time and by cancel(). Recursive, since a job can cancel (its own owner's, or another
+	// owner's when it destroys something) while run() is holding it.
+	std::recursive_mutex runMutex;
+	// everything below is only touched with runMutex held
+	std::array<Lane, 3> lanes;
+	uint64_t arrivals = 0;
+
+	// also held while run() updates these, so getStats() can read them from anywhere
+	mutable std::mutex statsMutex;
+	RollingStats<window> waits{ 100.0 };
+	RollingStats<window> costs{ 20.0 };
+	size_t lastRan = 0;
+	Clock::duration lastRun{};
+	uint64_t totalRan = 0;
+	uint64_t carriedFrames = 0;
+};
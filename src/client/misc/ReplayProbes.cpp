@@ -0,0 +1,58 @@
+#include "pch.h"
+#include "ReplayProbes.h"
+#include "client/event/impl/ClickEvent.h"
+#include "client/event/impl/ReplayEvents.h"
+#include "sdk/common/network/packet/ActorEventPacket.h"
+
+namespace {
+	ComboTracker::Clock::time_point toTime(uint64_t timeMicros) {
+		return ComboTracker::Clock::time_point{ std::chrono::duration_cast<ComboTracker::Clock::duration>(std::chrono::microseconds(timeMicros)) };
+	}
+}
+
+ReplayProbes::ReplayProbes(IEventManager& harness) : harness(harness) {
+	harness.listen<ClickEvent>(&cps, (EventListenerFunc)&CPSProbe::onClick);
+	harness.listen<ReplayTickEvent>(&cps, (EventListenerFunc)&CPSProbe::onTick);
+	harness.listen<ClickEvent>(&keystrokes, (EventListenerFunc)&KeystrokesProbe::onClick);
+	harness.listen<ReplayAttackEvent>(&combo, (EventListenerFunc)&ComboProbe::onAttack);
+	harness.listen<ReplayActorEvent>(&combo, (EventListenerFunc)&ComboProbe::onActorEvent);
+	harness.listen<ReplayTickEvent>(&combo, (EventListenerFunc)&ComboProbe::onTick);
+}
+
+ReplayProbes::~ReplayProbes() {
+	harness.unlisten(&cps);
+	harness.unlisten(&keystrokes);
+	harness.unlisten(&combo);
+}
+
+void ReplayProbes::CPSProbe::onClick(Event& evG) {
+	auto& ev = reinterpret_cast<ClickEvent&>(evG);
+	timings.onClick(ev.getMouseButton(), ev.isDown());
+}
+
+void ReplayProbes::CPSProbe::onTick(Event&) {
+	timings.update();
+}
+
+void ReplayProbes::KeystrokesProbe::onClick(Event& evG) {
+	auto& ev = reinterpret_cast<ClickEvent&>(evG);
+	mouse.onClick(ev.getMouseButton(), ev.isDown());
+}
+
+void ReplayProbes::ComboProbe::onAttack(Event& evG) {
+	auto& ev = reinterpret_cast<ReplayAttackEvent&>(evG);
+	tracker.attack(static_cast<uint64_t>(ev.runtimeId), toTime(ev.timeMicros));
+}
+
+void ReplayProbes::ComboProbe::onActorEvent(Event& evG) {
+	auto& ev = reinterpret_cast<ReplayActorEvent&>(evG);
+	if (ev.eventId == static_cast<uint8_t>(SDK::ActorEventID::HURT_ANIMATION)) {
+		tracker.hurt(static_cast<uint64_t>(ev.runtimeId));
+	}
+}
+
+void ReplayProbes::ComboProbe::onTick(Event& evG) {
+	auto& ev = reinterpret_cast<ReplayTickEvent&>(evG);
+	// the trace doesn't have the player's invulnerability
+	tracker.tick(toTime(ev.timeMicros), false);
+}
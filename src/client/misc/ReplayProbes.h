@@ -0,0 +1,56 @@
+#pragma once
+#include "api/eventing/EventManager.h"
+#include "client/feature/module/impl/hud/ComboTracker.h"
+#include "client/feature/module/impl/hud/Keystrokes.h"
+#include "client/misc/Timings.h"
+#include <string_view>
+
+// A listener a replay can profile: it runs part of a module's logic against replayed events, on state of its own,
+// so a trace never changes what the live modules show.
+class ReplayProbe : public Listener {
+public:
+	[[nodiscard]] virtual std::string_view name() const = 0;
+};
+
+// The game-independent logic of the CPS counter, Keystrokes and ComboCounter, registered on a replay's dispatcher.
+class ReplayProbes {
+public:
+	explicit ReplayProbes(IEventManager& harness);
+	~ReplayProbes();
+
+	ReplayProbes(ReplayProbes const&) = delete;
+	ReplayProbes& operator=(ReplayProbes const&) = delete;
+private:
+	// Timings counts the clicks the CPS counter (and Keystrokes' CPS) shows
+	class CPSProbe final : public ReplayProbe {
+	public:
+		std::string_view name() const override { return "CPS"; }
+		void onClick(Event& ev);
+		void onTick(Event& ev);
+	private:
+		Timings timings;
+	};
+
+	class KeystrokesProbe final : public ReplayProbe {
+	public:
+		std::string_view name() const override { return "Keystrokes"; }
+		void onClick(Event& ev);
+	private:
+		Keystrokes::MouseState mouse;
+	};
+
+	class ComboProbe final : public ReplayProbe {
+	public:
+		std::string_view name() const override { return "ComboCounter"; }
+		void onAttack(Event& ev);
+		void onActorEvent(Event& ev);
+		void onTick(Event& ev);
+	private:
+		ComboTracker tracker;
+	};
+
+	IEventManager& harness;
+	CPSProbe cps;
+	KeystrokesProbe keystrokes;
+	ComboProbe combo;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// The mean and percentiles of the last `Window` samples, each updated in O(1) per sample.
+// Percentiles come from a histogram of `Buckets` equal buckets over [0, max), so they're only as exact as a bucket
+// is wide; anything past max counts towards the last bucket.
+template <size_t Window, size_t Buckets = 200>
+class RollingStats {
+public:
+	explicit RollingStats(double max) : bucketWidth(max / Buckets) {}
+
+	void add(double value) {
+		value = std::max(value, 0.0);
+		if (count == Window) {
+			double old = samples[next];
+			sum -= old;
+			histogram[bucket(old)]--;
+		}
+		else {
+			count++;
+		}
+		samples[next] = value;
+		sum += value;
+		histogram[bucket(value)]++;
+		next = (next + 1) % Window;
+
+		// adding and taking away rounds a little differently every time, so add it up again once in a while
+		if (next == 0) {
+			sum = 0.0;
+			for (size_t i = 0; i < count; i++) sum += samples[i];
+		}
+	}
+
+	[[nodiscard]] double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+	[[nodiscard]] double last() const { return count ? samples[(next + Window - 1) % Window] : 0.0; }
+	[[nodiscard]] size_t size() const { return count; }
+
+	// The upper edge of the bucket the p-th (0 to 1) percentile falls into. Walks the histogram, so read it when
+	// publishing, not per sample.
+	[[nodiscard]] double percentile(double p) const {
+		if (!count) return 0.0;
+		auto rank = static_cast<size_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count - 1)) + 1;
+		size_t seen = 0;
+		for (size_t i = 0; i < Buckets; i++) {
+			seen += histogram[i];
+			if (seen >= rank) return static_cast<double>(i + 1) * bucketWidth;
+		}
+		return static_cast<double>(Buckets) * bucketWidth;
+	}
+
+	void clear() {
+		count = next = 0;
+		sum = 0.0;
+		histogram.fill(0);
+	}
+private:
+	size_t bucket(double value) const {
+		return std::min(static_cast<size_t>(value / bucketWidth), Buckets - 1);
+	}
+
+	double bucketWidth;
+	std::array<double, Window> samples = {};
+	std::array<uint32_t, Buckets> histogram = {};
+	size_t count = 0;
+	size_t next = 0;
+	double sum = 0.0;
+};
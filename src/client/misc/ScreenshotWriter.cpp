@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "ScreenshotWriter.h"
+#include "client/Latite.h"
+#include "client/misc/ClientMessageQueue.h"
+#include <wincodec.h>
+
+ScreenshotWriter::ScreenshotWriter() : queue(max_queued, BoundedWorkQueue<Frame>::FullPolicy::DropNewest,
+	[this](Frame& frame) { write(frame); },
+	[this](Frame& frame) { recycle(std::move(frame.pixels)); },
+	[this]() { onExit(); }) {
+}
+
+std::optional<ScreenshotWriter::PixelOrder> ScreenshotWriter::getPixelOrder(DXGI_FORMAT format) {
+	switch (format) {
+	case DXGI_FORMAT_B8G8R8A8_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+		return PixelOrder::BGRA;
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		return PixelOrder::RGBA;
+	default:
+		return std::nullopt;
+	}
+}
+
+std::vector<uint8_t> ScreenshotWriter::acquireBuffer(size_t size) {
+	std::vector<uint8_t> buffer;
+	{
+		std::lock_guard lock{ poolMutex };
+		if (!pool.empty()) {
+			buffer = std::move(pool.back());
+			pool.pop_back();
+		}
+	}
+	buffer.resize(size);
+	return buffer;
+}
+
+void ScreenshotWriter::recycle(std::vector<uint8_t> buffer) {
+	std::lock_guard lock{ poolMutex };
+	if (pool.size() < max_queued + 1) {
+		pool.push_back(std::move(buffer));
+	}
+}
+
+bool ScreenshotWriter::submit(Frame frame) {
+	return queue.push(std::move(frame));
+}
+
+std::wstring ScreenshotWriter::getFileStem() {
+	auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+	std::tm tm{};
+	localtime_s(&tm, &now);
+
+	std::wstringstream wss;
+	wss << std::put_time(&tm, L"%Y-%m-%d_%H-%M-%S");
+	return wss.str();
+}
+
+void ScreenshotWriter::onExit() {
+	if (comInitialized) {
+		CoUninitialize();
+		comInitialized = false;
+	}
+}
+
+void ScreenshotWriter::write(Frame& frame) {
+	if (!comInitialized) {
+		comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+	}
+
+	auto fail = [&](std::string const& what) {
+		Logger::Warn("Could not save screenshot: {}", what);
+		Latite::getClientMessageQueue().push("Could not save screenshot!");
+		recycle(std::move(frame.pixels));
+	};
+
+	auto stem = getFileStem();
+	auto tempPath = frame.folder / (stem + L".png.tmp");
+
+	ComPtr<IWICImagingFactory> factory;
+	if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory)))) {
+		return fail("WIC is unavailable");
+	}
+
+	HRESULT hr;
+	{
+		uint32_t stride = frame.width * 4;
+		ComPtr<IWICBitmap> bitmap;
+		ComPtr<IWICStream> stream;
+		ComPtr<IWICBitmapEncoder> encoder;
+		ComPtr<IWICBitmapFrameEncode> frameEncode;
+		ComPtr<IPropertyBag2> options;
+		WICPixelFormatGUID format = frame.order == PixelOrder::RGBA ? GUID_WICPixelFormat32bppRGBA : GUID_WICPixelFormat32bppBGRA;
+
+		hr = factory->CreateBitmapFromMemory(frame.width, frame.height, format, stride,
+			static_cast<UINT>(frame.pixels.size()), frame.pixels.data(), &bitmap);
+		if (SUCCEEDED(hr)) hr = factory->CreateStream(&stream);
+		if (SUCCEEDED(hr)) hr = stream->InitializeFromFilename(tempPath.wstring().c_str(), GENERIC_WRITE);
+		if (SUCCEEDED(hr)) hr = factory->CreateEncoder(GUID_ContainerFormatPng, nullptr, &encoder);
+		if (SUCCEEDED(hr)) hr = encoder->Initialize(stream.Get(), WICBitmapEncoderNoCache);
+		if (SUCCEEDED(hr)) hr = encoder->CreateNewFrame(&frameEncode, &options);
+		if (SUCCEEDED(hr) && frame.fast) {
+			PROPBAG2 option{};
+			option.pstrName = const_cast<LPOLESTR>(L"FilterOption");
+			VARIANT value;
+			VariantInit(&value);
+			value.vt = VT_UI1;
+			value.bVal = WICPngFilterNone;
+			options->Write(1, &option, &value);
+		}
+		if (SUCCEEDED(hr)) hr = frameEncode->Initialize(options.Get());
+		if (SUCCEEDED(hr)) hr = frameEncode->SetSize(frame.width, frame.height);
+		if (SUCCEEDED(hr)) hr = frameEncode->SetPixelFormat(&format);
+		if (SUCCEEDED(hr)) hr = frameEncode->WriteSource(bitmap.Get(), nullptr);
+		if (SUCCEEDED(hr)) hr = frameEncode->Commit();
+		if (SUCCEEDED(hr)) hr = encoder->Commit();
+	}
+
+	// the file is closed by now
+	if (FAILED(hr)) {
+		std::error_code ec;
+		std::filesystem::remove(tempPath, ec);
+		return fail(std::format("HRESULT 0x{:X}", static_cast<uint32_t>(hr)));
+	}
+
+	// The rename doesn't replace existing files, so two screenshots in the same second never overwrite each other
+	for (int i = 1; i < 1000; i++) {
+		auto name = i == 1 ? stem + L".png" : std::format(L"{}_{}.png", stem, i);
+		auto path = frame.folder / name;
+		if (MoveFileExW(tempPath.wstring().c_str(), path.wstring().c_str(), MOVEFILE_WRITE_THROUGH)) {
+			Latite::getClientMessageQueue().push(std::format("Screenshot saved to {}", util::WStrToStr(path.wstring())));
+			recycle(std::move(frame.pixels));
+			return;
+		}
+
+		auto err = GetLastError();
+		if (err != ERROR_ALREADY_EXISTS && err != ERROR_FILE_EXISTS) break;
+	}
+
+	std::error_code ec;
+	std::filesystem::remove(tempPath, ec);
+	fail("could not name the file");
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "util/BoundedWorkQueue.h"
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include <mutex>
+
+// Saves captured frames as PNGs on a background thread.
+// Pixel buffers come from a small pool and go back to it after encoding, and only a couple of frames
+// can wait at once; when the writer is busy, new frames are dropped instead of piling up.
+class ScreenshotWriter final {
+public:
+	enum class PixelOrder {
+		RGBA,
+		BGRA,
+	};
+
+	struct Frame {
+		std::vector<uint8_t> pixels;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		PixelOrder order = PixelOrder::RGBA;
+		std::filesystem::path folder;
+		// skip PNG filtering: faster, but bigger files
+		bool fast = false;
+	};
+
+	ScreenshotWriter();
+	~ScreenshotWriter() = default;
+
+	// A buffer of at least `size` bytes, recycled from earlier screenshots when possible
+	[[nodiscard]] std::vector<uint8_t> acquireBuffer(size_t size);
+
+	// Queues a frame to be saved. Returns false if the writer is busy (or stopped) and the frame was dropped.
+	bool submit(Frame frame);
+
+	// Saves what's queued and stops the writing thread. Frames submitted afterwards are dropped.
+	void stop() { queue.stop(); }
+
+	// The byte order of a back buffer format, or nothing if it isn't 8 bits per channel RGBA/BGRA
+	[[nodiscard]] static std::optional<PixelOrder> getPixelOrder(DXGI_FORMAT format);
+
+	[[nodiscard]] auto getStats() { return queue.getStats(); }
+private:
+	static constexpr size_t max_queued = 2;
+
+	void recycle(std::vector<uint8_t> buffer);
+	void write(Frame& frame);
+	// on the writing thread, as it exits
+	void onExit();
+	static std::wstring getFileStem();
+
+	std::mutex poolMutex;
+	std::vector<std::vector<uint8_t>> pool;
+	bool comInitialized = false;
+	BoundedWorkQueue<Frame> queue;
+};
@@ -0,0 +1,261 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "RollingStats.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#include "util/Util.h"
+#else
+#include <fstream>
+#include <unistd.h>
+#endif
+
+// Collects system and client stats for debug overlays, so nothing on the render thread has to ask the OS.
+//
+// Facts that can't change (the CPU) are looked up once. Everything else is sampled on a background thread at a set
+// interval: memory is queried there, and the numbers the game and render threads own (FPS, render timings, ticks)
+// are handed over through atomics that are cheap to write every frame.
+// Each sample goes into rolling windows, and the results are published as a snapshot through a triple buffer,
+// so one reader can take the latest one at any time without locking or waiting for the collector.
+class SystemStats {
+public:
+	static constexpr size_t window = 64;
+
+	struct Timer {
+		// milliseconds
+		float last = 0.f;
+		float mean = 0.f;
+		float p95 = 0.f;
+
+		bool operator==(Timer const&) const = default;
+	};
+
+	struct Snapshot {
+		// bumped with every sample; 0 until the first one
+		uint64_t sequence = 0;
+		// bytes
+		uint64_t processMemory = 0;
+		uint64_t systemMemoryUsed = 0;
+		uint64_t systemMemoryTotal = 0;
+		int fps = 0;
+		// ticks per second, averaged over the window
+		float tickRate = 0.f;
+		Timer acquire;
+		Timer d2d;
+		Timer d3d;
+	};
+
+	struct Info {
+		std::string cpu;
+		unsigned cores = 0;
+	};
+
+	// What a sample asks the OS for. Replaceable so the collector can be driven without a real system.
+	struct Memory {
+		uint64_t process = 0;
+		uint64_t systemUsed = 0;
+		uint64_t systemTotal = 0;
+	};
+	using MemoryQuery = Memory(*)();
+
+	explicit SystemStats(MemoryQuery memoryQuery = &SystemStats::queryMemory) : memoryQuery(memoryQuery), info(queryInfo()) {}
+
+	SystemStats(SystemStats const&) = delete;
+	SystemStats& operator=(SystemStats const&) = delete;
+
+	~SystemStats() {
+		stop();
+	}
+
+	// Samples on a background thread every `interval` until stop(). Starting again only changes the interval.
+	void start(std::chrono::milliseconds interval) {
+		std::lock_guard lock{ threadMutex };
+		this->interval = interval;
+		if (worker.joinable()) {
+			wake.notify_one();
+			return;
+		}
+		stopping = false;
+		worker = std::thread([this] { run(); });
+	}
+
+	void stop() {
+		{
+			std::lock_guard lock{ threadMutex };
+			if (!worker.joinable()) return;
+			stopping = true;
+		}
+		wake.notify_one();
+		worker.join();
+		worker = {};
+	}
+
+	// Frame numbers, from the render thread (or whoever has them). The timers are in milliseconds.
+	void setFrame(int fps, float acquireMs, float d2dMs, float d3dMs) {
+		frameFps.store(fps, std::memory_order_relaxed);
+		frameAcquire.store(acquireMs, std::memory_order_relaxed);
+		frameD2D.store(d2dMs, std::memory_order_relaxed);
+		frameD3D.store(d3dMs, std::memory_order_relaxed);
+	}
+
+	// Call once per game tick
+	void countTick() {
+		ticks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	[[nodiscard]] Info const& getInfo() const { return info; }
+
+	// The latest published snapshot. Only one thread may read; the reference stays good until its next read().
+	[[nodiscard]] Snapshot const& read() {
+		if (middle.load(std::memory_order_relaxed) & fresh) {
+			front = middle.exchange(front, std::memory_order_acq_rel) & index;
+		}
+		return buffers[front];
+	}
+
+	// Takes one sample now, on the calling thread. The background thread does this itself; it's here for
+	// driving the collector by hand, and mustn't be called while it's running.
+	void sample(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+		auto memory = memoryQuery();
+
+		uint64_t tickCount = ticks.load(std::memory_order_relaxed);
+		if (lastSample) {
+			double seconds = std::chrono::duration<double>(now - *lastSample).count();
+			if (seconds > 0.0) tickRates.add(static_cast<double>(tickCount - lastTicks) / seconds);
+		}
+		lastSample = now;
+		lastTicks = tickCount;
+
+		acquire.add(frameAcquire.load(std::memory_order_relaxed));
+		d2d.add(frameD2D.load(std::memory_order_relaxed));
+		d3d.add(frameD3D.load(std::memory_order_relaxed));
+
+		auto& out = buffers[back];
+		out.sequence = ++sequence;
+		out.processMemory = memory.process;
+		out.systemMemoryUsed = memory.systemUsed;
+		out.systemMemoryTotal = memory.systemTotal;
+		out.fps = frameFps.load(std::memory_order_relaxed);
+		out.tickRate = static_cast<float>(tickRates.mean());
+		out.acquire = toTimer(acquire);
+		out.d2d = toTimer(d2d);
+		out.d3d = toTimer(d3d);
+		back = middle.exchange(back | fresh, std::memory_order_acq_rel) & index;
+	}
+
+	static Memory queryMemory() {
+		Memory ret;
+#ifdef _WIN32
+		MEMORYSTATUSEX status{};
+		status.dwLength = sizeof(status);
+		if (GlobalMemoryStatusEx(&status)) {
+			ret.systemTotal = status.ullTotalPhys;
+			ret.systemUsed = status.ullTotalPhys - status.ullAvailPhys;
+		}
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			ret.process = counters.WorkingSetSize;
+		}
+#else
+		auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+		std::ifstream statm("/proc/self/statm");
+		uint64_t size = 0, resident = 0;
+		if (statm >> size >> resident) ret.process = resident * page;
+
+		std::ifstream meminfo("/proc/meminfo");
+		std::string key;
+		uint64_t value = 0, available = 0;
+		std::string unit;
+		while (meminfo >> key >> value) {
+			std::getline(meminfo, unit);
+			// in kB
+			if (key == "MemTotal:") ret.systemTotal = value * 1024;
+			else if (key == "MemAvailable:") available = value * 1024;
+		}
+		if (ret.systemTotal >= available) ret.systemUsed = ret.systemTotal - available;
+#endif
+		return ret;
+	}
+
+	static Info queryInfo() {
+		Info ret;
+		ret.cores = std::thread::hardware_concurrency();
+#ifdef _WIN32
+		ret.cpu = util::GetProcessorInfo();
+#else
+		std::ifstream cpuinfo("/proc/cpuinfo");
+		std::string line;
+		while (std::getline(cpuinfo, line)) {
+			if (line.starts_with("model name")) {
+				auto colon = line.find(':');
+				if (colon != std::string::npos) ret.cpu = line.substr(colon + 1);
+				break;
+			}
+		}
+#endif
+		// the brand string is padded with spaces or nulls, depending on the CPU
+		constexpr std::string_view padding{ " \0", 2 };
+		auto first = ret.cpu.find_first_not_of(padding);
+		ret.cpu = first == std::string::npos ? std::string{} : ret.cpu.substr(first, ret.cpu.find_last_not_of(padding) - first + 1);
+		return ret;
+	}
+private:
+	static constexpr uint8_t index = 0b011;
+	static constexpr uint8_t fresh = 0b100;
+
+	static Timer toTimer(RollingStats<window>& stats) {
+		return { static_cast<float>(stats.last()), static_cast<float>(stats.mean()), static_cast<float>(stats.percentile(0.95)) };
+	}
+
+	void run() {
+		std::unique_lock lock{ threadMutex };
+		while (!stopping) {
+			lock.unlock();
+			sample();
+			lock.lock();
+			wake.wait_for(lock, interval, [this] { return stopping; });
+		}
+	}
+
+	MemoryQuery memoryQuery;
+	Info info;
+
+	std::atomic<int> frameFps = 0;
+	std::atomic<float> frameAcquire = 0.f;
+	std::atomic<float> frameD2D = 0.f;
+	std::atomic<float> frameD3D = 0.f;
+	std::atomic<uint64_t> ticks = 0;
+
+	// only touched by whoever's sampling
+	RollingStats<window> acquire{ 50.0 };
+	RollingStats<window> d2d{ 50.0 };
+	RollingStats<window> d3d{ 50.0 };
+	RollingStats<window> tickRates{ 100.0 };
+	std::optional<std::chrono::steady_clock::time_point> lastSample;
+	uint64_t lastTicks = 0;
+	uint64_t sequence = 0;
+
+	// The writer fills `back` and swaps it into `middle`, marking it fresh; the reader swaps a fresh middle for its
+	// `front`. Each buffer is only ever held by one side.
+	std::array<Snapshot, 3> buffers = {};
+	uint8_t back = 0;
+	std::atomic<uint8_t> middle = 1;
+	uint8_t front = 2;
+
+	std::mutex threadMutex;
+	std::condition_variable wake;
+	std::chrono::milliseconds interval{ 250 };
+	bool stopping = false;
+	std::thread worker;
+};
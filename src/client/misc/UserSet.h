@@ -0,0 +1,101 @@
+#pragma once
+#include "util/FastHash.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// A set of player names that's read every frame and replaced now and then, from any thread.
+//
+// The names live in an immutable snapshot. A writer builds a whole new one and swaps the pointer, so readers only hold
+// a lock for as long as it takes to copy a shared_ptr, and never see a set that's half updated.
+// Each swap that changes something bumps the version and calls the change listeners,
+// so readers can cache whatever they derive from the names until then.
+class UserSet {
+public:
+	class Snapshot {
+	public:
+		[[nodiscard]] bool contains(std::string_view name) const { return names.find(name) != names.end(); }
+		[[nodiscard]] size_t size() const { return names.size(); }
+		[[nodiscard]] uint64_t getVersion() const { return version; }
+
+		[[nodiscard]] auto begin() const { return names.begin(); }
+		[[nodiscard]] auto end() const { return names.end(); }
+	private:
+		friend class UserSet;
+
+		std::unordered_set<std::string, util::StringHash, std::equal_to<>> names;
+		uint64_t version = 0;
+	};
+
+	using ChangeListener = std::function<void(uint64_t version)>;
+
+	UserSet() : current(std::make_shared<Snapshot const>()) {}
+
+	UserSet(UserSet const&) = delete;
+	UserSet& operator=(UserSet const&) = delete;
+
+	// Hold on to the snapshot to look up a lot of names against one consistent set
+	[[nodiscard]] std::shared_ptr<Snapshot const> get() const {
+		std::lock_guard lock{ swapMutex };
+		return current;
+	}
+	[[nodiscard]] bool contains(std::string_view name) const { return get()->contains(name); }
+	// Doesn't lock, for checking whether a cache is still good. A snapshot got after this is at least this version.
+	[[nodiscard]] uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+
+	// Swaps in a new set of names. Returns false, and doesn't tell anyone, if they're the same as before.
+	// Listeners are called on the calling thread.
+	bool replace(std::vector<std::string> names) {
+		std::lock_guard lock{ writeMutex };
+		auto next = std::make_shared<Snapshot>();
+		next->names.reserve(names.size());
+		for (auto& name : names) next->names.insert(std::move(name));
+
+		// only writers change it, and they hold writeMutex
+		auto previous = current;
+		if (next->names == previous->names) return false;
+
+		uint64_t nextVersion = previous->version + 1;
+		next->version = nextVersion;
+		{
+			std::lock_guard swapLock{ swapMutex };
+			current = std::move(next);
+		}
+		version.store(nextVersion, std::memory_order_release);
+
+		std::vector<ChangeListener> toCall;
+		{
+			std::lock_guard listenerLock{ listenerMutex };
+			for (auto& [id, listener] : listeners) toCall.push_back(listener);
+		}
+		for (auto& listener : toCall) listener(nextVersion);
+		return true;
+	}
+
+	// Returns an id for removeListener. Listeners mustn't replace the set themselves.
+	size_t addListener(ChangeListener listener) {
+		std::lock_guard lock{ listenerMutex };
+		listeners.emplace_back(++lastListenerId, std::move(listener));
+		return lastListenerId;
+	}
+
+	void removeListener(size_t id) {
+		std::lock_guard lock{ listenerMutex };
+		std::erase_if(listeners, [id](auto const& pair) { return pair.first == id; });
+	}
+private:
+	mutable std::mutex swapMutex;
+	std::shared_ptr<Snapshot const> current;
+	std::atomic<uint64_t> version = 0;
+
+	std::mutex writeMutex;
+	std::mutex listenerMutex;
+	std::vector<std::pair<size_t, ChangeListener>> listeners;
+	size_t lastListenerId = 0;
+};
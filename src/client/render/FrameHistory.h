@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Creates and destroys the surfaces a FrameHistory stores frames in.
+template <typename Surface>
+class ISurfaceAllocator {
+public:
+	virtual ~ISurfaceAllocator() = default;
+
+	// Returns nullptr on failure
+	virtual Surface* create(uint32_t width, uint32_t height) = 0;
+	virtual void release(Surface* surface) = 0;
+};
+
+// A fixed number of preallocated surfaces that previous frames are copied into, reused oldest first.
+// All surfaces are created together at one size and released together when the size changes or on invalidate(),
+// so a frame never allocates once the history is set up.
+//
+// Surfaces handed out stay owned by the history: don't release them, and don't keep them past
+// the next push(), resize() or invalidate().
+template <typename Surface>
+class FrameHistory {
+public:
+	FrameHistory(ISurfaceAllocator<Surface>& allocator, size_t capacity) : allocator(allocator), capacity(capacity > 0 ? capacity : 1) {}
+	FrameHistory(FrameHistory&) = delete;
+	FrameHistory(FrameHistory&&) = delete;
+
+	~FrameHistory() {
+		invalidate();
+	}
+
+	// Makes sure every slot exists at this size. Returns false (with no slots) if allocation failed.
+	bool resize(uint32_t newWidth, uint32_t newHeight) {
+		if (!slots.empty() && newWidth == width && newHeight == height) return true;
+
+		invalidate();
+		width = newWidth;
+		height = newHeight;
+		slots.reserve(capacity);
+		for (size_t i = 0; i < capacity; i++) {
+			auto surface = allocator.create(width, height);
+			if (!surface) {
+				invalidate();
+				return false;
+			}
+			slots.push_back(surface);
+		}
+		return true;
+	}
+
+	// Releases every surface; call when the device or swapchain goes away.
+	void invalidate() {
+		for (auto surface : slots) {
+			allocator.release(surface);
+		}
+		slots.clear();
+		count = 0;
+		newest = 0;
+	}
+
+	// Forgets the stored frames but keeps the surfaces.
+	void clearFrames() {
+		count = 0;
+	}
+
+	// Returns the surface to write the next frame into, which becomes frame 0. Once full, this is the oldest frame's surface.
+	// Returns nullptr if the history hasn't been sized.
+	[[nodiscard]] Surface* push() {
+		if (slots.empty()) return nullptr;
+		newest = (newest + 1) % slots.size();
+		if (count < slots.size()) count++;
+		return slots[newest];
+	}
+
+	// The frame pushed `age` frames ago (0 is the latest), or nullptr if there isn't one.
+	[[nodiscard]] Surface* getFrame(size_t age) const {
+		if (age >= count) return nullptr;
+		return slots[(newest + slots.size() - age) % slots.size()];
+	}
+
+	[[nodiscard]] size_t size() const { return count; }
+	[[nodiscard]] size_t getCapacity() const { return capacity; }
+	[[nodiscard]] bool isAllocated() const { return !slots.empty(); }
+private:
+	ISurfaceAllocator<Surface>& allocator;
+	size_t capacity;
+	std::vector<Surface*> slots;
+	size_t newest = 0;
+	size_t count = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
@@ -258,7 +258,7 @@ void Renderer::releaseAllResources(bool indep) {
 			d3dCtx->OMSetRenderTargets(1, nullViews, nullptr);
 	}
 
-	cachedLayouts.clear();
+	layoutCache.clear();
 	gameDevice11 = nullptr;
 
 	for (auto& i : renderTargets) {
@@ -296,6 +296,9 @@ void Renderer::releaseAllResources(bool indep) {
 	d3d11On12Device = nullptr;
 	d3dCtx = nullptr;
 
+	frameHistory.invalidate();
+	regionBitmap.invalidate();
+
 	for (auto& mb : this->blurBuffers) {
 		SafeRelease(&mb);
 	}
@@ -305,6 +308,43 @@ void Renderer::releaseAllResources(bool indep) {
 	if (indep) releaseDeviceIndependentResources();
 }
 
+ID2D1Bitmap1* Renderer::BitmapAllocator::create(uint32_t width, uint32_t height) {
+	if (!renderer.d2dCtx || renderer.renderTargets.empty()) return nullptr;
+
+	ID2D1Bitmap1* bitmap = nullptr;
+	auto pixelFormat = renderer.renderTargets[0]->GetPixelFormat();
+	if (FAILED(renderer.d2dCtx->CreateBitmap(D2D1::SizeU(width, height), nullptr, 0, D2D1::BitmapProperties1(D2D1_BITMAP_OPTIONS_TARGET, pixelFormat), &bitmap))) {
+		return nullptr;
+	}
+	return bitmap;
+}
+
+void Renderer::BitmapAllocator::release(ID2D1Bitmap1* bitmap) {
+	SafeRelease(&bitmap);
+}
+
+ID2D1Bitmap1* Renderer::captureFrame() {
+	auto source = getBitmap();
+	auto size = source->GetPixelSize();
+	if (!frameHistory.resize(size.width, size.height)) return nullptr;
+
+	auto bitmap = frameHistory.push();
+	bitmap->CopyFromBitmap(nullptr, source, nullptr);
+	return bitmap;
+}
+
+ID2D1Bitmap1* Renderer::copyRegion(d2d::Rect const& rc) {
+	auto source = getBitmap();
+	auto size = source->GetPixelSize();
+	if (!regionBitmap.resize(size.width, size.height)) return nullptr;
+
+	auto bitmap = regionBitmap.push();
+	auto pt = D2D1::Point2U((UINT32)rc.left, (UINT32)rc.top);
+	auto urc = D2D1::RectU((UINT32)rc.left, (UINT32)rc.top, (UINT32)rc.right, (UINT32)rc.bottom);
+	bitmap->CopyFromBitmap(&pt, source, &urc);
+	return bitmap;
+}
+
 void Renderer::createTextFormats() {
 	float fontSize = 10.f;
 
@@ -362,9 +402,12 @@ void Renderer::createTextFormats() {
 		L"en-us",
 		this->secondaryLight.GetAddressOf()));
 
+	fontGeneration.fetch_add(1, std::memory_order_release);
 }
 
 void Renderer::releaseTextFormats() {
+	// cached layouts are keyed by format pointer, which can be reused by new formats
+	layoutCache.clear();
 	primaryFont = nullptr;
 	primaryLight = nullptr;
 	primarySemilight = nullptr;
@@ -407,18 +450,25 @@ void Renderer::releaseDeviceResources() {
 	blurEffect = nullptr;
 }
 
-IDWriteTextLayout* Renderer::getLayout(IDWriteTextFormat* fmt, std::wstring const& str, bool cache) {
-	auto hash = util::fnv1a_64w(str);
-	auto it = this->cachedLayouts.find(hash);
-	if (it != cachedLayouts.end()) {
-		if (it->second.first == fmt) {
-			return it->second.second.Get();
-		}
+ComPtr<IDWriteTextLayout> Renderer::getLayout(IDWriteTextFormat* fmt, std::wstring const& str, float size, float maxWidth, float maxHeight,
+	DWRITE_TEXT_ALIGNMENT alignment, DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment) {
+	TextLayoutKeyView key{ str, fmt, size, maxWidth, maxHeight, alignment, paragraphAlignment };
+	if (auto layout = layoutCache.get(key)) {
+		return *layout;
 	}
 
-	auto [width, height] = getScreenSize();
 	ComPtr<IDWriteTextLayout> layout;
-	dWriteFactory->CreateTextLayout(str.c_str(), static_cast<uint32_t>(str.size()), fmt, width, height, layout.GetAddressOf());
-	this->cachedLayouts[hash] = { fmt, layout };
-	return layout.Get(); // Im pretty sure it implicitly adds a ref when I add it to cachedLayouts
+	if (FAILED(dWriteFactory->CreateTextLayout(str.c_str(), static_cast<uint32_t>(str.size()), fmt, maxWidth, maxHeight, layout.GetAddressOf()))) {
+		return nullptr;
+	}
+
+	DWRITE_TEXT_RANGE range{};
+	range.startPosition = 0;
+	range.length = static_cast<UINT32>(str.size());
+	layout->SetFontSize(size, range);
+	layout->SetTextAlignment(alignment);
+	layout->SetParagraphAlignment(paragraphAlignment);
+
+	layoutCache.put(TextLayoutKey(key), layout);
+	return layout;
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include "util/DXUtil.h"
+#include "util/LRUCache.h"
+#include "TextLayoutKey.h"
+#include "FrameHistory.h"
 #include <vector>
 #include <shared_mutex>
+#include <atomic>
 
 class Renderer final {
 public:
@@ -28,6 +32,8 @@ private:
 
 	std::wstring fontFamily = L"Segoe UI";
 	std::wstring fontFamily2 = L"Segoe UI";
+	// bumped whenever the text formats are recreated, so anything measured with the old ones knows to measure again
+	std::atomic<uint32_t> fontGeneration = 0;
 	void releaseAllResources(bool indep = true);
 
 	void createTextFormats();
@@ -78,7 +84,25 @@ private:
 
 	std::vector<ID2D1Bitmap1*> blurBuffers = {};
 
-	std::unordered_map<int64_t, std::pair<IDWriteTextFormat*, ComPtr<IDWriteTextLayout>>> cachedLayouts;
+	// Creates bitmaps matching the back buffers
+	class BitmapAllocator final : public ISurfaceAllocator<ID2D1Bitmap1> {
+	public:
+		explicit BitmapAllocator(Renderer& renderer) : renderer(renderer) {}
+
+		ID2D1Bitmap1* create(uint32_t width, uint32_t height) override;
+		void release(ID2D1Bitmap1* bitmap) override;
+	private:
+		Renderer& renderer;
+	};
+
+	static constexpr size_t frame_history_size = 2;
+	BitmapAllocator bitmapAllocator{ *this };
+	FrameHistory<ID2D1Bitmap1> frameHistory{ bitmapAllocator, frame_history_size };
+	// a single reusable bitmap for region copies
+	FrameHistory<ID2D1Bitmap1> regionBitmap{ bitmapAllocator, 1 };
+
+	static constexpr size_t max_cached_layouts = 512;
+	LRUCache<TextLayoutKey, ComPtr<IDWriteTextLayout>, TextLayoutKeyHash, TextLayoutKeyEqual> layoutCache{ max_cached_layouts };
 
 	std::shared_mutex mutex;
 	int bufferCount = 3;
@@ -127,7 +151,11 @@ public:
 	}
 
 	void clearTextCache() {
-		this->cachedLayouts.clear();
+		this->layoutCache.clear();
+	}
+
+	[[nodiscard]] auto getLayoutCacheStats() {
+		return layoutCache.getStats();
 	}
 
 	[[nodiscard]] std::wstring getFontFamily() {
@@ -138,6 +166,10 @@ public:
 		this->fontFamily = ws;
 	}
 
+	[[nodiscard]] uint32_t getFontGeneration() const {
+		return fontGeneration.load(std::memory_order_acquire);
+	}
+
 	[[nodiscard]] std::wstring getFontFamily2() {
 		return this->fontFamily2;
 	}
@@ -207,6 +239,24 @@ public:
 		return newBitmap;
 	}
 
+	// Copies the back buffer into the frame history and returns the copy, which becomes frame 0.
+	// The history's bitmaps are preallocated and reused; don't release them. Returns nullptr on failure.
+	[[nodiscard]] ID2D1Bitmap1* captureFrame();
+
+	// A frame previously captured with captureFrame (0 is the latest), or nullptr if there isn't one
+	[[nodiscard]] ID2D1Bitmap1* getHistoryFrame(size_t age) {
+		return frameHistory.getFrame(age);
+	}
+
+	// Frees the frame history's bitmaps until the next capture, for when nothing needs it anymore
+	void releaseFrameHistory() {
+		frameHistory.invalidate();
+	}
+
+	// Copies a region of the back buffer into a shared bitmap, at the same position. The bitmap is reused
+	// by the next call, so draw it before copying another region, and don't release it.
+	[[nodiscard]] ID2D1Bitmap1* copyRegion(d2d::Rect const& rc);
+
 	[[nodiscard]] ID2D1Bitmap1* copyCurrentBitmap() {
 		auto idx = swapChain4->GetCurrentBackBufferIndex();
 		ID2D1Bitmap1* myBitmap = this->renderTargets[idx];
@@ -282,5 +332,8 @@ public:
 		return this->wicFactory.Get();
 	}
 
-	[[nodiscard]] IDWriteTextLayout* getLayout(IDWriteTextFormat* fmt, std::wstring const& str, bool cache = false);
+	// Returns a layout with the size, bounds and alignment already applied. Layouts are shared through
+	// a bounded LRU cache, so callers must not modify them.
+	[[nodiscard]] ComPtr<IDWriteTextLayout> getLayout(IDWriteTextFormat* fmt, std::wstring const& str, float size, float maxWidth, float maxHeight,
+		DWRITE_TEXT_ALIGNMENT alignment = DWRITE_TEXT_ALIGNMENT_LEADING, DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment = DWRITE_PARAGRAPH_ALIGNMENT_NEAR);
 };
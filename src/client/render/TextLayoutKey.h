@@ -0,0 +1,68 @@
+#pragma once
+#include "util/FastHash.h"
+#include <dwrite.h>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Everything a text layout depends on. Layouts are created with these applied and never modified afterwards.
+struct TextLayoutKeyView {
+	std::wstring_view text;
+	IDWriteTextFormat* format = nullptr;
+	float size = 0.f;
+	float maxWidth = 0.f;
+	float maxHeight = 0.f;
+	DWRITE_TEXT_ALIGNMENT alignment = DWRITE_TEXT_ALIGNMENT_LEADING;
+	DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment = DWRITE_PARAGRAPH_ALIGNMENT_NEAR;
+
+	// Floats are compared by their bits, like they're hashed: -0 and 0 are different keys, and NaN still finds itself
+	bool operator==(TextLayoutKeyView const& other) const {
+		return text == other.text && format == other.format && std::bit_cast<uint32_t>(size) == std::bit_cast<uint32_t>(other.size)
+			&& std::bit_cast<uint32_t>(maxWidth) == std::bit_cast<uint32_t>(other.maxWidth)
+			&& std::bit_cast<uint32_t>(maxHeight) == std::bit_cast<uint32_t>(other.maxHeight)
+			&& alignment == other.alignment && paragraphAlignment == other.paragraphAlignment;
+	}
+};
+
+struct TextLayoutKey {
+	std::wstring text;
+	IDWriteTextFormat* format;
+	float size;
+	float maxWidth;
+	float maxHeight;
+	DWRITE_TEXT_ALIGNMENT alignment;
+	DWRITE_PARAGRAPH_ALIGNMENT paragraphAlignment;
+
+	explicit TextLayoutKey(TextLayoutKeyView const& view) : text(view.text), format(view.format), size(view.size), maxWidth(view.maxWidth),
+		maxHeight(view.maxHeight), alignment(view.alignment), paragraphAlignment(view.paragraphAlignment) {}
+
+	[[nodiscard]] TextLayoutKeyView view() const {
+		return { text, format, size, maxWidth, maxHeight, alignment, paragraphAlignment };
+	}
+};
+
+struct TextLayoutKeyHash {
+	using is_transparent = void;
+
+	size_t operator()(TextLayoutKey const& key) const { return (*this)(key.view()); }
+	size_t operator()(TextLayoutKeyView const& key) const {
+		// the fixed-size fields seed the hash of the text, so it's one pass over the string
+		uint64_t fields[3] = {
+			reinterpret_cast<uintptr_t>(key.format),
+			std::bit_cast<uint32_t>(key.size) | (static_cast<uint64_t>(std::bit_cast<uint32_t>(key.maxWidth)) << 32),
+			std::bit_cast<uint32_t>(key.maxHeight) | (static_cast<uint64_t>(key.alignment) << 32) | (static_cast<uint64_t>(key.paragraphAlignment) << 48),
+		};
+		return static_cast<size_t>(util::fastHash(key.text, util::fastHash(fields, sizeof(fields))));
+	}
+};
+
+struct TextLayoutKeyEqual {
+	using is_transparent = void;
+
+	template <typename A, typename B>
+	bool operator()(A const& left, B const& right) const { return toView(left) == toView(right); }
+private:
+	static TextLayoutKeyView toView(TextLayoutKeyView const& key) { return key; }
+	static TextLayoutKeyView toView(TextLayoutKey const& key) { return key.view(); }
+};
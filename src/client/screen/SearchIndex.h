@@ -0,0 +1,264 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cwctype>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Ranked search over a catalogue of entries, each with a name, keywords (like setting names) and a description.
+// Text is case-folded and split into words once when an entry is added, so searching only compares.
+// Build it whenever the catalogue changes; search() is meant to be called again every time the query is typed into.
+//
+// Every space separated term of the query has to match somewhere in an entry. Better matches rank higher:
+// exact > prefix > start of a word > anywhere > initials of the name's words > a word with a typo or two,
+// and matching the name counts for more than the keywords, which count for more than the description.
+// Results are sorted by score, then by the order the entries were added in.
+class SearchIndex {
+public:
+	struct Result {
+		uint32_t id;
+		int score;
+	};
+
+	void clear() {
+		entries.clear();
+		history.clear();
+	}
+
+	// Returns the entry's id, which is the number of entries added before it
+	uint32_t add(std::wstring_view name, std::span<std::wstring const> keywords = {}, std::wstring_view description = {}) {
+		Entry entry;
+		entry.name = makeField(name);
+		std::wstring joined;
+		for (auto& keyword : keywords) {
+			if (!joined.empty()) joined.push_back(L'\n');
+			joined += keyword;
+		}
+		entry.keywords = makeField(joined);
+		entry.description = makeField(description);
+		entries.push_back(std::move(entry));
+		history.clear();
+		return static_cast<uint32_t>(entries.size() - 1);
+	}
+
+	// A blank query matches everything, in order. The returned results are valid until the next call.
+	//
+	// If the query only adds to the last one (typing another character), only the last results are searched again.
+	// Previous queries are kept as a stack, so deleting characters goes back to results that were already found.
+	[[nodiscard]] std::span<Result const> search(std::wstring_view query) {
+		std::wstring folded;
+		folded.reserve(query.size());
+		for (auto ch : query) folded.push_back(fold(ch));
+		auto terms = split(folded);
+
+		while (!history.empty() && !narrows(history.back(), folded, terms)) history.pop_back();
+		if (!history.empty() && history.back().query == folded) return history.back().results;
+
+		Step step{ folded, {} };
+		auto check = [&](uint32_t id) {
+			int total = 0;
+			for (auto term : terms) {
+				int score = match(entries[id], term);
+				if (score == 0) return;
+				total += score;
+			}
+			step.results.push_back({ id, total });
+		};
+
+		if (history.empty()) {
+			for (uint32_t id = 0; id < entries.size(); id++) check(id);
+		}
+		else {
+			for (auto& result : history.back().results) check(result.id);
+		}
+		std::sort(step.results.begin(), step.results.end(), [](Result const& a, Result const& b) {
+			return a.score != b.score ? a.score > b.score : a.id < b.id;
+			});
+
+		if (history.size() >= maxHistory) history.erase(history.begin());
+		history.push_back(std::move(step));
+		return history.back().results;
+	}
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+private:
+	static constexpr size_t maxHistory = 64;
+
+	struct Field {
+		// case-folded
+		std::wstring text;
+		// [start, end) of each run of letters and digits, also split where camelCase changes case
+		std::vector<std::pair<uint32_t, uint32_t>> words;
+	};
+
+	struct Entry {
+		Field name;
+		// newline separated, so none of them run into each other
+		Field keywords;
+		Field description;
+	};
+
+	struct Step {
+		std::wstring query;
+		std::vector<Result> results;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<Step> history;
+	// rows for the edit distance, kept around so searching doesn't allocate for every word
+	std::vector<int> rows[3];
+
+	static wchar_t fold(wchar_t ch) {
+		if (ch < 0x80) return (ch >= L'A' && ch <= L'Z') ? static_cast<wchar_t>(ch - L'A' + L'a') : ch;
+		return static_cast<wchar_t>(std::towlower(static_cast<wint_t>(ch)));
+	}
+
+	static bool isWordChar(wchar_t ch) {
+		if (ch < 0x80) return (ch >= L'a' && ch <= L'z') || (ch >= L'A' && ch <= L'Z') || (ch >= L'0' && ch <= L'9');
+		return std::iswalnum(static_cast<wint_t>(ch)) != 0;
+	}
+
+	static bool isUpper(wchar_t ch) {
+		return ch < 0x80 ? (ch >= L'A' && ch <= L'Z') : std::iswupper(static_cast<wint_t>(ch)) != 0;
+	}
+
+	static Field makeField(std::wstring_view text) {
+		Field field;
+		field.text.reserve(text.size());
+		bool inWord = false;
+		for (size_t i = 0; i < text.size(); i++) {
+			wchar_t ch = text[i];
+			field.text.push_back(fold(ch));
+			bool word = isWordChar(ch);
+			bool camel = inWord && word && isUpper(ch) && !isUpper(text[i - 1]);
+			if (inWord && (!word || camel)) field.words.back().second = static_cast<uint32_t>(i);
+			if (word && (!inWord || camel)) field.words.push_back({ static_cast<uint32_t>(i), static_cast<uint32_t>(text.size()) });
+			inWord = word;
+		}
+		return field;
+	}
+
+	static std::vector<std::wstring_view> split(std::wstring_view query) {
+		std::vector<std::wstring_view> terms;
+		size_t i = 0;
+		while (i < query.size()) {
+			while (i < query.size() && std::iswspace(static_cast<wint_t>(query[i]))) i++;
+			size_t start = i;
+			while (i < query.size() && !std::iswspace(static_cast<wint_t>(query[i]))) i++;
+			if (i > start) terms.push_back(query.substr(start, i - start));
+		}
+		return terms;
+	}
+
+	// How many typos a term can have and still match
+	static int tolerance(std::wstring_view term) {
+		return term.size() < 4 ? 0 : term.size() < 8 ? 1 : 2;
+	}
+
+	// Whether everything `query` matches is in `step`'s results. Terms only get stricter as they get longer,
+	// except when a longer term is allowed more typos.
+	static bool narrows(Step const& step, std::wstring_view query, std::vector<std::wstring_view> const& terms) {
+		if (!query.starts_with(step.query)) return false;
+		auto previous = split(step.query);
+		if (previous.empty()) return true;
+		auto last = previous.size() - 1;
+		return last < terms.size() && tolerance(previous[last]) == tolerance(terms[last]);
+	}
+
+	static bool startsWith(Field const& field, size_t pos, std::wstring_view term) {
+		return field.text.size() - pos >= term.size() && std::wstring_view(field.text).substr(pos, term.size()) == term;
+	}
+
+	static bool atWordStart(Field const& field, std::wstring_view term) {
+		for (auto& [start, end] : field.words) {
+			if (startsWith(field, start, term)) return true;
+		}
+		return false;
+	}
+
+	// Matches the term's characters in order, each one either right after the last or at the start of a later word
+	// (so "tss" finds "ToggleSprintSneak"). Returns the fewest words it has to jump between, or -1 if it doesn't match.
+	static int wordJumps(Field const& field, std::wstring_view term, size_t termPos, size_t pos) {
+		if (termPos == term.size()) return 0;
+		auto& text = field.text;
+		int best = -1;
+		if (pos + 1 < text.size() && text[pos + 1] == term[termPos]) {
+			best = wordJumps(field, term, termPos + 1, pos + 1);
+			if (best == 0) return 0;
+		}
+		for (auto& [start, end] : field.words) {
+			if (start <= pos || text[start] != term[termPos]) continue;
+			int jumps = wordJumps(field, term, termPos + 1, start);
+			if (jumps >= 0 && (best < 0 || jumps + 1 < best)) best = jumps + 1;
+		}
+		return best;
+	}
+
+	static int wordJumps(Field const& field, std::wstring_view term) {
+		int best = -1;
+		for (auto& [start, end] : field.words) {
+			if (field.text[start] != term[0]) continue;
+			int jumps = wordJumps(field, term, 1, start);
+			if (jumps >= 0 && (best < 0 || jumps < best)) best = jumps;
+		}
+		return best;
+	}
+
+	// Fewest edits (including swapping two neighbours) turning the term into the start of a word,
+	// or more than `limit` if there are too many
+	int typos(std::wstring_view term, std::wstring_view word, int limit) {
+		size_t n = word.size();
+		for (auto& row : rows) row.assign(n + 1, 0);
+		auto* before = &rows[0];
+		auto* prev = &rows[1];
+		auto* cur = &rows[2];
+		for (size_t j = 0; j <= n; j++) (*prev)[j] = static_cast<int>(j);
+
+		for (size_t i = 1; i <= term.size(); i++) {
+			(*cur)[0] = static_cast<int>(i);
+			int rowMin = (*cur)[0];
+			for (size_t j = 1; j <= n; j++) {
+				int cost = term[i - 1] == word[j - 1] ? 0 : 1;
+				int value = std::min({ (*prev)[j] + 1, (*cur)[j - 1] + 1, (*prev)[j - 1] + cost });
+				if (i > 1 && j > 1 && term[i - 1] == word[j - 2] && term[i - 2] == word[j - 1]) value = std::min(value, (*before)[j - 2] + 1);
+				(*cur)[j] = value;
+				rowMin = std::min(rowMin, value);
+			}
+			if (rowMin > limit) return limit + 1;
+			std::swap(before, prev);
+			std::swap(prev, cur);
+		}
+		return *std::min_element(prev->begin(), prev->end());
+	}
+
+	int fewestTypos(Field const& field, std::wstring_view term, int limit) {
+		int best = limit + 1;
+		for (auto& [start, end] : field.words) {
+			best = std::min(best, typos(term, std::wstring_view(field.text).substr(start, end - start), limit));
+			if (best == 0) break;
+		}
+		return best;
+	}
+
+	int match(Entry const& entry, std::wstring_view term) {
+		auto& name = entry.name;
+		if (name.text == term) return 1000;
+		if (name.text.starts_with(term)) return 900;
+		if (atWordStart(name, term)) return 800;
+		if (name.text.find(term) != std::wstring::npos) return 600;
+		if (auto jumps = wordJumps(name, term); jumps >= 0) return 400 - std::min(jumps * 30, 200);
+
+		if (atWordStart(entry.keywords, term)) return 350;
+		if (entry.keywords.text.find(term) != std::wstring::npos) return 250;
+		if (atWordStart(entry.description, term)) return 120;
+		if (entry.description.text.find(term) != std::wstring::npos) return 60;
+
+		if (int limit = tolerance(term); limit > 0) {
+			if (int count = fewestTypos(name, term, limit); count <= limit) return 150 - (count - 1) * 50;
+			if (int count = fewestTypos(entry.keywords, term, limit); count <= limit) return 50 - (count - 1) * 20;
+		}
+		return 0;
+	}
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+// Snap lines for dragging rectangles around, sorted per axis so finding the closest line to an edge is a binary search
+// plus a walk over the lines that are actually in range. Build it when the layout changes, not every frame.
+//
+// A target is a line at `pos` on one axis (an X target is a vertical line). It only applies while the dragged
+// rectangle's other coordinate is within [spanMin, spanMax], and only to edges closer than its range.
+class SnapIndex {
+public:
+	enum class Axis {
+		X,
+		Y,
+	};
+
+	// Which edge of the dragged rectangle lines up with the target
+	enum class Edge {
+		Start,
+		Center,
+		End,
+	};
+
+	static constexpr float unbounded = std::numeric_limits<float>::infinity();
+
+	struct Target {
+		float pos;
+		float range;
+		// what the line belongs to and which one it is, for the caller
+		int kind = 0;
+		int index = 0;
+		float spanMin = -unbounded;
+		float spanMax = unbounded;
+	};
+
+	struct Match {
+		Target const* target;
+		Edge edge;
+		float distance;
+		// where the rectangle's start should move to on this axis
+		float snappedStart;
+	};
+
+	void clear() {
+		for (auto& list : axes) list.clear();
+		maxRange[0] = maxRange[1] = 0.f;
+	}
+
+	void add(Axis axis, Target target) {
+		auto& list = axes[static_cast<int>(axis)];
+		auto it = std::upper_bound(list.begin(), list.end(), target.pos, [](float pos, Target const& t) { return pos < t.pos; });
+		float& range = maxRange[static_cast<int>(axis)];
+		range = std::max(range, target.range);
+		list.insert(it, target);
+	}
+
+	// Adds both edges and the center of a rectangle on each axis, with index = rectIndex * 3 + Edge
+	void addRect(int kind, int rectIndex, float left, float top, float right, float bottom, float range) {
+		float xs[3] = { left, (left + right) / 2.f, right };
+		float ys[3] = { top, (top + bottom) / 2.f, bottom };
+		for (int i = 0; i < 3; i++) {
+			add(Axis::X, { xs[i], range, kind, rectIndex * 3 + i });
+			add(Axis::Y, { ys[i], range, kind, rectIndex * 3 + i });
+		}
+	}
+
+	// The closest target to any edge of a rectangle spanning [start, start + size] on `axis`,
+	// whose position on the other axis is `cross`. On a tie, the lower kind wins.
+	[[nodiscard]] std::optional<Match> nearest(Axis axis, float start, float size, float cross) const {
+		auto& list = axes[static_cast<int>(axis)];
+		float range = maxRange[static_cast<int>(axis)];
+		std::optional<Match> best;
+
+		float offsets[3] = { 0.f, size / 2.f, size };
+		for (int e = 0; e < 3; e++) {
+			float edge = start + offsets[e];
+			auto it = std::lower_bound(list.begin(), list.end(), edge - range, [](Target const& t, float pos) { return t.pos < pos; });
+			for (; it != list.end() && it->pos <= edge + range; ++it) {
+				float dist = std::abs(it->pos - edge);
+				if (dist >= it->range || cross < it->spanMin || cross > it->spanMax) continue;
+				if (best && (dist > best->distance || (dist == best->distance && it->kind >= best->target->kind))) continue;
+				best = Match{ &*it, static_cast<Edge>(e), dist, it->pos - offsets[e] };
+			}
+		}
+		return best;
+	}
+
+	[[nodiscard]] size_t size(Axis axis) const { return axes[static_cast<int>(axis)].size(); }
+private:
+	std::vector<Target> axes[2];
+	float maxRange[2] = { 0.f, 0.f };
+};
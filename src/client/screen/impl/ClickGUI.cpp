@@ -11,11 +11,13 @@
 #include "client/Latite.h"
 #include "client/feature/module/Module.h"
 #include "client/feature/module/ModuleManager.h"
+#include "client/input/Keyboard.h"
 #include "util/DxContext.h"
 #include "client/render/Assets.h"
 #include "client/config/ConfigManager.h"
 
 #include "../ScreenManager.h"
+#include "../SearchIndex.h"
 
 #include <type_traits>
 
@@ -49,13 +51,19 @@ ClickGUI::ClickGUI() {
 
 void ClickGUI::onRender(Event&) {
 	static std::vector<ModContainer> mods = {};
+	// the modules to draw this frame, in order
+	static std::vector<ModContainer*> shownMods = {};
+	static SearchIndex searchIndex;
 
-	static size_t lastCount = 0;
+	static uint64_t lastGeneration = 0;
+	static int lastLanguage = -1;
 	static size_t marketScriptCount = 0;
 
-	if (mods.empty() || (Latite::getModuleManager().size() != lastCount)) {
-		lastCount = Latite::getModuleManager().size();
+	if (Latite::getModuleManager().getGeneration() != lastGeneration || Latite::get().getSelectedLanguage() != lastLanguage) {
+		lastGeneration = Latite::getModuleManager().getGeneration();
+		lastLanguage = Latite::get().getSelectedLanguage();
 		mods.clear();
+		shownMods.clear();
 		// TODO: fetch all market scripts
 
 		//auto plugins = Latite::getPluginManager().fetchPluginsFromMarket();
@@ -75,9 +83,22 @@ void ClickGUI::onRender(Event&) {
 			}
 			return false;
 			});
-	}
 
-	std::sort(mods.begin(), mods.end(), ModContainer::compare); // Sort modules
+		std::sort(mods.begin(), mods.end(), ModContainer::compare); // Sort modules
+
+		// ids are positions in mods
+		searchIndex.clear();
+		std::vector<std::wstring> settingNames;
+		for (auto& mod : mods) {
+			settingNames.clear();
+			if (mod.mod) {
+				mod.mod->settings->forEach([&](std::shared_ptr<Setting> set) {
+					if (set->visible) settingNames.push_back(set->getDisplayName());
+					});
+			}
+			searchIndex.add(mod.name, settingNames, mod.description);
+		}
+	}
 
 	{
 		auto scn = Latite::getScreenManager().getActiveScreen();
@@ -473,7 +494,17 @@ void ClickGUI::onRender(Event&) {
 
 		//std::array<float, 3> 
 
-		for (auto& mod : mods) {
+		auto searchText = searchTextBox.getText();
+		shownMods.clear();
+		if (searchText.size() > 0) {
+			// search results go across every tab, best match first
+			for (auto& mod : mods) mod.shouldRender = false;
+			for (auto& result : searchIndex.search(searchText)) {
+				mods[result.id].shouldRender = true;
+				shownMods.push_back(&mods[result.id]);
+			}
+		}
+		else for (auto& mod : mods) {
 			mod.shouldRender = true;
 
 			if (mod.isMarketScript) mod.shouldRender = false;
@@ -482,16 +513,7 @@ void ClickGUI::onRender(Event&) {
 			if (modTab == SCRIPT && mod.mod->getCategory() != IModule::SCRIPT) mod.shouldRender = false; // Hud Tab
 			if (modTab == SCRIPT && mod.isMarketScript) mod.shouldRender = true;
 
-			bool should = mod.shouldRender;
-			if (this->searchTextBox.getText().size() > 0) {
-				should = false;
-				std::wstring lower = mod.name;
-				std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-				std::wstring lowerSearch = searchTextBox.getText();
-				std::transform(lowerSearch.begin(), lowerSearch.end(), lowerSearch.begin(), ::tolower);
-				if (lower.rfind(lowerSearch) != UINTPTR_MAX) should = true;
-			}
-			mod.shouldRender = should;
+			if (mod.shouldRender) shownMods.push_back(&mod);
 		}
 
 		int i = 0;
@@ -504,8 +526,8 @@ void ClickGUI::onRender(Event&) {
 		// modules
 		scrollMax = 0.f;
 
-		for (auto& mod : mods) {
-			if (!mod.shouldRender) continue;
+		for (auto shown : shownMods) {
+			auto& mod = *shown;
 			Vec2 pos = { x, y + columnOffs[i] };
 			RectF modRect = { pos.x, pos.y, pos.x + modWidth, pos.y + modHeight };
 
@@ -567,6 +589,7 @@ void ClickGUI::onRender(Event&) {
 							if (resetRect.contains(cursorPos) && justClicked[0]) {
 								mod.mod->settings->forEach([&](std::shared_ptr<Setting> set) {
 									*set->value = set->defaultValue;
+									set->update();
 									//std::visit([set](auto& obj) {
 									//	static_assert(false, "");
 									//	obj = std::get<std::remove_reference_t<decltype(obj)>>(set->defaultValue);
@@ -797,15 +820,19 @@ void ClickGUI::onKey(Event& evGeneric) {
 		return;
 	}
 	if (this->activeSetting) {
-		if (ev.isDown()) {
-			if (ev.getKey() == VK_ESCAPE) {
-				activeSetting = nullptr;
-				ev.setCancelled(true);
-				return;
-			}
-			else {
-				this->capturedKey = ev.getKey();
-			}
+		if (ev.isDown() && ev.getKey() == VK_ESCAPE) {
+			activeSetting = nullptr;
+			ev.setCancelled(true);
+			return;
+		}
+
+		auto& kb = Latite::getKeyboard();
+		int mods = keybind::None;
+		if (kb.isKeyDown(VK_CONTROL)) mods |= keybind::Ctrl;
+		if (kb.isKeyDown(VK_SHIFT)) mods |= keybind::Shift;
+		if (kb.isKeyDown(VK_MENU)) mods |= keybind::Alt;
+		if (int bind = keyCapture.onKey(ev.getKey(), ev.isDown(), mods)) {
+			this->capturedKey = bind;
 		}
 	}
 
@@ -1029,7 +1056,10 @@ float ClickGUI::drawSetting(Setting* set, SettingGroup*, Vec2 const& pos, D2DUti
 		if (shouldSelect(keyRect, cursorPos)) {
 			setTooltip(L"Right click to reset");
 			if (justClicked[0]) {
-				if (!this->activeSetting) activeSetting = set;
+				if (!this->activeSetting) {
+					activeSetting = set;
+					keyCapture.start(set->allowChords);
+				}
 				playClickSound();
 			}
 			if (justClicked[1]) {
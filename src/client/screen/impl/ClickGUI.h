@@ -2,6 +2,7 @@
 #include "../Screen.h"
 #include "client/render/asset/Asset.h"
 #include "client/ui/TextBox.h"
+#include "client/input/KeybindTable.h"
 #include <memory>
 #include <array>
 #include <map>
@@ -107,6 +108,7 @@ private:
 
 	Setting* activeSetting = nullptr;
 	int capturedKey = 0;
+	keybind::Capture keyCapture;
 	float adaptedScale = 0.f;
 
 	float scrollMax = 0.f;
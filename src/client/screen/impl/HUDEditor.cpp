@@ -35,14 +35,12 @@ void HUDEditor::onRender(Event& ev) {
 	std::vector<d2d::Rect> maskRects = {};
 
 	if (isActive()) {
-		Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-			if (mod->isHud() && mod->isEnabled()) {
-				auto rMod = reinterpret_cast<HUDModule*>(mod.get());
-				if (Latite::get().getMenuBlur() && (mcRenderer || rMod->forceMinecraftRenderer())) maskRects.push_back(rMod->getRect());
-				if (rMod->isActive()) return;
-				addLayer(rMod->getRect());
-			}
-			});
+		for (auto rMod : getHudModules()) {
+			if (!rMod->isEnabled()) continue;
+			if (Latite::get().getMenuBlur() && (mcRenderer || rMod->forceMinecraftRenderer())) maskRects.push_back(rMod->getRect());
+			if (rMod->isActive()) continue;
+			addLayer(rMod->getRect());
+		}
 
 
 		auto alpha = Latite::getRenderer().getDeltaTime() / 10.f;
@@ -53,11 +51,12 @@ void HUDEditor::onRender(Event& ev) {
 		// cut out stuff, for movable scoreboard and paperdoll in future
 
 		for (auto& control : maskRects) {
-			auto bmp = Latite::getRenderer().getCopiedBitmap(control);
+			auto bmp = Latite::getRenderer().copyRegion(control);
+			if (!bmp) continue;
 
-			dc.ctx->DrawBitmap(bmp);
-
-			bmp->Release();
+			// the bitmap is shared, so only draw the region that was just copied
+			auto rc = D2D1::RectF(control.left, control.top, control.right, control.bottom);
+			dc.ctx->DrawBitmap(bmp, &rc, 1.f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR, &rc);
 		}
 		Latite::getRenderer().getDeviceContext()->Flush();
 
@@ -109,17 +108,14 @@ void HUDEditor::onRender(Event& ev) {
 
 void HUDEditor::onClick(Event& evGeneric) {
 	auto& ev = reinterpret_cast<ClickEvent&>(evGeneric);
-		Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-			if (!mod->isHud()) return;
-			auto hudMod = reinterpret_cast<HUDModule*>(mod.get());
-
-			if (!hudMod->isActive()) return;
+		for (auto hudMod : getHudModules()) {
+			if (!hudMod->isActive()) continue;
 			
-			if (!shouldSelect(hudMod->getRect(), SDK::ClientInstance::get()->cursorPos)) return;
+			if (!shouldSelect(hudMod->getRect(), SDK::ClientInstance::get()->cursorPos)) continue;
 			ev.setCancelled(true);
 
 			if (ev.getMouseButton() == 4) {
-				if (!hudMod->isResizable()) return;
+				if (!hudMod->isResizable()) continue;
 				hudMod->setScale(std::clamp(hudMod->getScale() - static_cast<float>(ev.getWheelDelta()) / 1000.f, HUDModule::min_scale, HUDModule::max_scale));
 			}
 			else if (ev.getMouseButton() == 3) {
@@ -133,7 +129,7 @@ void HUDEditor::onClick(Event& evGeneric) {
 			else {
 				ev.setCancelled(false);
 			}
-			});
+		}
 }
 
 void HUDEditor::onRenderLayer(Event& evGeneric) {
@@ -142,13 +138,11 @@ void HUDEditor::onRenderLayer(Event& evGeneric) {
 
 	if (ev.getScreenView()->visualTree->rootControl->name == "debug_screen") {
 		if (isActive() || SDK::ClientInstance::get()->minecraftGame->isCursorGrabbed()) {
-			Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-				if (mod->isHud() && mod->isEnabled() && reinterpret_cast<HUDModule*>(mod.get())->isActive() && Latite::getRenderer().getDeviceContext()) {
-					auto rMod = reinterpret_cast<HUDModule*>(mod.get());
-
+			for (auto rMod : getHudModules()) {
+				if (rMod->isEnabled() && rMod->isActive() && Latite::getRenderer().getDeviceContext()) {
 					if (rMod->getCategory() == Module::SCRIPT) {
 						if (!rMod->isTextual()) {
-							auto jsRMod = reinterpret_cast<JsHUDModule*>(mod.get());
+							auto jsRMod = reinterpret_cast<JsHUDModule*>(rMod);
 
 							auto oMat = jsRMod->script->getObject<D2DScriptingObject>()->getMatrix();
 							jsRMod->script->getObject<D2DScriptingObject>()->setMatrix(D2D1::Matrix3x2F::Scale(rMod->getScale(), rMod->getScale()) * D2D1::Matrix3x2F::Translation(rMod->getRect().left, rMod->getRect().top));
@@ -156,7 +150,7 @@ void HUDEditor::onRenderLayer(Event& evGeneric) {
 							jsRMod->script->getObject<D2DScriptingObject>()->setMatrix(oMat);
 						}
 						else {
-							auto jsRMod = reinterpret_cast<JsTextModule*>(mod.get());
+							auto jsRMod = reinterpret_cast<JsTextModule*>(rMod);
 
 							auto oMat = jsRMod->script->getObject<D2DScriptingObject>()->getMatrix();
 							jsRMod->script->getObject<D2DScriptingObject>()->setMatrix(D2D1::Matrix3x2F::Scale(rMod->getScale(), rMod->getScale()) * D2D1::Matrix3x2F::Translation(rMod->getRect().left, rMod->getRect().top));
@@ -165,7 +159,7 @@ void HUDEditor::onRenderLayer(Event& evGeneric) {
 						}
 					}
 				}
-				});
+			}
 		}
 
 		if (!mcRenderer) {
@@ -267,32 +261,29 @@ void HUDEditor::renderModules(SDK::MinecraftUIRenderContext* ctx, bool forceMine
 	}
 	else {
 		if (*lastScreenSize != guiData->screenSize) {
-			Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-				if (mod->isHud()) {
-					HUDModule* rMod = reinterpret_cast<HUDModule*>(mod.get());
-					Vec2 oPos = rMod->getRect().getPos();
-					Vec2 oPercent = oPos / *lastScreenSize;
-					Vec2 new_ = guiData->screenSize * oPercent;
-					rMod->setPos(new_);
-				}
-				});
+			for (auto rMod : getHudModules()) {
+				Vec2 oPos = rMod->getRect().getPos();
+				Vec2 oPercent = oPos / *lastScreenSize;
+				Vec2 new_ = guiData->screenSize * oPercent;
+				rMod->setPos(new_);
+			}
+			// the modules moved, so their snap lines did too
+			snapScreenSize = std::nullopt;
 		}
 	}
 
 	lastScreenSize = guiData->screenSize;
 
 	if (isActive() || SDK::ClientInstance::get()->minecraftGame->isCursorGrabbed()) {
-		Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-
+		for (auto hudModule : getHudModules()) {
 			if (!Latite::get().useMinecraftRenderer()) {
-				if ((forceMinecraftOnly || Latite::get().useMinecraftRenderer()) ^ static_cast<Module*>(mod.get())->forceMinecraftRenderer()) return;
+				if ((forceMinecraftOnly || Latite::get().useMinecraftRenderer()) ^ hudModule->forceMinecraftRenderer()) continue;
 			}
-			if (mod->isHud() && mod->isEnabled() && reinterpret_cast<HUDModule*>(mod.get())->isActive()) {
-				auto hudModule = static_cast<HUDModule*>(mod.get());
+			if (hudModule->isEnabled() && hudModule->isActive()) {
 				renderModule(hudModule, ctx);
 				hudModule->storePos(ctx ? SDK::ClientInstance::get()->getGuiData()->screenSize : Vec2(Latite::getRenderer().getScreenSize().width, Latite::getRenderer().getScreenSize().height));
 			}
-			});
+		}
 	}
 }
 
@@ -353,39 +344,42 @@ void HUDEditor::doDragging() {
 	else {
 		// Find a dragging element
 		if (isDown) {
-			bool doDrag = true;
-			Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-				if (doDrag) {
-					if (mod->isEnabled() && mod->isHud()) {
-						HUDModule* rMod = static_cast<HUDModule*>(mod.get());
-						if (!rMod->isActive()) return;
-						if (shouldSelect(rMod->getRect(), cursorPos)) {
-							dragMod = rMod;
-							Vec2 pos = rMod->getRect().getPos();
-							dragOffset = cursorPos - pos;
-							doDrag = false;
-						}
-					}
+			for (auto rMod : getHudModules()) {
+				if (!rMod->isEnabled() || !rMod->isActive()) continue;
+				if (shouldSelect(rMod->getRect(), cursorPos)) {
+					dragMod = rMod;
+					Vec2 pos = rMod->getRect().getPos();
+					dragOffset = cursorPos - pos;
+					// the layout may have changed since the last drag, and this module can't snap to itself
+					snapScreenSize = std::nullopt;
+					break;
 				}
-				});
-				
 			}
 		}
+	}
 }
 
-void HUDEditor::doSnapping(Vec2 const&) {
-	auto ssx = Latite::getRenderer().getScreenSize();
-	Vec2 ss = {ssx.width, ssx.height};
-	auto& mousePos = SDK::ClientInstance::get()->cursorPos;
+std::vector<HUDModule*> const& HUDEditor::getHudModules() {
+	auto generation = Latite::getModuleManager().getGeneration();
+	if (hudModulesGeneration != generation) {
+		hudModules.clear();
+		Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
+			if (mod->isHud()) hudModules.push_back(static_cast<HUDModule*>(mod.get()));
+			});
+		hudModulesGeneration = generation;
+	}
+	return hudModules;
+}
 
-	std::vector<float> snapLinesX = { 0.f, ss.x / 4.f, ss.x / 2.f, ss.x / 2 + (ss.x / 4), ss.x };
-	std::vector<float> snapLinesY = { ss.y / 2.f };
+void HUDEditor::rebuildSnapIndex(Vec2 const& ss) {
+	snapScreenSize = ss;
+	snapLinesX = { 0.f, ss.x / 4.f, ss.x / 2.f, ss.x / 2 + (ss.x / 4), ss.x };
+	snapLinesY = { ss.y / 2.f };
 
-	std::vector<std::pair<float, float>> snapLinesControlsX = {};
-	std::vector<float> snapLinesControlsY = {};
+	snapLinesControlsX.clear();
+	snapLinesControlsY.clear();
 
 	// Be able to snap to the minecraft ui (like hotbar)
-	
 	for (auto& rec : controls) {
 		if (rec.left > 0.f && rec.bottom < ss.y) snapLinesControlsX.emplace_back(rec.left, rec.top);
 		if (rec.right > 0.f && rec.bottom < ss.y) snapLinesControlsX.emplace_back(rec.right, rec.top);
@@ -393,242 +387,159 @@ void HUDEditor::doSnapping(Vec2 const&) {
 		if (rec.bottom > 0.f && rec.bottom < ss.y) snapLinesControlsY.push_back(rec.bottom);
 	}
 
+	snapIndex.clear();
+	for (int i = 0; i < static_cast<int>(snapLinesX.size()); i++) {
+		snapIndex.add(SnapIndex::Axis::X, { snapLinesX[i], 10.f, SnapValue::Normal, i });
+	}
+	for (int i = 0; i < static_cast<int>(snapLinesY.size()); i++) {
+		snapIndex.add(SnapIndex::Axis::Y, { snapLinesY[i], 10.f, SnapValue::Normal, i });
+	}
+	for (int i = 0; i < static_cast<int>(snapLinesControlsX.size()); i++) {
+		// only near the control vertically
+		auto [x, top] = snapLinesControlsX[i];
+		snapIndex.add(SnapIndex::Axis::X, { x, 5.f, SnapValue::MCUI, i, top - 100.f, top + 100.f });
+	}
+	for (int i = 0; i < static_cast<int>(snapLinesControlsY.size()); i++) {
+		snapIndex.add(SnapIndex::Axis::Y, { snapLinesControlsY[i], 5.f, SnapValue::MCUI, i });
+	}
+
+	snapModules.clear();
+	for (auto mod : getHudModules()) {
+		if (mod == dragMod || !mod->isEnabled() || !mod->isActive()) continue;
+		auto rc = mod->getRect();
+		snapIndex.addRect(SnapValue::Module, static_cast<int>(snapModules.size()), rc.left, rc.top, rc.right, rc.bottom, 5.f);
+		snapModules.push_back(mod);
+	}
+}
+
+std::optional<float> HUDEditor::resolveSnapLine(SnapValue const& value, HUDModule* mod, bool horizontal) {
+	auto idx = static_cast<size_t>(value.index);
+	switch (value.type) {
+	case SnapValue::Module:
+		for (auto other : getHudModules()) {
+			if (other == mod || other->name() != value.mod) continue;
+			if (!other->isEnabled() || !other->isActive()) return std::nullopt;
+			auto rc = other->getRect();
+			std::array<float, 3> lines = horizontal ? std::array{ rc.top, (rc.top + rc.bottom) / 2.f, rc.bottom } : std::array{ rc.left, (rc.left + rc.right) / 2.f, rc.right };
+			if (idx < 3) return lines[idx];
+			return std::nullopt;
+		}
+		return std::nullopt;
+	case SnapValue::MCUI:
+		if (horizontal && !snapLinesControlsY.empty()) return idx < snapLinesControlsY.size() ? std::optional(snapLinesControlsY[idx]) : std::nullopt;
+		if (!horizontal && !snapLinesControlsX.empty()) return idx < snapLinesControlsX.size() ? std::optional(snapLinesControlsX[idx].first) : std::nullopt;
+		// without any controls, these have always used the screen lines
+		[[fallthrough]];
+	default: {
+		auto& lines = horizontal ? snapLinesY : snapLinesX;
+		return idx < lines.size() ? std::optional(lines[idx]) : std::nullopt;
+	}
+	}
+}
+
+void HUDEditor::doSnapping(Vec2 const&) {
+	auto ssx = Latite::getRenderer().getScreenSize();
+	Vec2 ss = {ssx.width, ssx.height};
+	auto& mousePos = SDK::ClientInstance::get()->cursorPos;
+
+	if (!snapScreenSize || *snapScreenSize != ss) rebuildSnapIndex(ss);
+
 	if (isActive() && dragMod && Latite::get().getDoSnapLines()) {
 		auto pos = mousePos - dragOffset;
-
-		float snapRange = 10.f;
+		auto rect = dragMod->getRect();
 
 		D2DUtil dc;
 
-		Color col = d2d::Color(0.5, 1.0, 1.0);
-		float thickness = 1.f;
-
 		dragMod->snappingX = SnapValue();
 		dragMod->snappingY = SnapValue();
 
 		auto& snapX = std::get<SnapValue>(dragMod->snappingX);
 		auto& snapY = std::get<SnapValue>(dragMod->snappingY);
 
-		for (int i = 0; i < snapLinesX.size(); i++) {
-			float snap = snapLinesX[i];
-			SnapLine pred(dragMod, snap, false);
-			pred.color = col;
-			pred.thickness = thickness;
-
-			d2d::Color col = pred.color;
-			float thickness = pred.thickness;
-
-			if (std::abs(pos.x - pred.right) < snapRange) {
-				snapX.snap(SnapValue::Normal, SnapValue::Right, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ snap, dragMod->getRect().getPos().y });
-			}
-
-			if (std::abs(pos.x - pred.middle) < snapRange) {
-				snapX.snap(SnapValue::Normal, SnapValue::Middle, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ pred.middle, dragMod->getRect().getPos().y });
-			}
-
-			if (std::abs(pos.x - pred.left) < snapRange) {
-				snapX.snap(SnapValue::Normal, SnapValue::Left, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ pred.left, dragMod->getRect().getPos().y });
-			}
-		}
-
-		for (int i = 0; i < snapLinesY.size(); i++) {
-			float snap = snapLinesY[i];
-			SnapLine pred(dragMod, snap, true);
-			pred.color = col;
-			pred.thickness = thickness;
-
-			d2d::Color col = pred.color;
-			float thickness = pred.thickness;
-
-
-			if (std::abs(pos.y - pred.right) < snapRange) {
-				snapY.snap(SnapValue::Normal, SnapValue::Right, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, snap });
-			}
-
-			if (std::abs(pos.y - pred.middle) < snapRange) {
-				snapY.snap(SnapValue::Normal, SnapValue::Middle, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, pred.middle });
-			}
-
-			if (std::abs(pos.y - pred.left) < snapRange) {
-				snapY.snap(SnapValue::Normal, SnapValue::Left, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, pred.left });
-			}
-
-		}
-
-		for (int i = 0; i < snapLinesControlsX.size(); i++) {
-			auto& snaps = snapLinesControlsX[i];
-			float snap = snaps.first;
-			if (std::abs(pos.y - snaps.second) > 100.f) {
-				continue;
-			}
-
-			SnapLine pred(dragMod, snap, false);
-			pred.color = d2d::Colors::YELLOW;
-			pred.thickness = 0.5f;
-
-			d2d::Color col = pred.color;
-			float thickness = pred.thickness;
-
-			if (std::abs(pos.x - pred.right) < 5.f) {
-				snapX.snap(SnapValue::MCUI, SnapValue::Right, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ snap, dragMod->getRect().getPos().y });
+		auto apply = [&](SnapValue& value, SnapIndex::Match const& match) {
+			auto& target = *match.target;
+			auto type = static_cast<SnapValue::Type>(target.kind);
+			// the edge of the dragged module that's on the line, in SnapValue's terms
+			SnapValue::Pos place = match.edge == SnapIndex::Edge::Start ? SnapValue::Right : match.edge == SnapIndex::Edge::Center ? SnapValue::Middle : SnapValue::Left;
+			if (type == SnapValue::Module) {
+				value.snap(type, place, target.index % 3, snapModules[target.index / 3]->name());
 			}
-
-			if (std::abs(pos.x - pred.middle) < 5.f) {
-				snapX.snap(SnapValue::MCUI, SnapValue::Middle, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ pred.middle, dragMod->getRect().getPos().y });
+			else {
+				value.snap(type, place, target.index);
 			}
 
-			if (std::abs(pos.x - pred.left) < 5.f) {
-				snapX.snap(SnapValue::MCUI, SnapValue::Left, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
-				dragMod->setPos({ pred.left, dragMod->getRect().getPos().y });
-			}
+			d2d::Color col = type == SnapValue::MCUI ? d2d::Colors::YELLOW : d2d::Color(0.5, 1.0, 1.0);
+			dc.brush->SetColor(col.get());
+			return type == SnapValue::Normal ? 1.f : 0.5f;
+		};
 
+		if (auto match = snapIndex.nearest(SnapIndex::Axis::X, pos.x, rect.getWidth(), pos.y)) {
+			float thickness = apply(snapX, *match);
+			float snap = match->target->pos;
+			dc.ctx->DrawLine({ snap, 0 }, { snap, ss.y }, dc.brush, thickness);
+			dragMod->setPos({ match->snappedStart, dragMod->getRect().getPos().y });
 		}
 
-		for (int i = 0; i < snapLinesControlsY.size(); i++) {
-			auto snap = snapLinesControlsY[i];
-			SnapLine pred(dragMod, snap, true);
-			pred.color = d2d::Colors::YELLOW;
-			pred.thickness = 0.5f;
-
-			d2d::Color col = pred.color;
-			float thickness = pred.thickness;
-
-			if (std::abs(pos.y - pred.right) < 5.f) {
-				snapY.snap(SnapValue::MCUI, SnapValue::Right, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, snap });
-			}
-
-			if (std::abs(pos.y - pred.middle) < 5.f) {
-				snapY.snap(SnapValue::MCUI, SnapValue::Middle, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, pred.middle });
-			}
-
-			if (std::abs(pos.y - pred.left) < 5.f) {
-				snapY.snap(SnapValue::MCUI, SnapValue::Left, i);
-				dc.brush->SetColor(col.get());
-				dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
-				dragMod->setPos({ dragMod->getRect().getPos().x, pred.left });
-			}
-
+		if (auto match = snapIndex.nearest(SnapIndex::Axis::Y, pos.y, rect.getHeight(), pos.x)) {
+			float thickness = apply(snapY, *match);
+			float snap = match->target->pos;
+			dc.ctx->DrawLine({ 0.f, snap }, { ss.x, snap }, dc.brush, thickness);
+			dragMod->setPos({ dragMod->getRect().getPos().x, match->snappedStart });
 		}
 	}
 	else {
 		// Keep modules in their snapped state
-		Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-			if (mod->isHud() && mod->isEnabled()) {
-				auto rMod = static_cast<HUDModule*>(mod.get());
-				if (!rMod->isActive()) return;
-				auto& snapX = std::get<SnapValue>(rMod->snappingX);
-				auto& snapY = std::get<SnapValue>(rMod->snappingY);
-				auto pos = rMod->getRect().getPos();
-				if (snapX.doSnapping) {
-					if (snapX.type != SnapValue::Module) {
-						auto type = snapX.type;
-						using Snapping = SnapValue;
-						auto place = snapX.position;
-						auto idx = snapX.index;
-
-						auto& vector = snapLinesX;
-						auto idk = snapLinesX[idx];
-
-						// TODO: controls
-						
-						if (type == Snapping::MCUI && snapLinesControlsX.size() > 0) {
-							idk = snapLinesControlsX[idx].first;
-						}
-
-						SnapLine snap(rMod, idk, false);
-						switch (place) {
-						case Snapping::Left:
-							rMod->setPos({ snap.left, pos.y });
-							break;
-						case Snapping::Middle:
-							rMod->setPos({ snap.middle, pos.y });
-							break;
-						case Snapping::Right:
-							rMod->setPos({ snap.right, pos.y });
-							break;
-						default:
-							throw std::runtime_error("invalid snapping");
-							break;
-						}
+		for (auto rMod : getHudModules()) {
+			if (!rMod->isEnabled() || !rMod->isActive()) continue;
+			auto& snapX = std::get<SnapValue>(rMod->snappingX);
+			auto& snapY = std::get<SnapValue>(rMod->snappingY);
+			auto pos = rMod->getRect().getPos();
+			if (snapX.doSnapping) {
+				if (auto line = resolveSnapLine(snapX, rMod, false)) {
+					SnapLine snap(rMod, *line, false);
+					switch (snapX.position) {
+					case SnapValue::Left:
+						rMod->setPos({ snap.left, pos.y });
+						break;
+					case SnapValue::Middle:
+						rMod->setPos({ snap.middle, pos.y });
+						break;
+					case SnapValue::Right:
+						rMod->setPos({ snap.right, pos.y });
+						break;
+					default:
+						throw std::runtime_error("invalid snapping");
+						break;
 					}
 				}
-				pos = rMod->getRect().getPos();
-				if (snapY.doSnapping) {
-					auto type = snapY.type;
-					if (snapY.type != SnapValue::Module) {
-						using Snapping = SnapValue;
-						auto place = snapY.position;
-						auto idx = snapY.index;
-
-						auto& vector = snapLinesY;
-						auto idk = snapLinesY[idx];
-
-						// TODO: controls
-						
-						if (type == Snapping::MCUI && snapLinesControlsY.size() > 0) {
-							idk = snapLinesControlsY[idx];
-						}
-
-						SnapLine snap(rMod, idk, true);
-						switch (place) {
-						case Snapping::Left:
-							rMod->setPos({ pos.x, snap.left });
-							break;
-						case Snapping::Middle:
-							rMod->setPos({ pos.x, snap.middle });
-							break;
-						case Snapping::Right:
-							rMod->setPos({ pos.x, snap.right });
-							break;
-						default:
-							throw std::runtime_error("invalid snapping");
-							break;
-						}
+			}
+			pos = rMod->getRect().getPos();
+			if (snapY.doSnapping) {
+				if (auto line = resolveSnapLine(snapY, rMod, true)) {
+					SnapLine snap(rMod, *line, true);
+					switch (snapY.position) {
+					case SnapValue::Left:
+						rMod->setPos({ pos.x, snap.left });
+						break;
+					case SnapValue::Middle:
+						rMod->setPos({ pos.x, snap.middle });
+						break;
+					case SnapValue::Right:
+						rMod->setPos({ pos.x, snap.right });
+						break;
+					default:
+						throw std::runtime_error("invalid snapping");
+						break;
 					}
 				}
-
 			}
-			});
+		}
 	}
 }
 
 void HUDEditor::keepModulesInBounds(Vec2 const& ss) {
-	Latite::getModuleManager().forEach([&](std::shared_ptr<IModule> mod) {
-		if (mod->isEnabled() && mod->isHud()) {
-			HUDModule* rMod = static_cast<HUDModule*>(mod.get());
-			if (!rMod->isActive()) return false;
+	for (auto rMod : getHudModules()) {
+		if (rMod->isEnabled() && rMod->isActive()) {
 			d2d::Rect rc = rMod->getRect();
 			Vec2 modPos = rc.getPos();
 
@@ -659,13 +570,13 @@ void HUDEditor::keepModulesInBounds(Vec2 const& ss) {
 			//round2(rc.bottom);
 			//rMod->setRect(rc);
 		}
-		return false;
-		});
+	}
 }
 
 void HUDEditor::onEnable(bool ignoreAnims) {
 	if (ignoreAnims) anim = 1.f;
 	else anim = 0.f;
+	snapScreenSize = std::nullopt;
 	mouseButtons = {};
 	activeMouseButtons = {};
 	justClicked = {};
@@ -3,6 +3,7 @@
 #include "util/LMath.h"
 #include "util/DxUtil.h"
 #include "client/feature/module/HudModule.h"
+#include "../SnapIndex.h"
 
 class HUDEditor : public Screen {
 public:
@@ -22,6 +23,13 @@ private:
 	void doSnapping(Vec2 const&);
 	void keepModulesInBounds(Vec2 const&);
 
+	// Every HUD module, in registration order. Only rebuilt when modules are added or removed.
+	std::vector<class HUDModule*> const& getHudModules();
+	// Collects the snap lines for this screen size and the current layout, except for the module being dragged
+	void rebuildSnapIndex(Vec2 const& ss);
+	// Where a module snapped with this value should line up, if the line still exists
+	std::optional<float> resolveSnapLine(SnapValue const& value, class HUDModule* mod, bool horizontal);
+
 	class HUDModule* dragMod;
 
 	float anim = 0.f;
@@ -29,6 +37,19 @@ private:
 	std::vector<d2d::Rect> controls = {};
 	std::optional<Vec2> lastScreenSize = std::nullopt;
 
+	std::vector<class HUDModule*> hudModules = {};
+	uint64_t hudModulesGeneration = 0;
+
+	SnapIndex snapIndex = {};
+	std::optional<Vec2> snapScreenSize = std::nullopt;
+	std::vector<float> snapLinesX = {};
+	std::vector<float> snapLinesY = {};
+	// vanilla UI edges; X lines keep the control's top, since they only apply near it
+	std::vector<std::pair<float, float>> snapLinesControlsX = {};
+	std::vector<float> snapLinesControlsY = {};
+	// modules in the snap index, by rectangle index
+	std::vector<class HUDModule*> snapModules = {};
+
 	struct SnapLine {
 		float left, middle, right;
 		d2d::Color color = d2d::Colors::WHITE;
@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "util/ByteCodec.h"
+
+// On-disk cache of serialized (parsed) scripts, so loading a plugin that hasn't changed skips parsing.
+// It only does the bookkeeping and never talks to the script engine: callers serialize and run the bytecode.
+//
+// Entries are keyed by the script's source (two independent 64-bit hashes and its length) and a version string,
+// which should identify both the engine and the client build. An entry is only returned if all of that matches and
+// its payload checksum is intact; anything else is deleted. Writes go through a temporary file and a rename, and
+// once the directory grows past maxBytes the least recently used entries are removed.
+//
+// Not thread safe.
+class BytecodeCache {
+public:
+	static constexpr char magic[4] = { 'L', 'J', 'B', 'C' };
+	static constexpr uint64_t formatVersion = 1;
+	static constexpr std::string_view extension = ".jsbc";
+
+	struct Entry {
+		std::vector<uint8_t> bytecode;
+		// how long producing the bytecode took, which a hit saves
+		std::chrono::nanoseconds compileTime{};
+	};
+
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		// entries that were corrupt, outdated, or refused by the engine
+		uint64_t invalidated = 0;
+		uint64_t stores = 0;
+		uint64_t evictions = 0;
+		// compile time of the hits minus the time spent reading them
+		std::chrono::nanoseconds timeSaved{};
+
+		[[nodiscard]] double hitRate() const {
+			auto total = hits + misses;
+			return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+		}
+	};
+
+	BytecodeCache(std::filesystem::path directory, std::string version, uint64_t maxBytes = 64ull * 1024 * 1024)
+		: directory(std::move(directory)), version(std::move(version)), maxBytes(maxBytes) {
+		std::error_code ec;
+		std::filesystem::create_directories(this->directory, ec);
+	}
+
+	[[nodiscard]] std::optional<Entry> load(std::wstring_view source) {
+		auto start = std::chrono::steady_clock::now();
+		auto key = Key::make(source);
+		auto path = getPath(key);
+
+		std::error_code ec;
+		if (!std::filesystem::exists(path, ec)) {
+			stats.misses++;
+			return std::nullopt;
+		}
+
+		std::vector<uint8_t> data;
+		{
+			std::ifstream ifs{ path, std::ios::binary };
+			if (ifs) data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+		}
+
+		auto entry = parse(data, key);
+		if (!entry) {
+			std::filesystem::remove(path, ec);
+			stats.invalidated++;
+			stats.misses++;
+			return std::nullopt;
+		}
+
+		// keep recently used entries from being evicted first
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+		stats.hits++;
+		auto readTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		if (entry->compileTime > readTime) stats.timeSaved += entry->compileTime - readTime;
+		return entry;
+	}
+
+	bool store(std::wstring_view source, std::span<uint8_t const> bytecode, std::chrono::nanoseconds compileTime) {
+		auto key = Key::make(source);
+
+		std::vector<uint8_t> data;
+		data.reserve(bytecode.size() + 128);
+		data.insert(data.end(), std::begin(magic), std::end(magic));
+		util::ByteWriter writer{ data };
+		writer.putVarint(formatVersion);
+		writer.putVarint(key.hashA);
+		writer.putVarint(key.hashB);
+		writer.putVarint(key.length);
+		writer.putString(version);
+		writer.putVarint(static_cast<uint64_t>(std::max<int64_t>(compileTime.count(), 0)));
+		writer.putVarint(bytecode.size());
+		writer.putVarint(checksum(bytecode));
+		writer.putBytes(bytecode.data(), bytecode.size());
+
+		auto path = getPath(key);
+		auto tmp = path;
+		tmp += ".tmp";
+		{
+			std::ofstream ofs{ tmp, std::ios::binary | std::ios::trunc };
+			if (!ofs) return false;
+			ofs.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+			if (!ofs) return false;
+		}
+		std::error_code ec;
+		std::filesystem::rename(tmp, path, ec);
+		if (ec) {
+			std::filesystem::remove(tmp, ec);
+			return false;
+		}
+
+		stats.stores++;
+		evict();
+		return true;
+	}
+
+	// Removes the entry for this source, e.g. when the engine refused its bytecode. Counts the load as a miss.
+	void reject(std::wstring_view source) {
+		std::error_code ec;
+		std::filesystem::remove(getPath(Key::make(source)), ec);
+		stats.invalidated++;
+		if (stats.hits > 0) {
+			stats.hits--;
+			stats.misses++;
+		}
+	}
+
+	[[nodiscard]] Stats const& getStats() const { return stats; }
+	[[nodiscard]] std::filesystem::path const& getDirectory() const { return directory; }
+private:
+	struct Key {
+		uint64_t hashA;
+		uint64_t hashB;
+		uint64_t length;
+
+		static Key make(std::wstring_view source) {
+			// FNV-1a and a multiply-xorshift hash, over UTF-16 units so keys don't depend on wchar_t's size
+			uint64_t a = 0xcbf29ce484222325ull;
+			uint64_t b = 0x9E3779B97F4A7C15ull;
+			for (wchar_t ch : source) {
+				auto unit = static_cast<uint64_t>(static_cast<uint16_t>(ch));
+				a = (a ^ unit) * 0x100000001b3ull;
+				b = (b ^ unit) * 0xff51afd7ed558ccdull;
+				b ^= b >> 29;
+			}
+			return { a, b, source.size() };
+		}
+	};
+
+	static uint64_t checksum(std::span<uint8_t const> data) {
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (auto byte : data) {
+			hash = (hash ^ byte) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	[[nodiscard]] std::filesystem::path getPath(Key const& key) const {
+		char name[17];
+		for (int i = 0; i < 16; i++) {
+			name[i] = "0123456789abcdef"[(key.hashA >> (60 - i * 4)) & 0xF];
+		}
+		name[16] = 0;
+		return directory / (std::string(name) + std::string(extension));
+	}
+
+	[[nodiscard]] std::optional<Entry> parse(std::vector<uint8_t> const& data, Key const& key) const {
+		if (data.size() < sizeof(magic) || !std::equal(std::begin(magic), std::end(magic), data.begin())) return std::nullopt;
+
+		util::ByteReader reader{ data.data() + sizeof(magic), data.size() - sizeof(magic) };
+		if (reader.getVarint() != formatVersion) return std::nullopt;
+		if (reader.getVarint() != key.hashA || reader.getVarint() != key.hashB || reader.getVarint() != key.length) return std::nullopt;
+		if (reader.getString() != version) return std::nullopt;
+
+		Entry entry;
+		entry.compileTime = std::chrono::nanoseconds(static_cast<int64_t>(reader.getVarint()));
+		auto size = reader.getVarint();
+		auto sum = reader.getVarint();
+		if (!reader.ok() || size == 0) return std::nullopt;
+
+		auto bytes = reader.getBytes(static_cast<size_t>(size));
+		if (!reader.ok() || !reader.atEnd()) return std::nullopt;
+
+		entry.bytecode.assign(bytes, bytes + size);
+		if (checksum(entry.bytecode) != sum) return std::nullopt;
+		return entry;
+	}
+
+	void evict() {
+		struct File {
+			std::filesystem::path path;
+			std::filesystem::file_time_type time;
+			uint64_t size;
+		};
+
+		std::error_code ec;
+		std::vector<File> files;
+		uint64_t total = 0;
+		for (auto& ent : std::filesystem::directory_iterator(directory, ec)) {
+			if (ent.path().extension() != extension) continue;
+			std::error_code fileEc;
+			File file{ ent.path(), ent.last_write_time(fileEc), ent.file_size(fileEc) };
+			if (fileEc) continue;
+			total += file.size;
+			files.push_back(std::move(file));
+		}
+		if (total <= maxBytes) return;
+
+		std::sort(files.begin(), files.end(), [](File const& a, File const& b) { return a.time < b.time; });
+		for (auto& file : files) {
+			if (total <= maxBytes) break;
+			if (std::filesystem::remove(file.path, ec)) {
+				total -= file.size;
+				stats.evictions++;
+			}
+		}
+	}
+
+	std::filesystem::path directory;
+	std::string version;
+	uint64_t maxBytes;
+	Stats stats{};
+};
@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "ChakraWorkerRuntime.h"
+#include "util/Logger.h"
+
+// Pool threads aren't the game thread, so everything here uses JS::JsSetCurrentContext directly
+// instead of Chakra::SetContext.
+
+ChakraWorkerRuntime::State::~State() {
+	JS::JsRelease(ctx, nullptr);
+}
+
+ChakraWorkerRuntime::ChakraWorkerRuntime() {
+	auto attributes = static_cast<JsRuntimeAttributes>(JsRuntimeAttributeDisableBackgroundWork | JsRuntimeAttributeAllowScriptInterrupt);
+	if (JS::JsCreateRuntime(attributes, nullptr, &runtime) != JsNoError) {
+		runtime = JS_INVALID_RUNTIME_HANDLE;
+	}
+}
+
+ChakraWorkerRuntime::~ChakraWorkerRuntime() {
+	if (runtime == JS_INVALID_RUNTIME_HANDLE) return;
+	JS::JsSetCurrentContext(JS_INVALID_REFERENCE);
+	JS::JsCollectGarbage(runtime);
+	JS::JsDisposeRuntime(runtime);
+}
+
+std::unique_ptr<ChakraWorkerRuntime::State> ChakraWorkerRuntime::start(PooledWorker& worker, Script const& script) {
+	JsContextRef ctx;
+	if (JS::JsCreateContext(runtime, &ctx) != JsNoError) return nullptr;
+	JS::JsAddRef(ctx, nullptr);
+	auto state = std::make_unique<State>(ctx);
+
+	JS::JsSetCurrentContext(ctx);
+
+	auto global = Chakra::GetGlobalObject();
+	Chakra::DefineFunc(global, postMessageCallback, L"postMessage", &worker);
+	Chakra::DefineFunc(global, isCancelledCallback, L"isCancelled", &worker);
+
+	JsValueRef result;
+	auto err = JS::JsRunScript(script.source.c_str(), nextSourceContext++, script.name.c_str(), &result);
+	reportError(err, script.name);
+	JS::JsSetCurrentContext(JS_INVALID_REFERENCE);
+
+	if (err != JsNoError) return nullptr;
+	return state;
+}
+
+void ChakraWorkerRuntime::message(State& state, PooledWorker& worker, std::string const& message) {
+	JS::JsSetCurrentContext(state.ctx);
+
+	auto global = Chakra::GetGlobalObject();
+	auto onMessage = Chakra::GetProperty(global, L"onmessage");
+	JsValueType type;
+	if (JS::JsGetValueType(onMessage, &type) == JsNoError && type == JsFunction) {
+		JsValueRef args[2] = { global, Chakra::MakeString(std::string_view(message)) };
+		JsValueRef result;
+		reportError(JS::JsCallFunction(onMessage, args, 2, &result), L"onmessage");
+	}
+
+	JS::JsSetCurrentContext(JS_INVALID_REFERENCE);
+}
+
+void ChakraWorkerRuntime::interrupt() {
+	if (runtime != JS_INVALID_RUNTIME_HANDLE) JS::JsDisableRuntimeExecution(runtime);
+}
+
+void ChakraWorkerRuntime::resume() {
+	// a cancel during the previous worker's script leaves execution disabled
+	if (runtime != JS_INVALID_RUNTIME_HANDLE) JS::JsEnableRuntimeExecution(runtime);
+}
+
+JsValueRef ChakraWorkerRuntime::postMessageCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto worker = reinterpret_cast<PooledWorker*>(callbackState);
+	if (!Chakra::VerifyArgCount(argCount, 2)) return JS_INVALID_REFERENCE;
+	if (!Chakra::VerifyParameters({ {arguments[1], JsString} })) return JS_INVALID_REFERENCE;
+
+	return worker->send(util::WStrToStr(Chakra::GetString(arguments[1]))) ? Chakra::GetTrue() : Chakra::GetFalse();
+}
+
+JsValueRef ChakraWorkerRuntime::isCancelledCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto worker = reinterpret_cast<PooledWorker*>(callbackState);
+	return worker->isCancelled() ? Chakra::GetTrue() : Chakra::GetFalse();
+}
+
+void ChakraWorkerRuntime::reportError(JsErrorCode code, std::wstring const& name) {
+	// terminated means the worker was cancelled, which isn't an error
+	if (code == JsNoError || code == JsErrorScriptTerminated) return;
+
+	if (code == JsErrorScriptException) {
+		JsValueRef except;
+		if (JS::JsGetAndClearException(&except) == JsNoError) {
+			Logger::Warn("(worker/{}) {}", util::WStrToStr(name), util::WStrToStr(Chakra::ToString(except)));
+			return;
+		}
+	}
+	Logger::Warn("(worker/{}) Js ErrorCode: 0x{:X}", util::WStrToStr(name), (int)code);
+}
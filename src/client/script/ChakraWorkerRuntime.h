@@ -0,0 +1,51 @@
+#pragma once
+#include "WorkerPool.h"
+#include "util/ChakraUtil.h"
+
+// Runs plugin worker scripts for a WorkerPool. Each pool thread keeps one of these (one Chakra runtime),
+// and every worker on that thread gets its own context in it.
+//
+// Inside a worker, the script sees postMessage(string) to send a message to its owner, isCancelled(),
+// and receives messages through a global onmessage(string) function.
+class ChakraWorkerRuntime {
+public:
+	struct Script {
+		std::wstring source;
+		// shown in error messages
+		std::wstring name;
+	};
+
+	class State {
+	public:
+		explicit State(JsContextRef ctx) : ctx(ctx) {}
+		State(State&) = delete;
+		State(State&&) = delete;
+		~State();
+
+		JsContextRef ctx;
+	};
+
+	ChakraWorkerRuntime();
+	ChakraWorkerRuntime(ChakraWorkerRuntime&) = delete;
+	ChakraWorkerRuntime(ChakraWorkerRuntime&&) = delete;
+	~ChakraWorkerRuntime();
+
+	[[nodiscard]] bool isValid() const { return runtime != JS_INVALID_RUNTIME_HANDLE; }
+
+	std::unique_ptr<State> start(PooledWorker& worker, Script const& script);
+	void message(State& state, PooledWorker& worker, std::string const& message);
+	void interrupt();
+	// Execution stays disabled after an interrupt until this is called
+	void resume();
+private:
+	static JsValueRef CALLBACK postMessageCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	static JsValueRef CALLBACK isCancelledCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+
+	// Logs and clears the pending exception, if the last call left one
+	void reportError(JsErrorCode code, std::wstring const& name);
+
+	JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+	JsSourceContext nextSourceContext = 0;
+};
@@ -30,6 +30,7 @@
 #include "class/impl/JsHudModuleClass.h"
 #include "class/impl/JsTextModuleClass.h"
 #include "class/impl/JsTextureClass.h"
+#include "class/impl/JsWorkerThread.h"
 #include "class/impl/JsSettingClass.h"
 #include "class/impl/JsCommandClass.h"
 #include "class/impl/JsNativeModule.h"
@@ -169,7 +170,36 @@ JsErrorCode JsScript::runScript() {
 
 	JsErrorCode code = JsNoError;
 	try {
-		 code = JS::JsRunScript(loadedScript.c_str(), util::fnv1a_32(util::WStrToStr(this->path.wstring())), this->path.wstring().c_str(), nullptr);
+		auto sourceContext = util::fnv1a_32(util::WStrToStr(this->path.wstring()));
+		auto cache = Latite::getPluginManager().getBytecodeCache();
+
+		if (cache) {
+			if (auto entry = cache->load(loadedScript)) {
+				bytecode = std::move(entry->bytecode);
+				code = JS::JsRunSerializedScript(loadedScript.c_str(), bytecode.data(), sourceContext, this->path.wstring().c_str(), nullptr);
+				// anything else came from running the script, which mustn't run twice
+				if (code != JsErrorBadSerializedScript) return code;
+
+				Logger::Warn("Cached bytecode for {} was rejected, parsing source", util::WStrToStr(this->path.wstring()));
+				cache->reject(loadedScript);
+				bytecode.clear();
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			if (compileScript() == JsNoError) {
+				cache->store(loadedScript, bytecode, std::chrono::steady_clock::now() - start);
+				return JS::JsRunSerializedScript(loadedScript.c_str(), bytecode.data(), sourceContext, this->path.wstring().c_str(), nullptr);
+			}
+			// running the source reports the syntax error properly
+			bytecode.clear();
+			bool hasException = false;
+			if (JS::JsHasException(&hasException) == JsNoError && hasException) {
+				JsValueRef except;
+				JS::JsGetAndClearException(&except);
+			}
+		}
+
+		code = JS::JsRunScript(loadedScript.c_str(), sourceContext, this->path.wstring().c_str(), nullptr);
 	}
 	catch (...) {
 		//Latite::getClientMessageQueue().push("Exception while loading script " + path.string() + ": " + e.what());
@@ -178,23 +208,13 @@ JsErrorCode JsScript::runScript() {
 }
 
 JsErrorCode JsScript::compileScript() {
-	constexpr size_t cBufSize = 32768;
-	unsigned int bufferSize = cBufSize;
-	BYTE* scriptBuf = new BYTE[cBufSize];
-
-	auto err = JS::JsSerializeScript(loadedScript.c_str(), scriptBuf, &bufferSize);
-
-	auto objFolder = this->getPlugin()->getPath() / "obj";
-	std::filesystem::create_directory(objFolder);
-
-	auto objPath = objFolder / (this->relPath.substr(0, relPath.size() - 3) /*remove .js*/ + L".obj");
-
-	std::ofstream ofs{objPath};
-	for (int i = 0; i < bufferSize; ++i) {
-		ofs << (char)scriptBuf[i];
-	}
+	unsigned int bufferSize = 0;
+	auto err = JS::JsSerializeScript(loadedScript.c_str(), nullptr, &bufferSize);
+	if (err != JsNoError) return err;
 
-	delete[] scriptBuf;
+	bytecode.resize(bufferSize);
+	err = JS::JsSerializeScript(loadedScript.c_str(), bytecode.data(), &bufferSize);
+	bytecode.resize(err == JsNoError ? bufferSize : 0);
 	return err;
 }
 
@@ -495,6 +515,7 @@ void JsScript::loadScriptObjects() {
 	this->classes.push_back(std::make_shared<JsTextureClass>(this));
 	this->classes.push_back(std::make_shared<JsNativeModule>(this));
 	this->classes.push_back(std::make_shared<JsBlock>(this));
+	this->classes.push_back(std::make_shared<JsWorkerThread>(this));
 	JsErrorCode err;
 
 	JsValueRef globalObj = Chakra::GetGlobalObject();
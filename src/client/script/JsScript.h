@@ -104,6 +104,7 @@ public:
 
 	bool load();
 	JsErrorCode runScript();
+	// Serializes the loaded script into `bytecode`
 	JsErrorCode compileScript();
 
 	struct Resource {
@@ -145,6 +146,8 @@ private:
 	std::wstring relPath;
 	std::wstring relFolderPath;
 	std::wstring loadedScript;
+	// the engine keeps using this after running it, so it lives as long as the script
+	std::vector<BYTE> bytecode;
 	std::wifstream stream;
 
 	std::vector<JsValueRef> ownedEvents;
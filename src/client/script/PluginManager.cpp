@@ -29,6 +29,20 @@ using namespace winrt::Windows::Web::Http::Filters;
 PluginManager::PluginManager() {
 }
 
+namespace {
+	// Serialized scripts only load in the engine that made them, so tell engines apart by
+	// which DLL is loaded and that file's size and modification time
+	std::string getEngineVersion() {
+		wchar_t path[MAX_PATH] = {};
+		if (!Chakra::mod || !GetModuleFileNameW(Chakra::mod, path, MAX_PATH)) return "unknown";
+
+		std::error_code ec;
+		auto size = std::filesystem::file_size(path, ec);
+		auto time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+		return std::format("{}:{}:{}", util::WStrToStr(std::filesystem::path(path).filename().wstring()), size, time);
+	}
+}
+
 std::filesystem::path PluginManager::getUserDir() {
 	return util::GetLatitePath() / "Plugins";
 }
@@ -148,6 +162,12 @@ bool PluginManager::loadPrerunScripts()
 			}
 		}
 	}
+
+	if (bytecodeCache) {
+		auto& stats = bytecodeCache->getStats();
+		Logger::Info("Script bytecode cache: {} hits, {} misses ({:.0f}% hit rate), saved {} ms", stats.hits, stats.misses,
+			stats.hitRate() * 100.0, std::chrono::duration_cast<std::chrono::milliseconds>(stats.timeSaved).count());
+	}
 	return true;
 }
 
@@ -331,6 +351,10 @@ void PluginManager::init()
 	std::filesystem::create_directory(scriptsPath);
 
 	initListeners();
+
+	bytecodeCache = std::make_unique<BytecodeCache>(util::GetLatitePath() / "Cache" / "Bytecode",
+		std::format("{}|{}", getEngineVersion(), Latite::version));
+
 	int id = 0;
 	//this->objects.push_back(std::make_shared<ClientScriptingObject>(id++));
 	//this->objects.push_back(std::make_shared<GameScriptingObject>(id++));
@@ -369,6 +393,13 @@ void PluginManager::unloadScript(std::shared_ptr<JsPlugin> ptr) {
 	Event newEv{ L"unload-script", {val}, false };
 	dispatchEvent(newEv);
 
+	// cancel the plugin's workers and wait for them, so none of them outlive it
+	if (workerPool) {
+		for (auto& scr : ptr->getScripts()) {
+			workerPool->join(reinterpret_cast<uintptr_t>(scr.get()));
+		}
+	}
+
 	for (auto& ev : this->eventListeners) {
 		if (ev.second.size() > 0) {
 			auto it = ev.second.begin();
@@ -420,81 +451,134 @@ bool PluginManager::scriptingSupported() {
 }
 
 void PluginManager::uninitialize() {
-	for (auto& script : this->items) {
-		popScript(script);
+	// popScript erases from items
+	while (!this->items.empty()) {
+		popScript(this->items.back());
 	}
+	workerPool.reset();
+}
+
+WorkerPool<ChakraWorkerRuntime>* PluginManager::getWorkerPool() {
+	if (!workerPool && scriptingSupported()) {
+		// a handful of threads is plenty for background work and leaves the game its cores
+		size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+		workerPool = std::make_unique<WorkerPool<ChakraWorkerRuntime>>(threads, []() -> std::unique_ptr<ChakraWorkerRuntime> {
+			auto runtime = std::make_unique<ChakraWorkerRuntime>();
+			if (!runtime->isValid()) return nullptr;
+			return runtime;
+			});
+	}
+	return workerPool.get();
+}
+
+bool PluginManager::hasListeners(std::wstring const& type) {
+	auto it = eventListeners.find(type);
+	return it != eventListeners.end() && !it->second.empty();
 }
 
 bool PluginManager::dispatchEvent(Event& ev) {
-	for (auto& lis : eventListeners) {
-		if (lis.first == ev.type) {
-			for (auto& l : lis.second) {
-				Chakra::SetContext(std::get<2>(l));
-				JsValueRef params[2] = {};
-				// create the obj
-				JS::JsGetUndefinedValue(params);
-				JS::JsCreateObject(&params[1]);
-				JS::JsAddRef(params[1], nullptr);
-
-				if (ev.isCancellable) {
-
-					Event::Value val{};
-					val.val = false;
-					val.name = L"cancel";
-					ev.values.push_back(val);
-				}
+	auto it = eventListeners.find(ev.type);
+	if (it == eventListeners.end() || it->second.empty()) return false;
+
+	if (ev.isCancellable) {
+		Event::Value val{};
+		val.val = false;
+		val.name = L"cancel";
+		ev.values.push_back(val);
+	}
 
-				for (auto& val : ev.values) {
-					JsPropertyIdRef idRef;
+	// Strings and property ids only depend on the context, so they're made once per context
+	// instead of once per listener. Consecutive listeners usually share a context.
+	struct CachedValue {
+		JsPropertyIdRef id = JS_INVALID_REFERENCE;
+		JsValueRef str = JS_INVALID_REFERENCE;
+	};
+	std::vector<CachedValue> cache(ev.values.size());
+	JsContextRef cacheContext = JS_INVALID_REFERENCE;
 
-					JsValueRef ref = JS_INVALID_REFERENCE;
-					switch (val.val.index()) {
-					case Event::Value::Bool:
-					{
-						JS::JsBoolToBoolean(std::get<bool>(val.val), &ref);
-					}
-					break;
-					case Event::Value::Number:
-					{
-						JS::JsDoubleToNumber(std::get<double>(val.val), &ref);
-					}
-					break;
-					case Event::Value::String:
-					{
-						JS::JsPointerToString(std::get<std::wstring>(val.val).c_str(), std::get<std::wstring>(val.val).size(), &ref);
-					}
-					break;
-					case Event::Value::EntityRef:
+	auto releaseCache = [&]() {
+		for (auto& cached : cache) {
+			if (cached.str != JS_INVALID_REFERENCE) JS::JsRelease(cached.str, nullptr);
+			cached = {};
+		}
+	};
+
+	for (auto& l : it->second) {
+		if (std::get<2>(l) != cacheContext) {
+			releaseCache();
+			cacheContext = std::get<2>(l);
+		}
+		Chakra::SetContext(std::get<2>(l));
+		JsValueRef params[2] = {};
+		// create the obj
+		JS::JsGetUndefinedValue(params);
+		JS::JsCreateObject(&params[1]);
+		JS::JsAddRef(params[1], nullptr);
+
+		for (size_t i = 0; i < ev.values.size(); i++) {
+			auto& val = ev.values[i];
+			auto& cached = cache[i];
+			if (cached.id == JS_INVALID_REFERENCE) {
+				JS::JsGetPropertyIdFromName(val.name.c_str(), &cached.id);
+			}
 
-					{
-						// TODO: Entity refs
+			JsValueRef ref = JS_INVALID_REFERENCE;
+			switch (val.val.index()) {
+			case Event::Value::Bool:
+			{
+				JS::JsBoolToBoolean(std::get<bool>(val.val), &ref);
+			}
+			break;
+			case Event::Value::Number:
+			{
+				JS::JsDoubleToNumber(std::get<double>(val.val), &ref);
+			}
+			break;
+			case Event::Value::String:
+			case Event::Value::StringView:
+			{
+				if (cached.str == JS_INVALID_REFERENCE) {
+					if (val.val.index() == Event::Value::String) {
+						cached.str = Chakra::MakeString(std::get<std::wstring>(val.val));
 					}
-					break;
-					default:
-						throw std::runtime_error("unknown value");
-						break;
+					else {
+						cached.str = Chakra::MakeString(std::get<std::string_view>(val.val));
 					}
-					JS::JsGetPropertyIdFromName(val.name.c_str(), &idRef);
-					JS::JsSetProperty(params[1], idRef, ref, true);
-					Chakra::Release(ref);
+					JS::JsAddRef(cached.str, nullptr);
 				}
-				JsValueRef ret;
+				ref = cached.str;
+			}
+			break;
+			case Event::Value::EntityRef:
 
-				//int refc1 = Chakra::GetRefCount(l.first);
-				//int refc = Chakra::GetRefCount(params[1]);
-				handleErrors(Chakra::CallFunction(std::get<1>(l), params, 2, &ret));
+			{
+				// TODO: Entity refs
+			}
+			break;
+			default:
+				throw std::runtime_error("unknown value");
+				break;
+			}
+			JS::JsSetProperty(params[1], cached.id, ref, true);
+		}
+		JsValueRef ret;
 
-				if (ev.isCancellable) {
-					auto b = Chakra::GetBoolProperty(params[1], L"cancel");
-					if (b) return true;
-				}
+		//int refc1 = Chakra::GetRefCount(l.first);
+		//int refc = Chakra::GetRefCount(params[1]);
+		handleErrors(Chakra::CallFunction(std::get<1>(l), params, 2, &ret));
 
-				Chakra::Release(ret);
-				Chakra::Release(params[1]);
-				//Chakra::Release(params[0]);
+		if (ev.isCancellable) {
+			auto b = Chakra::GetBoolProperty(params[1], L"cancel");
+			if (b) {
+				releaseCache();
+				return true;
 			}
-			break;
 		}
+
+		Chakra::Release(ret);
+		Chakra::Release(params[1]);
+		//Chakra::Release(params[0]);
 	}
+	releaseCache();
 	return false;
 }
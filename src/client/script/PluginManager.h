@@ -2,12 +2,16 @@
 #include "ScriptingObject.h"
 #include "api/manager/Manager.h"
 #include "api/eventing/Listenable.h"
+#include "BytecodeCache.h"
+#include "ChakraWorkerRuntime.h"
 #include <queue>
 #include <variant>
 
 class PluginManager final : public Listener, public Manager<class JsPlugin> {
 private:
 	std::queue<std::shared_ptr<class JsPlugin>> scriptCheckQueue = {};
+	std::unique_ptr<BytecodeCache> bytecodeCache;
+	std::unique_ptr<WorkerPool<ChakraWorkerRuntime>> workerPool;
 public:
 	PluginManager();
 
@@ -43,6 +47,11 @@ public:
 	bool hasPermission(JsPlugin* script, Permission perm);
 	static bool scriptingSupported();
 
+	// Parsed scripts from previous loads; null until init()
+	[[nodiscard]] BytecodeCache* getBytecodeCache() { return bytecodeCache.get(); }
+	// Threads that run plugin worker scripts, started on first use. Workers are owned by the JsScript that created them.
+	[[nodiscard]] WorkerPool<ChakraWorkerRuntime>* getWorkerPool();
+
 	using event_callback_t = void(__fastcall*)(JsValueRef func);
 
 	struct Event {
@@ -52,11 +61,13 @@ public:
 				Number = 1, 
 				String, 
 				EntityRef, 
-				Bool
+				Bool,
+				// UTF-8 string borrowed from the caller (e.g. a packet); only valid for the dispatch
+				StringView,
 			};
 
 			std::wstring name;
-			std::variant<std::nullptr_t, double, std::wstring, int64_t, bool> val = nullptr;
+			std::variant<std::nullptr_t, double, std::wstring, int64_t, bool, std::string_view> val = nullptr;
 
 			Value(std::wstring const& name) : name(name) {
 			}
@@ -71,13 +82,15 @@ public:
 		bool cancel;
 		bool isCancellable;
 
-		Event(const std::wstring& type, const std::vector<Value>& values, bool cancellable)
-			: type(type), values(values), cancel(false), isCancellable(cancellable)
+		Event(const std::wstring& type, std::vector<Value> values, bool cancellable)
+			: type(type), values(std::move(values)), cancel(false), isCancellable(cancellable)
 		{
 		}
 	};
 
 	std::unordered_map<std::wstring, std::vector<std::tuple<int, JsValueRef, JsContextRef>>> eventListeners;
+	// Whether any plugin listens to this event; check first to skip building event values nobody reads
+	[[nodiscard]] bool hasListeners(std::wstring const& type);
 	bool dispatchEvent(Event& ev);
 	void uninitialize();
 };
\ No newline at end of file
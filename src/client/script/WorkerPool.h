@@ -0,0 +1,378 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One thread of a WorkerPool. Only the parts workers need; the pool extends it.
+class WorkerPoolThread {
+public:
+	virtual ~WorkerPoolThread() = default;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::condition_variable doneCv;
+	// the worker whose script is running right now
+	class PooledWorker* current = nullptr;
+	bool stopping = false;
+
+	// Stops the running script, if the runtime can. Called with mutex held.
+	virtual void interrupt() = 0;
+};
+
+// A worker as seen by its owner and by its script: a bounded message queue in each direction, cancellation and metrics.
+class PooledWorker {
+public:
+	struct Metrics {
+		size_t inboxDepth = 0;
+		size_t outboxDepth = 0;
+		uint64_t messagesHandled = 0;
+		std::chrono::nanoseconds busyTime{};
+	};
+
+	PooledWorker(std::shared_ptr<WorkerPoolThread> thread, uintptr_t owner, size_t queueCapacity)
+		: thread(std::move(thread)), owner(owner), queueCapacity(queueCapacity) {}
+	PooledWorker(PooledWorker&) = delete;
+	PooledWorker(PooledWorker&&) = delete;
+
+	// Queues a message for the worker. Returns false if it's cancelled or its inbox is full.
+	bool post(std::string message) {
+		{
+			std::lock_guard lock{ thread->mutex };
+			if (cancelled || inbox.size() >= queueCapacity) return false;
+			inbox.push_back(std::move(message));
+		}
+		thread->cv.notify_all();
+		return true;
+	}
+
+	// Takes the oldest message the worker sent, if any
+	std::optional<std::string> receive() {
+		std::lock_guard lock{ outboxMutex };
+		if (outbox.empty()) return std::nullopt;
+		auto msg = std::move(outbox.front());
+		outbox.pop_front();
+		return msg;
+	}
+
+	// Called by the worker's script. Returns false if the owner isn't keeping up and the outbox is full.
+	bool send(std::string message) {
+		std::lock_guard lock{ outboxMutex };
+		if (outbox.size() >= queueCapacity) return false;
+		outbox.push_back(std::move(message));
+		return true;
+	}
+
+	// Stops the worker after whatever it's running now (interrupting it if the runtime supports that)
+	void cancel() {
+		{
+			std::lock_guard lock{ thread->mutex };
+			if (cancelled) return;
+			cancelled = true;
+			if (thread->current == this) thread->interrupt();
+		}
+		thread->cv.notify_all();
+	}
+
+	[[nodiscard]] bool isCancelled() const { return cancelled; }
+	// Whether the worker's state is gone and it will never run again
+	[[nodiscard]] bool isFinished() const { return finished; }
+	[[nodiscard]] uintptr_t getOwner() const { return owner; }
+
+	[[nodiscard]] Metrics getMetrics() {
+		Metrics metrics;
+		{
+			std::lock_guard lock{ thread->mutex };
+			metrics.inboxDepth = inbox.size();
+			metrics.messagesHandled = handled;
+			metrics.busyTime = busyTime;
+		}
+		std::lock_guard lock{ outboxMutex };
+		metrics.outboxDepth = outbox.size();
+		return metrics;
+	}
+private:
+	template <typename Runtime>
+	friend class WorkerPool;
+
+	std::shared_ptr<WorkerPoolThread> thread;
+	uintptr_t owner;
+	size_t queueCapacity;
+
+	// guarded by thread->mutex
+	std::deque<std::string> inbox;
+	bool started = false;
+	uint64_t handled = 0;
+	std::chrono::nanoseconds busyTime{};
+
+	std::mutex outboxMutex;
+	std::deque<std::string> outbox;
+
+	std::atomic<bool> cancelled = false;
+	std::atomic<bool> finished = false;
+};
+
+// A fixed number of threads, each owning one long-lived script runtime, that run workers created by plugins.
+// Workers are pinned to one thread (their state lives in that thread's runtime) and only talk to their owner
+// through PooledWorker's queues, so a plugin can't spawn threads or runtimes of its own.
+//
+// The pool doesn't know about any script engine. Runtime must provide:
+//   using Script = ...;  using State = ...;
+//   std::unique_ptr<State> start(PooledWorker& worker, Script const& script);   // nullptr on failure
+//   void message(State& state, PooledWorker& worker, std::string const& message);
+// and optionally void interrupt(), which may be called from any thread to stop the script that's running, with
+// void resume() to undo it. resume() is called on the runtime's thread before each script runs, under the same lock
+// cancel() takes, so a cancel can't land between the two and be lost.
+// Runtimes are created, used and destroyed on their own thread, and a worker's state is always destroyed
+// there too, before its runtime.
+//
+// Cancellation is cooperative: a cancelled worker runs nothing more, and scripts can poll isCancelled().
+// join() blocks until the given owner's workers have finished, so a plugin can be unloaded deterministically.
+template <typename Runtime>
+class WorkerPool {
+public:
+	using Script = typename Runtime::Script;
+	using State = typename Runtime::State;
+	using RuntimeFactory = std::function<std::unique_ptr<Runtime>()>;
+
+	WorkerPool(size_t threadCount, RuntimeFactory factory, size_t maxWorkersPerOwner = 8, size_t queueCapacity = 1024)
+		: factory(std::move(factory)), maxWorkersPerOwner(maxWorkersPerOwner), queueCapacity(queueCapacity) {
+		threadCount = std::max<size_t>(threadCount, 1);
+		for (size_t i = 0; i < threadCount; i++) {
+			auto slot = std::make_shared<Slot>();
+			slot->thread = std::thread([this, slot] { run(*slot); });
+			slots.push_back(std::move(slot));
+		}
+	}
+
+	WorkerPool(WorkerPool&) = delete;
+	WorkerPool(WorkerPool&&) = delete;
+
+	// Cancels every worker and waits for the threads to exit
+	~WorkerPool() {
+		for (auto& slot : slots) {
+			{
+				std::lock_guard lock{ slot->mutex };
+				slot->stopping = true;
+				for (auto& entry : slot->entries) {
+					entry.worker->cancelled = true;
+				}
+				slot->interrupt();
+			}
+			slot->cv.notify_all();
+		}
+		for (auto& slot : slots) {
+			if (slot->thread.joinable()) slot->thread.join();
+		}
+	}
+
+	// Returns nullptr if the owner already has the maximum number of workers
+	std::shared_ptr<PooledWorker> create(uintptr_t owner, Script script) {
+		std::lock_guard createLock{ createMutex };
+		if (countWorkers(owner) >= maxWorkersPerOwner) return nullptr;
+
+		// the least busy thread gets it
+		std::shared_ptr<Slot> slot;
+		size_t fewest = SIZE_MAX;
+		for (auto& candidate : slots) {
+			std::lock_guard lock{ candidate->mutex };
+			if (candidate->entries.size() < fewest) {
+				fewest = candidate->entries.size();
+				slot = candidate;
+			}
+		}
+
+		auto worker = std::make_shared<PooledWorker>(slot, owner, queueCapacity);
+		{
+			std::lock_guard lock{ slot->mutex };
+			if (slot->stopping) return nullptr;
+			slot->entries.push_back({ worker, std::move(script), nullptr });
+		}
+		slot->cv.notify_all();
+		return worker;
+	}
+
+	void cancel(uintptr_t owner) {
+		for (auto& slot : slots) {
+			std::vector<std::shared_ptr<PooledWorker>> owned;
+			{
+				std::lock_guard lock{ slot->mutex };
+				for (auto& entry : slot->entries) {
+					if (entry.worker->owner == owner) owned.push_back(entry.worker);
+				}
+			}
+			for (auto& worker : owned) worker->cancel();
+		}
+	}
+
+	// Cancels the owner's workers and blocks until all of them are finished
+	void join(uintptr_t owner) {
+		cancel(owner);
+		for (auto& slot : slots) {
+			std::unique_lock lock{ slot->mutex };
+			slot->doneCv.wait(lock, [&] { return slot->count(owner) == 0; });
+		}
+	}
+
+	[[nodiscard]] size_t countWorkers(uintptr_t owner) {
+		size_t count = 0;
+		for (auto& slot : slots) {
+			std::lock_guard lock{ slot->mutex };
+			count += slot->count(owner);
+		}
+		return count;
+	}
+
+	[[nodiscard]] size_t getThreadCount() const { return slots.size(); }
+private:
+	struct Entry {
+		std::shared_ptr<PooledWorker> worker;
+		Script script;
+		// only touched by the slot's thread
+		std::unique_ptr<State> state;
+	};
+
+	struct Slot : WorkerPoolThread {
+		std::vector<Entry> entries;
+		Runtime* runtime = nullptr;
+		size_t next = 0;
+		std::thread thread;
+
+		void interrupt() override {
+			if constexpr (requires(Runtime& rt) { rt.interrupt(); }) {
+				if (runtime && current) runtime->interrupt();
+			}
+		}
+
+		[[nodiscard]] size_t count(uintptr_t owner) const {
+			return std::count_if(entries.begin(), entries.end(), [&](Entry const& entry) { return entry.worker->owner == owner; });
+		}
+	};
+
+	// Finds the next worker with something to do, round robin. Call with the slot's mutex held.
+	static std::optional<size_t> pick(Slot& slot) {
+		size_t count = slot.entries.size();
+		for (size_t i = 0; i < count; i++) {
+			size_t idx = (slot.next + i) % count;
+			auto& worker = *slot.entries[idx].worker;
+			if (worker.cancelled || !worker.started || !worker.inbox.empty()) {
+				slot.next = idx + 1;
+				return idx;
+			}
+		}
+		return std::nullopt;
+	}
+
+	void run(Slot& slot) {
+		// warmed up once and reused by every worker on this thread
+		std::unique_ptr<Runtime> runtime;
+		try {
+			runtime = factory();
+		}
+		catch (...) {
+		}
+
+		std::unique_lock lock{ slot.mutex };
+		slot.runtime = runtime.get();
+
+		while (true) {
+			std::optional<size_t> idx;
+			slot.cv.wait(lock, [&] { return (idx = pick(slot)).has_value() || slot.stopping; });
+			if (!idx) break;
+
+			auto worker = slot.entries[*idx].worker;
+			if (worker->cancelled || !runtime) {
+				finish(slot, lock, *idx);
+				continue;
+			}
+
+			std::optional<std::string> message;
+			bool starting = !worker->started;
+			if (starting) {
+				worker->started = true;
+			}
+			else {
+				message = std::move(worker->inbox.front());
+				worker->inbox.pop_front();
+			}
+
+			// entries can be added while unlocked, so don't hold references into the vector.
+			// The script is only needed to start the worker.
+			std::optional<Script> script;
+			if (starting) script = std::move(slot.entries[*idx].script);
+			auto state = std::move(slot.entries[*idx].state);
+			if constexpr (requires(Runtime& rt) { rt.resume(); }) {
+				runtime->resume();
+			}
+			slot.current = worker.get();
+			lock.unlock();
+
+			auto start = std::chrono::steady_clock::now();
+			bool failed = false;
+			try {
+				if (starting) {
+					state = runtime->start(*worker, *script);
+					failed = state == nullptr;
+				}
+				else {
+					runtime->message(*state, *worker, *message);
+				}
+			}
+			catch (...) {
+				failed = true;
+			}
+			auto elapsed = std::chrono::steady_clock::now() - start;
+
+			lock.lock();
+			slot.current = nullptr;
+			find(slot, *worker).state = std::move(state);
+			worker->busyTime += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+			if (!starting) worker->handled++;
+			if (failed) worker->cancelled = true;
+		}
+
+		// stopping: everything left was cancelled by the destructor
+		while (!slot.entries.empty()) {
+			finish(slot, lock, slot.entries.size() - 1);
+		}
+		slot.runtime = nullptr;
+		lock.unlock();
+		runtime.reset();
+	}
+
+	static Entry& find(Slot& slot, PooledWorker& worker) {
+		return *std::find_if(slot.entries.begin(), slot.entries.end(), [&](Entry const& entry) { return entry.worker.get() == &worker; });
+	}
+
+	// Destroys the worker's state on this thread, then drops it. Call with the slot's mutex held.
+	// The entry stays in the slot until its state is gone, so join() can't return while it's still being destroyed.
+	static void finish(Slot& slot, std::unique_lock<std::mutex>& lock, size_t idx) {
+		auto worker = slot.entries[idx].worker;
+		auto state = std::move(slot.entries[idx].state);
+		worker->inbox.clear();
+
+		lock.unlock();
+		state.reset();
+		lock.lock();
+
+		// entries can be added while unlocked, so find it again
+		slot.entries.erase(std::find_if(slot.entries.begin(), slot.entries.end(), [&](Entry const& entry) { return entry.worker == worker; }));
+		worker->finished = true;
+		slot.doneCv.notify_all();
+	}
+
+	RuntimeFactory factory;
+	size_t maxWorkersPerOwner;
+	size_t queueCapacity;
+	std::mutex createMutex;
+	std::vector<std::shared_ptr<Slot>> slots;
+};
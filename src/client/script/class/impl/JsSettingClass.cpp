@@ -98,6 +98,7 @@ JsValueRef JsSettingClass::setValueCallback(JsValueRef callee, bool isConstructo
 	case Setting::Type::Key:
 		if (argType == JsNumber) {
 			std::get<KeyValue>(*set->value).value = Chakra::GetInt(setVal);
+			set->update();
 		}
 		return undef;
 	case Setting::Type::Vec2:
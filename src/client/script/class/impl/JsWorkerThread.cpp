@@ -1,34 +1,107 @@
 #include "pch.h"
 #include "JsWorkerThread.h"
+#include "../../JsScript.h"
+#include "../../PluginManager.h"
+#include "../../ChakraWorkerRuntime.h"
+#include "client/Latite.h"
 
 JsValueRef JsWorkerThread::loadFile(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
 	auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
 	if (!Chakra::VerifyArgCount(argCount, 2)) return JS_INVALID_REFERENCE;
 	if (!Chakra::VerifyParameters({ {arguments[1], JsString} })) return JS_INVALID_REFERENCE;
 
-	auto path = util::GetLatitePath() / "Scripts" / thi->owner->relFolderPath / Chakra::GetString(arguments[1]);
-	std::ifstream ifs;
-	ifs.open(path);
+	auto name = Chakra::GetString(arguments[1]);
+	auto folder = thi->owner->getFolderPath().lexically_normal();
+	auto path = (folder / name).lexically_normal();
+	auto rel = path.lexically_relative(folder);
+	if (rel.empty() || *rel.begin() == L"..") {
+		Chakra::ThrowError(L"Worker scripts must be inside the plugin folder");
+		return JS_INVALID_REFERENCE;
+	}
+
+	std::ifstream ifs{ path, std::ios::binary };
 	if (ifs.fail()) {
 		Chakra::ThrowError(L"Could not open file " + path.wstring() + L" for reading");
 		return JS_INVALID_REFERENCE;
 	}
+	std::string source{ std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+
+	auto pool = Latite::getPluginManager().getWorkerPool();
+	if (!pool) {
+		Chakra::ThrowError(L"Worker threads are not available");
+		return JS_INVALID_REFERENCE;
+	}
+
+	auto worker = pool->create(reinterpret_cast<uintptr_t>(thi->owner), { utf::toWide(source), name });
+	if (!worker) {
+		Chakra::ThrowError(L"This script has too many worker threads");
+		return JS_INVALID_REFERENCE;
+	}
+	return thi->construct(std::move(worker));
+}
+
+JsValueRef JsWorkerThread::postMessageCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
+	if (!Chakra::VerifyArgCount(argCount, 2)) return JS_INVALID_REFERENCE;
+	if (!Chakra::VerifyParameters({ {arguments[1], JsString} })) return JS_INVALID_REFERENCE;
+
+	auto worker = thi->ToWorker(arguments[0]);
+	if (!worker) return JS_INVALID_REFERENCE;
+	return worker->post(util::WStrToStr(Chakra::GetString(arguments[1]))) ? Chakra::GetTrue() : Chakra::GetFalse();
+}
+
+JsValueRef JsWorkerThread::receiveCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
+	auto worker = thi->ToWorker(arguments[0]);
+	if (!worker) return JS_INVALID_REFERENCE;
+
+	std::vector<std::string> messages;
+	while (auto msg = worker->receive()) {
+		messages.push_back(std::move(*msg));
+	}
+
+	JsValueRef array;
+	JS::JsCreateArray(static_cast<unsigned>(messages.size()), &array);
+	for (size_t i = 0; i < messages.size(); i++) {
+		JS::JsSetIndexedProperty(array, Chakra::MakeInt(static_cast<int>(i)), Chakra::MakeString(std::string_view(messages[i])));
+	}
+	return array;
+}
+
+JsValueRef JsWorkerThread::terminateCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
+	auto worker = thi->ToWorker(arguments[0]);
+	if (!worker) return JS_INVALID_REFERENCE;
 
-	auto thread = new std::thread(threadMain);
-	return thi->construct(thread);
+	worker->cancel();
+	return Chakra::GetUndefined();
 }
 
-void JsWorkerThread::threadMain(std::wstring script) {
-	JsRuntimeHandle handle;
-	JsContextRef context;
-	JsValueRef result;
+JsValueRef JsWorkerThread::getStatsCallback(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
+	auto worker = thi->ToWorker(arguments[0]);
+	if (!worker) return JS_INVALID_REFERENCE;
 
-	JS::JsCreateRuntime(JsRuntimeAttributeDisableBackgroundWork, nullptr, &handle);
-	JS::JsCreateContext(handle, &context);
+	auto metrics = worker->getMetrics();
+	JsValueRef obj;
+	JS::JsCreateObject(&obj);
+	Chakra::SetPropertyNumber(obj, L"inboxDepth", static_cast<double>(metrics.inboxDepth));
+	Chakra::SetPropertyNumber(obj, L"outboxDepth", static_cast<double>(metrics.outboxDepth));
+	Chakra::SetPropertyNumber(obj, L"messagesHandled", static_cast<double>(metrics.messagesHandled));
+	Chakra::SetPropertyNumber(obj, L"busyTime", std::chrono::duration<double, std::milli>(metrics.busyTime).count());
+	Chakra::SetPropertyBool(obj, L"running", !worker->isFinished());
+	return obj;
+}
 
-	JS::JsRunScript(script.c_str(), util::fnv1a_64w(script), L"<worker thread>", &result);
+PooledWorker* JsWorkerThread::ToWorker(JsValueRef obj) {
+	JsValueRef proto = JS_INVALID_REFERENCE;
+	bool same = false;
+	if (JS::JsGetPrototype(obj, &proto) == JsNoError) JS::JsStrictEquals(proto, getPrototype(), &same);
 
-	JS::JsRelease(result, nullptr);
-	JS::JsCollectGarbage(handle);
-	JS::JsDisposeRuntime(handle);
+	auto worker = same ? Get(obj) : nullptr;
+	if (!worker || !*worker) {
+		Chakra::ThrowError(std::wstring(L"Object is not a ") + name);
+		return nullptr;
+	}
+	return worker->get();
 }
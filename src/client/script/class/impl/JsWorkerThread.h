@@ -1,43 +1,57 @@
 #pragma once
 #include "../JsWrapperClass.h"
+#include "../../WorkerPool.h"
 
-class JsWorkerThread : public JsWrapperClass<std::thread> {
+// A worker script running on the plugin manager's worker pool. Scripts get one with Thread.loadFile(path)
+// and talk to it with postMessage/receive; it's cancelled when terminated, collected, or the plugin unloads.
+class JsWorkerThread : public JsWrapperClass<std::shared_ptr<PooledWorker>> {
 	static JsValueRef CALLBACK jsConstructor(JsValueRef callee, bool isConstructor,
 		JsValueRef* arguments, unsigned short argCount, void* callbackState) {
 		auto thi = reinterpret_cast<JsWorkerThread*>(callbackState);
-		throw thi->errNoConstruct();
+		return thi->errNoConstruct();
 	}
 
 	static JsValueRef CALLBACK loadFile(JsValueRef callee, bool isConstructor,
 		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	static JsValueRef CALLBACK postMessageCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	static JsValueRef CALLBACK receiveCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	static JsValueRef CALLBACK terminateCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	static JsValueRef CALLBACK getStatsCallback(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
 
-	static void threadMain(std::wstring script);
+	// Null (with a JS error set) if `obj` isn't a Thread
+	PooledWorker* ToWorker(JsValueRef obj);
 public:
 
 	inline static const wchar_t* class_name = L"Thread";
 
 	JsWorkerThread(class JsScript* owner) : JsWrapperClass(owner, class_name) {
 		createConstructor(jsConstructor, this);
-		Chakra::DefineFunc(constructor, loadFile, L"loadFile", this);
 	}
 
-	JsValueRef construct(std::thread* thread) {
+	JsValueRef construct(std::shared_ptr<PooledWorker> worker) {
 		JsValueRef obj;
-		JS::JsCreateExternalObject(thread, [](void* obj) {
-			reinterpret_cast<std::thread*>(obj)->join();
-			delete reinterpret_cast<std::thread*>(obj);
+		JS::JsCreateExternalObject(new std::shared_ptr<PooledWorker>(std::move(worker)), [](void* obj) {
+			auto worker = reinterpret_cast<std::shared_ptr<PooledWorker>*>(obj);
+			(*worker)->cancel();
+			delete worker;
 			}, &obj);
 		JS::JsSetPrototype(obj, getPrototype());
 		return obj;
 	}
 
 	void prepareFunctions() override {
+		// Static functions
+		Chakra::DefineFunc(constructor, loadFile, L"loadFile", this);
+
+		// Member functions
 		Chakra::DefineFunc(prototype, this->defaultToString, L"toString", this);
+		Chakra::DefineFunc(prototype, postMessageCallback, L"postMessage", this);
+		Chakra::DefineFunc(prototype, receiveCallback, L"receive", this);
+		Chakra::DefineFunc(prototype, terminateCallback, L"terminate", this);
+		Chakra::DefineFunc(prototype, getStatsCallback, L"getStats", this);
 	};
-
-	static std::thread& ToThread(JsValueRef obj) {
-		std::thread* thread = nullptr;
-		JS::JsGetExternalData(obj, reinterpret_cast<void**>(&thread));
-		return *thread;
-	}
-};
\ No newline at end of file
+};
@@ -10,7 +10,7 @@ JsTexture::JsTexture(std::wstring const& textureNameOrPath, bool gameTexture) {
 
 	if (gameTexture) return;
 
-	// FIXME: same as above
+	// the script's finalizer can delete this before the job runs; the destructor cancels it
 	Latite::get().queueForDXRender([this, path](ID2D1DeviceContext* ctx) {
 
 		ComPtr<IWICBitmapDecoder> pDecoder = NULL;
@@ -43,7 +43,11 @@ JsTexture::JsTexture(std::wstring const& textureNameOrPath, bool gameTexture) {
 		if (FAILED(ctx->CreateBitmapFromWicBitmap(conv.Get(), NULL, this->d2dTexture.GetAddressOf()))) {
 			this->failed = true;
 		}
-		});
+		}, { .priority = JobPriority::Low, .owner = reinterpret_cast<uintptr_t>(this) });
+}
+
+JsTexture::~JsTexture() {
+	Latite::get().cancelQueuedJobs(this);
 }
 
 void JsTexture::loadMinecraft() {
@@ -111,7 +111,7 @@ void ClientScriptingObject::initialize(JsContextRef ctx, JsValueRef parentObj) {
 	Chakra::DefineFunc(commandManager, cmgrRegisterCommandCallback, XW("registerCommand"));
 	Chakra::DefineFunc(commandManager, cmgrGetPrefixCallback, XW("getPrefix"));
 
-	Chakra::SetPropertyString(object, L"version", util::StrToWStr(std::string(Latite::version.data(), Latite::version.size())));
+	Chakra::SetPropertyString(object, L"version", utf::toWide(Latite::version));
 }
 
 
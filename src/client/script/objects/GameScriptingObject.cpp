@@ -18,6 +18,7 @@
 #include "../class/impl/game/JsEntityClass.h"
 #include "../class/impl/game/JsPlayerClass.h"
 #include "../class/impl/game/JsLocalPlayerClass.h"
+#include "util/LMathBatch.h"
 #include <sdk/common/network/packet/CommandRequestPacket.h>
 #include <client/script/class/impl/game/JsBlock.h>
 #include <client/script/class/impl/JsVec3.h>
@@ -55,6 +56,7 @@ void GameScriptingObject::createWorldObject() {
 	Chakra::DefineFunc(worldObj, worldExists, XW("exists"), this);
 	Chakra::DefineFunc(worldObj, worldGetEntList, XW("getEntities"), this);
 	Chakra::DefineFunc(worldObj, worldGetEntCount, XW("getEntityCount"), this);
+	Chakra::DefineFunc(worldObj, worldGetEntsNear, XW("getEntitiesNear"), this);
 	Chakra::DefineFunc(worldObj, worldGetPlayers, XW("getPlayers"), this);
 	Chakra::DefineFunc(worldObj, worldGetName, XW("getName"), this);
 	Chakra::DefineFunc(dimensionObj, worldExists, XW("exists"), this);
@@ -118,25 +120,76 @@ JsValueRef GameScriptingObject::worldGetEntList(JsValueRef callee, bool isConstr
 	JS::JsCreateArray(sz, &array);
 	unsigned idx = 0;
 	for (auto& ent : entList) {
-		JsValueRef db;
-		JS::JsDoubleToNumber(static_cast<double>(idx), &db);
-		JsScript* script = JsScript::getThis();
-
-		auto entc = script->getClass<JsEntityClass>();
-		auto plrc = script->getClass<JsPlayerClass>();
-		auto lplrc = script->getClass<JsLocalPlayerClass>();
-
-		if (ent->getRuntimeID() == 1) {
-			JS::JsSetIndexedProperty(array, db, lplrc->construct(new JsEntity(ent->getRuntimeID(), JsEntity::AccessLevel::LocalPlayer), true));
-		} else if (ent->isPlayer()) {
-			JS::JsSetIndexedProperty(array, db, plrc->construct(new JsEntity(ent->getRuntimeID()), true));
-		} else JS::JsSetIndexedProperty(array, db, entc->construct(new JsEntity(ent->getRuntimeID()), true));
+		setEntity(array, idx, ent);
 		idx++;
-		Chakra::Release(db);
 	}
 	return array;
 }
 
+JsValueRef GameScriptingObject::worldGetEntsNear(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
+	if (!Chakra::VerifyArgCount(argCount, 5)) return JS_INVALID_REFERENCE;
+	if (!Chakra::VerifyParameters({ {arguments[1], JsNumber}, {arguments[2], JsNumber}, {arguments[3], JsNumber}, {arguments[4], JsNumber} })) return JS_INVALID_REFERENCE;
+
+	if (!SDK::ClientInstance::get()->getLocalPlayer()) {
+		Chakra::ThrowError(L"World is not available");
+		return Chakra::GetUndefined();
+	}
+
+	JsPlugin* scr = JsScript::getThis()->getPlugin();
+
+	if (!Latite::getPluginManager().hasPermission(scr, PluginManager::Permission::Operator)) {
+		Chakra::ThrowError(util::StrToWStr(XOR_STRING("No permission to use getEntitiesNear here")));
+		return JS_INVALID_REFERENCE;
+	}
+
+	Vec3 pos = { static_cast<float>(Chakra::GetNumber(arguments[1])), static_cast<float>(Chakra::GetNumber(arguments[2])),
+		static_cast<float>(Chakra::GetNumber(arguments[3])) };
+	float range = static_cast<float>(Chakra::GetNumber(arguments[4]));
+
+	auto entList = SDK::ClientInstance::get()->minecraft->getLevel()->getRuntimeActorList();
+
+	// the boxes are laid out as arrays, so every distance comes out of one pass of the batch kernel
+	LatiteMath::batch::AABBArray boxes;
+	boxes.reserve(entList.size());
+	for (auto ent : entList) {
+		boxes.push_back(ent->getBoundingBox());
+	}
+	std::vector<float> distances(entList.size());
+	LatiteMath::batch::aabbDistanceSquared(boxes, pos, distances.data());
+
+	std::vector<size_t> inRange;
+	for (size_t i = 0; i < distances.size(); i++) {
+		if (distances[i] <= range * range) inRange.push_back(i);
+	}
+	std::sort(inRange.begin(), inRange.end(), [&](size_t a, size_t b) { return distances[a] < distances[b]; });
+
+	JsValueRef array;
+	JS::JsCreateArray(static_cast<unsigned>(inRange.size()), &array);
+	unsigned idx = 0;
+	for (auto i : inRange) {
+		setEntity(array, idx, entList[i]);
+		idx++;
+	}
+	return array;
+}
+
+void GameScriptingObject::setEntity(JsValueRef array, unsigned index, SDK::Actor* ent) {
+	JsValueRef db;
+	JS::JsDoubleToNumber(static_cast<double>(index), &db);
+	JsScript* script = JsScript::getThis();
+
+	auto entc = script->getClass<JsEntityClass>();
+	auto plrc = script->getClass<JsPlayerClass>();
+	auto lplrc = script->getClass<JsLocalPlayerClass>();
+
+	if (ent->getRuntimeID() == 1) {
+		JS::JsSetIndexedProperty(array, db, lplrc->construct(new JsEntity(ent->getRuntimeID(), JsEntity::AccessLevel::LocalPlayer), true));
+	} else if (ent->isPlayer()) {
+		JS::JsSetIndexedProperty(array, db, plrc->construct(new JsEntity(ent->getRuntimeID()), true));
+	} else JS::JsSetIndexedProperty(array, db, entc->construct(new JsEntity(ent->getRuntimeID()), true));
+	Chakra::Release(db);
+}
+
 JsValueRef GameScriptingObject::worldGetEntCount(JsValueRef callee, bool isConstructor, JsValueRef* arguments, unsigned short argCount, void* callbackState) {
 	if (!SDK::ClientInstance::get()->getLocalPlayer()) {
 		Chakra::ThrowError(XW("World is not available"));
@@ -67,6 +67,11 @@ private:
 		JsValueRef* arguments, unsigned short argCount, void* callbackState);
 	static JsValueRef CALLBACK worldGetEntCount(JsValueRef callee, bool isConstructor,
 		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	// Entities whose bounding box is within a range of a point, nearest first
+	static JsValueRef CALLBACK worldGetEntsNear(JsValueRef callee, bool isConstructor,
+		JsValueRef* arguments, unsigned short argCount, void* callbackState);
+	// Sets array[index] to the script object for an entity (local player, player or other entity)
+	static void setEntity(JsValueRef array, unsigned index, SDK::Actor* ent);
 
 	static JsValueRef CALLBACK dimensionGetName(JsValueRef callee, bool isConstructor,
 		JsValueRef* arguments, unsigned short argCount, void* callbackState);
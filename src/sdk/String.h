@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 
 template <size_t S>
 // WARNING: This does not destroy itself.
@@ -59,6 +60,11 @@ public:
 		return std::string(getCStr());
 	}
 
+	// Borrows the string without copying; only valid while this string is
+	[[nodiscard]] std::string_view view() const {
+		return std::string_view(getCStr(), textSize);
+	}
+
 	void release() {
 		if (textSize >= S) {
 			free(ptr);
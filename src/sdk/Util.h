@@ -1,6 +1,10 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include "Version.h"
 
 namespace SDK {
@@ -29,75 +33,78 @@ namespace util {
 }
 
 namespace SDK {
-	template <int offs_1_21_20, int offs_1_20_50, int offs_1_20_40, int offs_1_20_30, int offs_1_18_12, int offs_1_19_51>
-		extern inline const int mvGetOffset() {
-		switch (SDK::internalVers) {
-		case SDK::V1_21_20:
-		default:
-			return offs_1_21_20;
-		case SDK::V1_20_50:
-			return offs_1_20_50;
-		case SDK::V1_20_40:
-			return offs_1_20_40;
-		case SDK::V1_20_30:
-			return offs_1_20_30;
-		case SDK::V1_19_51:
-			return offs_1_19_51;
-			break;
-		case SDK::V1_18_12:
-			return offs_1_18_12;
+	// The versions a field can have its own offset for, in the order MVCLASS_FIELD and mvGetOffset take them.
+	// A field can leave out the newest ones, which then use the newest offset it does give.
+	inline constexpr Version layoutVersions[] = { V1_21_20, V1_20_50, V1_20_40, V1_20_30, V1_18_12, V1_19_51 };
+	inline constexpr size_t layout_count = std::size(layoutVersions);
+
+	[[nodiscard]] constexpr bool hasLayout(int version) {
+		for (auto vers : layoutVersions) {
+			if (vers == version) return true;
 		}
+		return false;
 	}
-	
-	template <int offs_1_20_50, int offs_1_20_40, int offs_1_20_30, int offs_1_18_12, int offs_1_19_51>
-	extern inline const int mvGetOffset() {
-		switch (SDK::internalVers) {
-		case SDK::V1_20_50:
-		default:
-			return offs_1_20_50;
-		case SDK::V1_20_40:
-			return offs_1_20_40;
-		case SDK::V1_20_30:
-			return offs_1_20_30;
-		case SDK::V1_19_51:
-			return offs_1_19_51;
-			break;
-		case SDK::V1_18_12:
-			return offs_1_18_12;
+
+	// Versions without a layout of their own use the newest one
+	[[nodiscard]] constexpr size_t getLayoutColumn(int version) {
+		for (size_t i = 0; i < layout_count; i++) {
+			if (layoutVersions[i] == version) return i;
 		}
+		return 0;
 	}
 
-	template <int offs_1_20_40, int offs_1_20_30, int offs_1_18_12, int offs_1_19_51>
-	extern inline const int mvGetOffset() {
-		switch (SDK::internalVers) {
-		case SDK::V1_20_40:
-		default:
-			return offs_1_20_40;
-		case SDK::V1_20_30:
-			return offs_1_20_30;
-		case SDK::V1_19_51:
-			return offs_1_19_51;
-			break;
-		case SDK::V1_18_12:
-			return offs_1_18_12;
+	static_assert([] {
+		for (auto& supported : supportedVersions) {
+			if (!hasLayout(supported.version)) return false;
 		}
+		return true;
+		}(), "every supported version needs a column in layoutVersions");
+
+	// The column of every offset table that's in use. It only changes in selectLayout, once the game version is known,
+	// so reading a field is a load from a constant table instead of a switch over the version.
+	inline size_t activeLayout = getLayoutColumn(VLATEST);
+
+	inline void selectLayout(int version) {
+		activeLayout = getLayoutColumn(version);
 	}
 
-	// TODO: keep note of this
-	template <int offs_1_20_30, int offs_1_18_12, int offs_1_19_51>
-	extern inline const int mvGetOffset() {
-		switch (SDK::internalVers) {
-		case SDK::V1_20_30:
-		default:
-			return offs_1_20_30;
-			break;
-		case SDK::V1_19_51:
-			return offs_1_19_51;
-			break;
-		case SDK::V1_18_12:
-			return offs_1_18_12;
-			break;
+	template <int... offsets>
+	[[nodiscard]] constexpr std::array<int, layout_count> makeLayoutTable() {
+		static_assert(sizeof...(offsets) >= 1 && sizeof...(offsets) <= layout_count, "a field needs an offset for at least the oldest layouts, and at most one per layout");
+		constexpr int given[] = { offsets... };
+		constexpr size_t missing = layout_count - sizeof...(offsets);
+		std::array<int, layout_count> table{};
+		for (size_t i = 0; i < layout_count; i++) {
+			table[i] = given[i < missing ? 0 : i - missing];
 		}
+		return table;
+	}
+
+	template <int... offsets>
+	inline constexpr std::array<int, layout_count> layoutTable = makeLayoutTable<offsets...>();
+
+	template <int... offsets>
+	[[nodiscard]] inline int mvGetOffset() {
+		return layoutTable<offsets...>[activeLayout];
+	}
+
+	// For code instantiated per layout by withLayout, where the column is a constant
+	template <size_t column, int... offsets>
+	[[nodiscard]] constexpr int mvGetOffsetIn() {
+		return layoutTable<offsets...>[column];
+	}
+
+	// Calls func with the active column as a std::integral_constant<size_t, column>. func is instantiated once per
+	// layout, so a hot loop inside it can use mvGetOffsetIn (or a field's __get_field_in_) with no lookups at all.
+	template <typename Func>
+	decltype(auto) withLayout(Func&& func) {
+		return [&]<size_t... columns>(std::index_sequence<columns...>) -> decltype(auto) {
+			using Result = decltype(func(std::integral_constant<size_t, 0>{}));
+			static constexpr Result(*perLayout[])(Func&) = {
+				[](Func& f) -> Result { return f(std::integral_constant<size_t, columns>{}); }...
+			};
+			return perLayout[activeLayout](func);
+		}(std::make_index_sequence<layout_count>{});
 	}
 }
 
@@ -108,4 +115,5 @@ namespace SDK {
 
 #define MVCLASS_FIELD(type, name, ...) __declspec(property(get = __get_field_##name, put = __set_field_##name)) type name;                             \
 	type& __get_field_##name() const { return util::directAccess<type>(this, SDK::mvGetOffset<__VA_ARGS__>()); }                                    \
-	template<typename T> void __set_field_##name(const T& value) { util::directAccess<type>(this, (SDK::mvGetOffset<__VA_ARGS__>())) = value; }
+	template<typename T> void __set_field_##name(const T& value) { util::directAccess<type>(this, (SDK::mvGetOffset<__VA_ARGS__>())) = value; }    \
+	template<size_t column> type& __get_field_in_##name() const { return util::directAccess<type>(this, SDK::mvGetOffsetIn<column, __VA_ARGS__>()); }
@@ -1,4 +1,6 @@
 #pragma once
+#include <string_view>
+
 namespace SDK {
 	enum Version {
 		// Format: major, minor, # of revision released
@@ -20,4 +22,27 @@ namespace SDK {
 	};
 
 	extern int internalVers;
+
+	struct SupportedVersion {
+		std::string_view name;
+		Version version;
+	};
+
+	// Game versions Latite runs on, and the SDK version each one uses
+	inline constexpr SupportedVersion supportedVersions[] = {
+		{ "1.21.20", VLATEST },
+		{ "1.21.21", VLATEST },
+		//{ "1.21.0", V1_21 },
+		//{ "1.21.1", V1_21 },
+		//{ "1.21.2", V1_21 },
+		//{ "1.20.41", V1_20_40 },
+		//{ "1.20.40", V1_20_40 },
+		//{ "1.20.32", V1_20_30 },
+		//{ "1.20.31", V1_20_30 },
+		//{ "1.20.30", V1_20_30 },
+		//{ "1.19.50", V1_19_51 },
+		//{ "1.19.51", V1_19_51 },
+		//{ "1.18.12", V1_18_12 },
+		//{ "1.18.10", V1_18_12 },
+	};
 }
@@ -0,0 +1,146 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "Logger.h"
+
+// A single background worker with a bounded queue, for work that shouldn't run on the game or render thread.
+// When the queue is full, push() either drops the new item or replaces the oldest queued one, so a burst
+// of work can't grow memory without bound. Dropped items are handed to the drop handler (if set) so their
+// resources can be recycled.
+//
+// The worker thread starts with the first push, and stop() ends it for good; after that, everything pushed is dropped.
+// The destructor stops it too, but that waits for the thread, so anything torn down from DllMain has to stop earlier.
+template <typename T>
+class BoundedWorkQueue {
+public:
+	enum class FullPolicy {
+		DropNewest,
+		ReplaceOldest,
+	};
+
+	struct Stats {
+		uint64_t queued = 0;
+		uint64_t dropped = 0;
+		uint64_t processed = 0;
+		// items whose handler threw; they're logged and counted here instead of taking the thread (and the game) down
+		uint64_t failed = 0;
+	};
+
+	// onExit is called on the worker thread just before it exits, to clean up anything the handler set up there
+	BoundedWorkQueue(size_t capacity, FullPolicy policy, std::function<void(T&)> handler, std::function<void(T&)> onDrop = {},
+		std::function<void()> onExit = {})
+		: capacity(capacity > 0 ? capacity : 1), policy(policy), handler(std::move(handler)), onDrop(std::move(onDrop)), onExit(std::move(onExit)) {
+	}
+
+	BoundedWorkQueue(BoundedWorkQueue&) = delete;
+	BoundedWorkQueue(BoundedWorkQueue&&) = delete;
+
+	~BoundedWorkQueue() {
+		stop();
+	}
+
+	// Finishes the queued items, then stops the worker and waits for it. Safe to call more than once.
+	void stop() {
+		std::thread thread;
+		{
+			std::lock_guard lock{ mutex };
+			stopping = true;
+			thread = std::move(worker);
+		}
+		cv.notify_all();
+		if (thread.joinable()) thread.join();
+	}
+
+	// Returns false if the item was dropped because the queue was full (DropNewest) or stopped
+	bool push(T item) {
+		std::unique_lock lock{ mutex };
+		if (stopping) {
+			stats.dropped++;
+			lock.unlock();
+			if (onDrop) onDrop(item);
+			return false;
+		}
+		if (!worker.joinable()) worker = std::thread([this] { run(); });
+
+		if (items.size() >= capacity) {
+			stats.dropped++;
+			if (policy == FullPolicy::DropNewest) {
+				lock.unlock();
+				if (onDrop) onDrop(item);
+				return false;
+			}
+
+			T oldest = std::move(items.front());
+			items.pop_front();
+			items.push_back(std::move(item));
+			stats.queued++;
+			lock.unlock();
+			cv.notify_one();
+			if (onDrop) onDrop(oldest);
+			return true;
+		}
+
+		items.push_back(std::move(item));
+		stats.queued++;
+		lock.unlock();
+		cv.notify_one();
+		return true;
+	}
+
+	[[nodiscard]] Stats getStats() {
+		std::lock_guard lock{ mutex };
+		return stats;
+	}
+
+	[[nodiscard]] size_t pending() {
+		std::lock_guard lock{ mutex };
+		return items.size();
+	}
+private:
+	void run() {
+		while (true) {
+			std::unique_lock lock{ mutex };
+			cv.wait(lock, [this] { return stopping || !items.empty(); });
+			if (items.empty()) break;
+
+			T item = std::move(items.front());
+			items.pop_front();
+			lock.unlock();
+
+			bool ok = false;
+			try {
+				handler(item);
+				ok = true;
+			}
+			catch (std::exception const& e) {
+				Logger::Warn("Work queue item failed: {}", e.what());
+			}
+			catch (...) {
+				Logger::Warn("Work queue item failed with an unknown exception");
+			}
+
+			lock.lock();
+			stats.processed++;
+			if (!ok) stats.failed++;
+		}
+		if (onExit) onExit();
+	}
+
+	size_t capacity;
+	FullPolicy policy;
+	std::function<void(T&)> handler;
+	std::function<void(T&)> onDrop;
+	std::function<void()> onExit;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<T> items;
+	Stats stats{};
+	bool stopping = false;
+	std::thread worker;
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Little-endian integers, LEB128 varints and length-prefixed strings, for the client's small binary formats
+// (event traces, the bytecode cache).
+namespace util {
+	class ByteWriter {
+	public:
+		explicit ByteWriter(std::vector<uint8_t>& out) : out(out) {}
+
+		void putU8(uint8_t val) {
+			out.push_back(val);
+		}
+
+		void putU32(uint32_t val) {
+			for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(val >> (i * 8)));
+		}
+
+		void putVarint(uint64_t val) {
+			while (val >= 0x80) {
+				out.push_back(static_cast<uint8_t>(val) | 0x80);
+				val >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(val));
+		}
+
+		// zigzag encoded, so small negative numbers stay small
+		void putSVarint(int64_t val) {
+			putVarint((static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63));
+		}
+
+		void putString(std::string_view str) {
+			putVarint(str.size());
+			out.insert(out.end(), str.begin(), str.end());
+		}
+
+		void putBytes(uint8_t const* data, size_t size) {
+			out.insert(out.end(), data, data + size);
+		}
+	private:
+		std::vector<uint8_t>& out;
+	};
+
+	// Bounds-checked reader. Once a read fails, every following read fails too; check ok() at the end.
+	class ByteReader {
+	public:
+		ByteReader(uint8_t const* data, size_t size) : data(data), size(size) {}
+
+		[[nodiscard]] bool ok() const { return good; }
+		[[nodiscard]] bool atEnd() const { return pos >= size; }
+		[[nodiscard]] size_t position() const { return pos; }
+
+		uint8_t getU8() {
+			if (!require(1)) return 0;
+			return data[pos++];
+		}
+
+		uint32_t getU32() {
+			if (!require(4)) return 0;
+			uint32_t val = 0;
+			for (int i = 0; i < 4; i++) val |= static_cast<uint32_t>(data[pos++]) << (i * 8);
+			return val;
+		}
+
+		uint64_t getVarint() {
+			uint64_t val = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				if (!require(1)) return 0;
+				uint8_t byte = data[pos++];
+				val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return val;
+			}
+			good = false;
+			return 0;
+		}
+
+		int64_t getSVarint() {
+			uint64_t val = getVarint();
+			return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+		}
+
+		std::string_view getString() {
+			uint64_t len = getVarint();
+			if (!require(len)) return {};
+			std::string_view ret{ reinterpret_cast<char const*>(data + pos), static_cast<size_t>(len) };
+			pos += static_cast<size_t>(len);
+			return ret;
+		}
+
+		// Returns a pointer to the next `len` bytes and skips over them
+		uint8_t const* getBytes(size_t len) {
+			if (!require(len)) return nullptr;
+			auto ret = data + pos;
+			pos += len;
+			return ret;
+		}
+	private:
+		bool require(uint64_t count) {
+			if (!good || count > size - pos) {
+				good = false;
+				return false;
+			}
+			return true;
+		}
+
+		uint8_t const* data;
+		size_t size;
+		size_t pos = 0;
+		bool good = true;
+	};
+}
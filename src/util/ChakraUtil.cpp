@@ -410,6 +410,18 @@ JsValueRef Chakra::MakeString(std::wstring const& ws) {
 	return str;
 }
 
+JsValueRef Chakra::MakeString(std::string_view utf8) {
+	JsValueRef str;
+	// JsCreateString is ChakraCore only; the system Chakra.dll needs UTF-16
+	if (JS::JsCreateString) {
+		JS::JsCreateString(utf8.data(), utf8.size(), &str);
+		return str;
+	}
+	auto ws = utf::toWide(utf8);
+	JS::JsPointerToString(ws.c_str(), ws.size(), &str);
+	return str;
+}
+
 JsValueRef Chakra::MakeInt(int num) {
 	JsValueRef val;
 	JS::JsIntToNumber(num, &val);
@@ -49,6 +49,7 @@ public:
 	static std::wstring GetTypeName(JsValueType type);
 
 	static JsValueRef MakeString(std::wstring const& ws);
+	static JsValueRef MakeString(std::string_view utf8);
 	static JsValueRef MakeInt(int num);
 	static JsValueRef MakeDouble(double num);
 
@@ -116,6 +117,7 @@ public:
 	FUNC(JsCreateRangeError);
 	FUNC(JsCreateReferenceError);
 	FUNC(JsCreateRuntime);
+	FUNC(JsCreateString);
 	FUNC(JsCreateSymbol);
 	FUNC(JsCreateSyntaxError);
 	//FUNC(JsCreateThreadService);
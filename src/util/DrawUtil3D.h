@@ -1,4 +1,5 @@
 #include "DxContext.h"
+#include "GeometryBatch.h"
 
 namespace SDK {
     class LevelRenderer;
@@ -6,13 +7,20 @@ namespace SDK {
     class MaterialPtr;
 }
 
+// Lines and quads are collected into a pooled GeometryBatch and sent to the tessellator at flush(),
+// one mesh per primitive type.
 class MCDrawUtil3D {
 private:
     SDK::LevelRenderer* levelRenderer;
     SDK::ScreenContext* screenContext;
     SDK::MaterialPtr* material;
+    GeometryBatch* batch;
 public:
     MCDrawUtil3D(SDK::LevelRenderer* renderer, SDK::ScreenContext* ctx, SDK::MaterialPtr* material = nullptr);
+    ~MCDrawUtil3D();
+
+    MCDrawUtil3D(MCDrawUtil3D&) = delete;
+    MCDrawUtil3D(MCDrawUtil3D&&) = delete;
 
     void setMaterial(SDK::MaterialPtr* material) { this->material = material; }
 
@@ -20,5 +28,6 @@ public:
     void drawQuad(Vec3 a, Vec3 b, Vec3 c, Vec3 d, d2d::Color const& col);
     void fillQuad(Vec3 a, Vec3 b, Vec3 c, Vec3 d, d2d::Color const& color);
     void drawBox(AABB const& box, d2d::Color const& color);
+    void fillBox(AABB const& box, d2d::Color const& color);
     void flush();
 };
\ No newline at end of file
@@ -151,37 +151,16 @@ void D2DUtil::drawGaussianBlur(ID2D1Bitmap1* bmp, float intensity) {
 void D2DUtil::drawText(RectF const& rc, std::wstring const& ws, d2d::Color const& color, Renderer::FontSelection font, float size, DWRITE_TEXT_ALIGNMENT alignment, DWRITE_PARAGRAPH_ALIGNMENT verticalAlignment, bool cache, bool hyphen)  {
 	ComPtr<IDWriteTextFormat> fmt = Latite::getRenderer().getTextFormat(font);
 	brush->SetColor(color.get());
-	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, cache)) {
-		layout->SetMaxWidth(rc.getWidth());
-		layout->SetMaxHeight(rc.getHeight());
-		DWRITE_TEXT_RANGE range{};
-		range.startPosition = 0;
-		range.length = static_cast<UINT32>(ws.size());
-		layout->SetFontSize(size, range);
-		layout->SetTextAlignment(alignment);
-		layout->SetParagraphAlignment(verticalAlignment);
-		this->ctx->DrawTextLayout({ rc.getPos().x, rc.getPos().y }, layout, brush);
+	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, size, rc.getWidth(), rc.getHeight(), alignment, verticalAlignment)) {
+		this->ctx->DrawTextLayout({ rc.getPos().x, rc.getPos().y }, layout.Get(), brush);
 	}
 }
 
 Vec2 D2DUtil::getTextSize(std::wstring const& ws, Renderer::FontSelection font, float size, bool tw, bool cache, std::optional<Vec2> bounds) {
 	ComPtr<IDWriteTextFormat> fmt = Latite::getRenderer().getTextFormat(font);
 	auto ss = ctx->GetPixelSize();
-	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, cache)) {
-		if (!bounds.has_value()) {
-			layout->SetMaxWidth(static_cast<float>(ss.width));
-			layout->SetMaxHeight(static_cast<float>(ss.height));
-		}
-		else {
-			layout->SetMaxWidth(bounds->x);
-			layout->SetMaxHeight(bounds->y);
-		}
-		DWRITE_TEXT_RANGE range;
-		range.startPosition = 0;
-		range.length = static_cast<UINT32>(ws.size());
-		layout->SetFontSize(size, range);
-		layout->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_LEADING);
-		layout->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR);
+	Vec2 maxBounds = bounds.value_or(Vec2(static_cast<float>(ss.width), static_cast<float>(ss.height)));
+	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, size, maxBounds.x, maxBounds.y)) {
 		DWRITE_TEXT_METRICS textMetrics;
 		DWRITE_OVERHANG_METRICS overhangs;
 		layout->GetMetrics(&textMetrics);
@@ -198,15 +177,7 @@ Vec2 D2DUtil::getTextSize(std::wstring const& ws, Renderer::FontSelection font,
 d2d::Rect D2DUtil::getTextRect(std::wstring const& ws, Renderer::FontSelection font, float size, float pad, bool cache) {
 	ComPtr<IDWriteTextFormat> fmt = Latite::getRenderer().getTextFormat(font);
 	auto ss = ctx->GetPixelSize();
-	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, cache)) {
-		layout->SetMaxWidth(static_cast<float>(ss.width));
-		layout->SetMaxHeight(static_cast<float>(ss.height));
-		DWRITE_TEXT_RANGE range;
-		range.startPosition = 0;
-		range.length = static_cast<UINT32>(ws.size());
-		layout->SetFontSize(size, range);
-		layout->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_LEADING);
-		layout->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR);
+	if (auto layout = Latite::getRenderer().getLayout(fmt.Get(), ws, size, static_cast<float>(ss.width), static_cast<float>(ss.height))) {
 		DWRITE_TEXT_METRICS metrics;
 		DWRITE_OVERHANG_METRICS overhangs;
 		layout->GetMetrics(&metrics);
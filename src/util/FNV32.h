@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstring>
 #include <string>
+#include <string_view>
 
 namespace util {
 	constexpr uint32_t FNV_PRIME = 16777619u;
@@ -11,27 +12,9 @@ namespace util {
 	constexpr uint64_t FNV_PRIME_64 = 0x100000001b3;
 	constexpr uint64_t FNV_OFFSET_BASIS_64 = 0xcbf29ce484222325;
 
-	// TODO: find a better way to do this without recursion (it slows down builds)
-	namespace detail {
-		inline constexpr uint32_t fnv1a_32_const(char const* s, std::size_t count) {
-			return count ? (fnv1a_32_const(s, count - 1) ^ s[count - 1]) * FNV_PRIME : FNV_OFFSET_BASIS;
-		}
-
-		inline constexpr uint64_t fnv1a_64_const(char const* s, std::size_t count) {
-			return count ? (fnv1a_64_const(s, count - 1) ^ s[count - 1]) * FNV_PRIME_64 : FNV_OFFSET_BASIS_64;
-		}
-
-		inline constexpr uint64_t fnv1_64_const(char const* s, std::size_t count) {
-			uint64_t hash = FNV_OFFSET_BASIS_64;
-			for (std::size_t i = 0; i < count; ++i) {
-				hash *= FNV_PRIME_64;
-				hash ^= static_cast<uint64_t>(s[i]);
-			}
-			return hash;
-		}
-	}
-
-	inline uint32_t fnv1a_32(std::string const& str) {
+	// Plain loops rather than recursion, so hashing a long literal doesn't cost a template-depth's worth of constexpr
+	// calls at build time. Bytes are taken as char, sign extended, like the game's own hashes.
+	inline constexpr uint32_t fnv1a_32(std::string_view str) {
 		uint32_t hash = FNV_OFFSET_BASIS;
 
 		for (char c : str) {
@@ -42,7 +25,7 @@ namespace util {
 		return hash;
 	}
 
-	inline uint64_t fnv1a_64(std::string const& str) {
+	inline constexpr uint64_t fnv1a_64(std::string_view str) {
 		uint64_t hash = FNV_OFFSET_BASIS_64;
 
 		for (char c : str) {
@@ -53,8 +36,8 @@ namespace util {
 		return hash;
 	}
 
-	// TODO: test this
-	inline uint64_t fnv1a_64w(std::wstring const& str) {
+	// Hashes each wchar_t as one value, not byte by byte
+	inline constexpr uint64_t fnv1a_64w(std::wstring_view str) {
 		uint64_t hash = FNV_OFFSET_BASIS_64;
 
 		for (wchar_t c : str) {
@@ -64,6 +47,26 @@ namespace util {
 
 		return hash;
 	}
+
+	namespace detail {
+		inline constexpr uint32_t fnv1a_32_const(char const* s, std::size_t count) {
+			return fnv1a_32(std::string_view(s, count));
+		}
+
+		inline constexpr uint64_t fnv1a_64_const(char const* s, std::size_t count) {
+			return fnv1a_64(std::string_view(s, count));
+		}
+
+		// FNV-1 (multiply, then xor), which is what _fnv64 has always been
+		inline constexpr uint64_t fnv1_64_const(char const* s, std::size_t count) {
+			uint64_t hash = FNV_OFFSET_BASIS_64;
+			for (std::size_t i = 0; i < count; ++i) {
+				hash *= FNV_PRIME_64;
+				hash ^= static_cast<uint64_t>(s[i]);
+			}
+			return hash;
+		}
+	}
 }
 
 constexpr uint32_t operator"" _fnv32(char const* s, std::size_t count) {
@@ -0,0 +1,183 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// A 64-bit hash for runtime keys (strings, text layouts, binary blobs) where FNV is too slow on long input or
+// collides too often. Values aren't stable between builds: use FNV for anything that's stored or has to match the game.
+//
+// Short input is mixed with full 64x64->128 bit multiplies. Past 128 bytes, it takes 64-byte stripes into eight
+// independent lanes with 32x32->64 bit multiplies, which compilers turn into SIMD (pmuludq) on x64.
+namespace util {
+	namespace detail {
+		inline constexpr uint64_t hash_prime_1 = 0x9E3779B185EBCA87ull;
+		inline constexpr uint64_t hash_prime_2 = 0xC2B2AE3D27D4EB4Full;
+		inline constexpr uint64_t hash_prime_3 = 0x165667B19E3779F9ull;
+		inline constexpr uint32_t hash_prime_32 = 0x9E3779B1u;
+
+		inline constexpr size_t stripe_lanes = 8;
+		inline constexpr size_t stripe_size = stripe_lanes * sizeof(uint64_t);
+		inline constexpr size_t stripes_per_block = 16;
+
+		// Each stripe of a block uses the key one lane further along, so identical stripes don't cancel out
+		inline constexpr auto hash_key = [] {
+			std::array<uint64_t, stripe_lanes + stripes_per_block> key{};
+			uint64_t state = 0x243F6A8885A308D3ull;
+			for (auto& k : key) {
+				// splitmix64
+				uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				k = z ^ (z >> 31);
+			}
+			return key;
+		}();
+
+		inline uint64_t read64(unsigned char const* p) {
+			uint64_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint64_t read32(unsigned char const* p) {
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		// Multiplies to 128 bits and folds the halves together
+		inline uint64_t mum(uint64_t a, uint64_t b) {
+#ifdef _MSC_VER
+			uint64_t high;
+			uint64_t low = _umul128(a, b, &high);
+			return low ^ high;
+#else
+			auto product = static_cast<unsigned __int128>(a) * b;
+			return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#endif
+		}
+
+		inline uint64_t avalanche(uint64_t h) {
+			h ^= h >> 37;
+			h *= 0x165667919E3779F9ull;
+			h ^= h >> 32;
+			return h;
+		}
+
+		inline void accumulate(uint64_t* acc, unsigned char const* stripe, uint64_t const* key) {
+			for (size_t i = 0; i < stripe_lanes; i++) {
+				uint64_t data = read64(stripe + i * 8);
+				uint64_t keyed = data ^ key[i];
+				// the raw data goes into the neighbouring lane, so nothing's lost when the product is 0
+				acc[i ^ 1] += data;
+				acc[i] += (keyed & 0xFFFFFFFFull) * (keyed >> 32);
+			}
+		}
+
+		inline void scramble(uint64_t* acc) {
+			for (size_t i = 0; i < stripe_lanes; i++) {
+				uint64_t a = acc[i];
+				a ^= a >> 47;
+				a ^= hash_key[i];
+				acc[i] = a * hash_prime_32;
+			}
+		}
+
+		inline uint64_t hashLong(unsigned char const* p, size_t size, uint64_t seed) {
+			uint64_t acc[stripe_lanes] = {
+				hash_prime_32, hash_prime_1, hash_prime_2, hash_prime_3,
+				hash_prime_32 ^ seed, hash_prime_1 ^ seed, hash_prime_2 ^ seed, hash_prime_3 ^ seed,
+			};
+
+			constexpr size_t block_size = stripe_size * stripes_per_block;
+			size_t blocks = (size - 1) / block_size;
+			for (size_t b = 0; b < blocks; b++) {
+				for (size_t s = 0; s < stripes_per_block; s++) {
+					accumulate(acc, p + b * block_size + s * stripe_size, hash_key.data() + s);
+				}
+				scramble(acc);
+			}
+
+			// what's left of the last block, then its last stripe, which may overlap the one before
+			auto tail = p + blocks * block_size;
+			size_t stripes = (size - 1 - blocks * block_size) / stripe_size;
+			for (size_t s = 0; s < stripes; s++) {
+				accumulate(acc, tail + s * stripe_size, hash_key.data() + s);
+			}
+			accumulate(acc, p + size - stripe_size, hash_key.data() + stripes_per_block - 1);
+
+			uint64_t h = size * hash_prime_1;
+			for (size_t i = 0; i < stripe_lanes; i += 2) {
+				h += mum(acc[i] ^ hash_key[i + 8], acc[i + 1] ^ hash_key[i + 9]);
+			}
+			return avalanche(h);
+		}
+	}
+
+	[[nodiscard]] inline uint64_t fastHash(void const* data, size_t size, uint64_t seed = 0) {
+		using namespace detail;
+		auto p = static_cast<unsigned char const*>(data);
+		auto& key = hash_key;
+
+		if (size <= 16) {
+			uint64_t a = 0, b = 0;
+			if (size >= 8) {
+				a = read64(p);
+				b = read64(p + size - 8);
+			}
+			else if (size >= 4) {
+				a = read32(p);
+				b = read32(p + size - 4);
+			}
+			else if (size > 0) {
+				a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size / 2]) << 8) | p[size - 1];
+			}
+			return avalanche(mum(a ^ key[0] ^ seed, b ^ key[1] ^ size) ^ mum(size ^ key[2], seed ^ key[3]));
+		}
+
+		if (size <= 128) {
+			// pairs of 16 bytes from both ends, meeting in the middle (overlapping when they have to)
+			uint64_t h = size * hash_prime_1 ^ seed;
+			for (size_t i = 0; i < (size + 31) / 32; i++) {
+				auto front = p + i * 16;
+				auto back = p + size - (i + 1) * 16;
+				h += mum(read64(front) ^ key[4 * i % 16], read64(front + 8) ^ (key[(4 * i + 1) % 16] + seed));
+				h += mum(read64(back) ^ key[(4 * i + 2) % 16], read64(back + 8) ^ (key[(4 * i + 3) % 16] - seed));
+			}
+			return avalanche(h);
+		}
+
+		return hashLong(p, size, seed);
+	}
+
+	[[nodiscard]] inline uint64_t fastHash(std::string_view str, uint64_t seed = 0) {
+		return fastHash(str.data(), str.size(), seed);
+	}
+
+	[[nodiscard]] inline uint64_t fastHash(std::wstring_view str, uint64_t seed = 0) {
+		return fastHash(str.data(), str.size() * sizeof(wchar_t), seed);
+	}
+
+	// For unordered containers keyed by strings, so they can be looked up by string_view (or a literal) without
+	// building a string first. Pair with std::equal_to<>.
+	struct StringHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view str) const { return static_cast<size_t>(fastHash(str)); }
+		size_t operator()(std::string const& str) const { return static_cast<size_t>(fastHash(std::string_view(str))); }
+		size_t operator()(char const* str) const { return static_cast<size_t>(fastHash(std::string_view(str))); }
+	};
+
+	struct WStringHash {
+		using is_transparent = void;
+		size_t operator()(std::wstring_view str) const { return static_cast<size_t>(fastHash(str)); }
+		size_t operator()(std::wstring const& str) const { return static_cast<size_t>(fastHash(std::wstring_view(str))); }
+		size_t operator()(wchar_t const* str) const { return static_cast<size_t>(fastHash(std::wstring_view(str))); }
+	};
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Utf.h"
+
+// A "{}" format string parsed once into literal runs and argument slots, so formatting it again is just
+// appending the pieces. Rendering appends to a caller's string, so a buffer reused across frames stops allocating,
+// and numbers are written with std::to_chars instead of a stream.
+//
+// Parsing matches util::FormatWString: "{}" is a slot, anything else (including a lone brace) is literal text.
+// With translateColors, '&' in the template becomes the section sign like util::WFormat, but arguments are left alone.
+class FormatTemplate {
+public:
+	static constexpr wchar_t colorCode = L'\u00A7';
+
+	FormatTemplate() = default;
+
+	explicit FormatTemplate(std::wstring_view fmt, bool translateColors = false) : source(fmt), colors(translateColors) {
+		text.reserve(fmt.size());
+		size_t runStart = 0;
+		for (size_t pos = 0; pos < fmt.size();) {
+			if (fmt[pos] == L'{' && pos + 1 < fmt.size() && fmt[pos + 1] == L'}') {
+				addLiteral(runStart);
+				segments.push_back({ 0, 0, true });
+				slots++;
+				pos += 2;
+				runStart = text.size();
+				continue;
+			}
+			text += (translateColors && fmt[pos] == L'&') ? colorCode : fmt[pos];
+			pos++;
+		}
+		addLiteral(runStart);
+	}
+
+	[[nodiscard]] size_t slotCount() const { return slots; }
+	[[nodiscard]] std::wstring_view getSource() const { return source; }
+	[[nodiscard]] bool translatesColors() const { return colors; }
+
+	// Appends the formatted string to out. Throws std::invalid_argument if the argument count doesn't match, like FormatWString.
+	void render(std::wstring& out, std::span<std::wstring const> args) const {
+		checkCount(args.size());
+		size_t argsSize = 0;
+		for (auto& arg : args) argsSize += arg.size();
+		out.reserve(out.size() + text.size() + argsSize);
+
+		size_t arg = 0;
+		for (auto& seg : segments) {
+			if (seg.slot) out += args[arg++];
+			else out.append(text, seg.begin, seg.length);
+		}
+	}
+
+	// Appends the formatted string to out, with arguments that are wide strings, UTF-8 strings or numbers.
+	template <typename... Args>
+	void format(std::wstring& out, Args const&... args) const {
+		checkCount(sizeof...(Args));
+		out.reserve(out.size() + text.size());
+
+		size_t seg = 0;
+		auto literals = [&] {
+			for (; seg < segments.size() && !segments[seg].slot; seg++) {
+				out.append(text, segments[seg].begin, segments[seg].length);
+			}
+		};
+		literals();
+		((appendArg(out, args), seg++, literals()), ...);
+	}
+
+	template <typename... Args>
+	[[nodiscard]] std::wstring format(Args const&... args) const {
+		std::wstring out;
+		format(out, args...);
+		return out;
+	}
+private:
+	struct Segment {
+		uint32_t begin;
+		uint32_t length;
+		bool slot;
+	};
+
+	void addLiteral(size_t runStart) {
+		if (text.size() > runStart) {
+			segments.push_back({ static_cast<uint32_t>(runStart), static_cast<uint32_t>(text.size() - runStart), false });
+		}
+	}
+
+	void checkCount(size_t count) const {
+		if (count < slots) throw std::invalid_argument("Not enough arguments provided for the format string.");
+		if (count > slots) throw std::invalid_argument("Too many arguments provided for the format string.");
+	}
+
+	template <typename T>
+	static void appendArg(std::wstring& out, T const& arg) {
+		if constexpr (std::is_convertible_v<T const&, std::wstring_view>) {
+			out += std::wstring_view(arg);
+		}
+		else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+			utf::appendWide(std::string_view(arg), out);
+		}
+		else if constexpr (std::is_same_v<T, wchar_t>) {
+			out += arg;
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			out += arg ? L"true" : L"false";
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			char buf[64];
+			auto res = std::to_chars(buf, buf + sizeof(buf), arg);
+			out.append(buf, res.ptr);
+		}
+		else {
+			static_assert(std::is_arithmetic_v<T>, "unsupported format argument type");
+		}
+	}
+
+	std::wstring source;
+	// the template with slots removed (and colors translated), which literal segments point into
+	std::wstring text;
+	std::vector<Segment> segments;
+	size_t slots = 0;
+	bool colors = false;
+};
+
+// Compiled templates by hash of their text. Not thread safe; keep one per thread.
+// Once it holds maxEntries templates it's cleared, so templates built from changing text can't grow it forever.
+class FormatTemplateCache {
+public:
+	explicit FormatTemplateCache(size_t maxEntries = 64) : maxEntries(maxEntries) {}
+
+	FormatTemplate const& get(std::wstring_view fmt, bool translateColors = false) {
+		uint64_t hash = 0xcbf29ce484222325ull ^ static_cast<uint64_t>(translateColors);
+		for (wchar_t ch : fmt) {
+			hash = (hash ^ static_cast<uint64_t>(ch)) * 0x100000001b3ull;
+		}
+
+		auto it = templates.find(hash);
+		if (it != templates.end()) {
+			// on a hash collision the newer template replaces the old one
+			if (it->second.getSource() == fmt && it->second.translatesColors() == translateColors) return it->second;
+			it->second = FormatTemplate(fmt, translateColors);
+			return it->second;
+		}
+
+		if (templates.size() >= maxEntries) templates.clear();
+		return templates.emplace(hash, FormatTemplate(fmt, translateColors)).first->second;
+	}
+
+	[[nodiscard]] size_t size() const { return templates.size(); }
+private:
+	size_t maxEntries;
+	std::unordered_map<uint64_t, FormatTemplate> templates;
+};
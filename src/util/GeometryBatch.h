@@ -0,0 +1,159 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <vector>
+#include "LMath.h"
+
+// Collects 3D lines and quads in world space so they can be submitted once per primitive type.
+// It doesn't know about the tessellator: submit() takes anything with color(Color const&) and vertex(x, y, z),
+// and moves vertices relative to the given origin as they're emitted.
+// Clearing keeps the allocated storage, so a batch reused across frames stops allocating once warmed up.
+class GeometryBatch {
+public:
+	struct Vertex {
+		Vec3 pos;
+		Color color;
+	};
+
+	GeometryBatch() = default;
+	GeometryBatch(GeometryBatch&) = delete;
+	GeometryBatch(GeometryBatch&&) = delete;
+
+	// Identical lines (in either direction, same color) are only added once
+	void addLine(Vec3 const& a, Vec3 const& b, Color const& color) {
+		auto key = LineKey::make(a, b, color);
+		if ((lines.size() / 2 + 1) * 2 > lineSlots.size()) {
+			growLineSlots();
+		}
+
+		size_t slot = findSlot(key);
+		if (lineSlots[slot] != 0) return;
+		lineSlots[slot] = static_cast<uint32_t>(lines.size() / 2 + 1);
+		lines.push_back({ a, color });
+		lines.push_back({ b, color });
+	}
+
+	void addQuadOutline(Vec3 const& a, Vec3 const& b, Vec3 const& c, Vec3 const& d, Color const& color) {
+		addLine(a, b, color);
+		addLine(b, c, color);
+		addLine(c, d, color);
+		addLine(d, a, color);
+	}
+
+	// Adds both windings so the quad is visible from either side
+	void addQuad(Vec3 const& a, Vec3 const& b, Vec3 const& c, Vec3 const& d, Color const& color) {
+		for (auto& pos : { a, b, c, d, d, c, b, a }) {
+			quads.push_back({ pos, color });
+		}
+	}
+
+	// The 12 edges of a box
+	void addBoxOutline(AABB const& bb, Color const& color) {
+		auto corners = getCorners(bb);
+		// bottom and top rings
+		for (int i = 0; i < 4; i++) {
+			addLine(corners[i], corners[(i + 1) % 4], color);
+			addLine(corners[i + 4], corners[(i + 1) % 4 + 4], color);
+		}
+		// verticals
+		for (int i = 0; i < 4; i++) {
+			addLine(corners[i], corners[i + 4], color);
+		}
+	}
+
+	// The 6 faces of a box
+	void addBox(AABB const& bb, Color const& color) {
+		auto c = getCorners(bb);
+		addQuad(c[0], c[1], c[2], c[3], color); // bottom
+		addQuad(c[4], c[5], c[6], c[7], color); // top
+		addQuad(c[0], c[1], c[5], c[4], color); // north
+		addQuad(c[3], c[2], c[6], c[7], color); // south
+		addQuad(c[0], c[3], c[7], c[4], color); // west
+		addQuad(c[1], c[2], c[6], c[5], color); // east
+	}
+
+	[[nodiscard]] std::vector<Vertex> const& getLines() const { return lines; }
+	[[nodiscard]] std::vector<Vertex> const& getQuads() const { return quads; }
+	[[nodiscard]] bool empty() const { return lines.empty() && quads.empty(); }
+
+	template <typename Sink>
+	static void submit(std::vector<Vertex> const& vertices, Vec3 const& origin, Sink& sink) {
+		Color current{ -1.f, -1.f, -1.f, -1.f };
+		for (auto& vert : vertices) {
+			// the tessellator keeps the last color, so only send it when it changes
+			if (std::memcmp(&vert.color, &current, sizeof(Color)) != 0) {
+				current = vert.color;
+				sink.color(current);
+			}
+			sink.vertex(vert.pos.x - origin.x, vert.pos.y - origin.y, vert.pos.z - origin.z);
+		}
+	}
+
+	void clear() {
+		lines.clear();
+		quads.clear();
+		std::fill(lineSlots.begin(), lineSlots.end(), 0u);
+	}
+private:
+	// Corners 0-3 are the bottom ring, 4-7 the top ring, in the same order
+	static std::array<Vec3, 8> getCorners(AABB const& bb) {
+		auto& lo = bb.lower;
+		auto& hi = bb.higher;
+		return {
+			Vec3(lo.x, lo.y, lo.z), Vec3(hi.x, lo.y, lo.z), Vec3(hi.x, lo.y, hi.z), Vec3(lo.x, lo.y, hi.z),
+			Vec3(lo.x, hi.y, lo.z), Vec3(hi.x, hi.y, lo.z), Vec3(hi.x, hi.y, hi.z), Vec3(lo.x, hi.y, hi.z),
+		};
+	}
+
+	struct LineKey {
+		std::array<uint32_t, 10> bits;
+
+		static LineKey make(Vec3 a, Vec3 b, Color const& color) {
+			if (std::tie(b.x, b.y, b.z) < std::tie(a.x, a.y, a.z)) std::swap(a, b);
+			return { {
+				std::bit_cast<uint32_t>(a.x), std::bit_cast<uint32_t>(a.y), std::bit_cast<uint32_t>(a.z),
+				std::bit_cast<uint32_t>(b.x), std::bit_cast<uint32_t>(b.y), std::bit_cast<uint32_t>(b.z),
+				std::bit_cast<uint32_t>(color.r), std::bit_cast<uint32_t>(color.g), std::bit_cast<uint32_t>(color.b), std::bit_cast<uint32_t>(color.a),
+			} };
+		}
+
+		bool operator==(LineKey const&) const = default;
+	};
+
+	static size_t hashKey(LineKey const& key) {
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (auto part : key.bits) {
+			hash = (hash ^ part) * 0x100000001b3ull;
+		}
+		return static_cast<size_t>(hash ^ (hash >> 29));
+	}
+
+	// Open addressing over line indices (+1, 0 is empty), so de-duplicating doesn't allocate per line
+	size_t findSlot(LineKey const& key) const {
+		size_t mask = lineSlots.size() - 1;
+		size_t slot = hashKey(key) & mask;
+		while (lineSlots[slot] != 0) {
+			size_t line = (lineSlots[slot] - 1) * 2;
+			if (LineKey::make(lines[line].pos, lines[line + 1].pos, lines[line].color) == key) break;
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	void growLineSlots() {
+		lineSlots.assign(std::max<size_t>(64, lineSlots.size() * 2), 0u);
+		for (size_t i = 0; i < lines.size(); i += 2) {
+			auto key = LineKey::make(lines[i].pos, lines[i + 1].pos, lines[i].color);
+			lineSlots[findSlot(key)] = static_cast<uint32_t>(i / 2 + 1);
+		}
+	}
+
+	std::vector<Vertex> lines;
+	std::vector<Vertex> quads;
+	// kept at most half full
+	std::vector<uint32_t> lineSlots;
+};
@@ -75,8 +75,15 @@ struct Vec3 final {
 		return { x * right, y * right, z * right };
 	}
 
-	inline float distance(Vec3& vec) {
-		return static_cast<float>(std::sqrt(std::pow(x - vec.x, 2) + std::pow(y - vec.y, 2) + std::pow(z - vec.z, 2)));
+	[[nodiscard]] constexpr float distanceSquared(Vec3 const& vec) const {
+		float dx = x - vec.x;
+		float dy = y - vec.y;
+		float dz = z - vec.z;
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	[[nodiscard]] float distance(Vec3 const& vec) const {
+		return std::sqrt(distanceSquared(vec));
 	}
 };
 
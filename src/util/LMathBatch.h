@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "LMath.h"
+
+#if defined(__AVX2__) || defined(__AVX__)
+#include <immintrin.h>
+#define LATITE_MATH_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LATITE_MATH_SSE2 1
+#endif
+
+// Math over many vectors at once, stored as structure-of-arrays so each kernel streams through plain float arrays.
+// Kernels use AVX (8 wide) or SSE2 (4 wide) depending on what the build targets, and finish the remainder
+// with the same code in scalar form, so results don't depend on the element count.
+// Every kernel is written once against an Ops type (ScalarOps / SseOps / AvxOps) with the same interface.
+namespace LatiteMath::batch {
+	struct Vec3Array {
+		std::vector<float> x, y, z;
+
+		void reserve(size_t count) {
+			x.reserve(count);
+			y.reserve(count);
+			z.reserve(count);
+		}
+
+		void resize(size_t count) {
+			x.resize(count);
+			y.resize(count);
+			z.resize(count);
+		}
+
+		void clear() {
+			x.clear();
+			y.clear();
+			z.clear();
+		}
+
+		void push_back(Vec3 const& vec) {
+			x.push_back(vec.x);
+			y.push_back(vec.y);
+			z.push_back(vec.z);
+		}
+
+		[[nodiscard]] Vec3 get(size_t i) const { return { x[i], y[i], z[i] }; }
+		[[nodiscard]] size_t size() const { return x.size(); }
+		[[nodiscard]] bool empty() const { return x.empty(); }
+	};
+
+	struct AABBArray {
+		Vec3Array lower, higher;
+
+		void reserve(size_t count) {
+			lower.reserve(count);
+			higher.reserve(count);
+		}
+
+		void clear() {
+			lower.clear();
+			higher.clear();
+		}
+
+		void push_back(AABB const& bb) {
+			lower.push_back(bb.lower);
+			higher.push_back(bb.higher);
+		}
+
+		[[nodiscard]] AABB get(size_t i) const { return { lower.get(i), higher.get(i) }; }
+		[[nodiscard]] size_t size() const { return lower.size(); }
+		[[nodiscard]] bool empty() const { return lower.empty(); }
+	};
+
+	namespace detail {
+		struct ScalarOps {
+			using Reg = float;
+			using Mask = bool;
+			static constexpr size_t width = 1;
+
+			static Reg load(float const* p) { return *p; }
+			static void store(float* p, Reg a) { *p = a; }
+			static Reg set(float f) { return f; }
+			static Reg add(Reg a, Reg b) { return a + b; }
+			static Reg sub(Reg a, Reg b) { return a - b; }
+			static Reg mul(Reg a, Reg b) { return a * b; }
+			static Reg div(Reg a, Reg b) { return a / b; }
+			static Reg min(Reg a, Reg b) { return b < a ? b : a; }
+			static Reg max(Reg a, Reg b) { return a < b ? b : a; }
+			static Reg sqrt(Reg a) { return std::sqrt(a); }
+			static Reg floor(Reg a) { return std::floor(a); }
+			static Mask ge(Reg a, Reg b) { return a >= b; }
+			static Mask eq(Reg a, Reg b) { return a == b; }
+			static Mask andMask(Mask a, Mask b) { return a && b; }
+			static Mask notMask(Mask a) { return !a; }
+			static Reg select(Mask m, Reg a, Reg b) { return m ? a : b; }
+			// one bit per lane
+			static unsigned bits(Mask m) { return m ? 1u : 0u; }
+		};
+
+#if LATITE_MATH_AVX
+		struct AvxOps {
+			using Reg = __m256;
+			using Mask = __m256;
+			static constexpr size_t width = 8;
+
+			static Reg load(float const* p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, Reg a) { _mm256_storeu_ps(p, a); }
+			static Reg set(float f) { return _mm256_set1_ps(f); }
+			static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+			static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+			static Reg div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+			static Reg sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+			static Reg floor(Reg a) { return _mm256_floor_ps(a); }
+			static Mask ge(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+			static Mask eq(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+			static Mask andMask(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+			static Mask notMask(Mask a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+			static Reg select(Mask m, Reg a, Reg b) { return _mm256_blendv_ps(b, a, m); }
+			static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+		};
+		using WideOps = AvxOps;
+#elif LATITE_MATH_SSE2
+		struct SseOps {
+			using Reg = __m128;
+			using Mask = __m128;
+			static constexpr size_t width = 4;
+
+			static Reg load(float const* p) { return _mm_loadu_ps(p); }
+			static void store(float* p, Reg a) { _mm_storeu_ps(p, a); }
+			static Reg set(float f) { return _mm_set1_ps(f); }
+			static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+			static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+			static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+			static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+			static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+			static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+			static Reg sqrt(Reg a) { return _mm_sqrt_ps(a); }
+			// SSE2 has no round instruction: truncate, then step down where that rounded up
+			static Reg floor(Reg a) {
+				Reg t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+				return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.f)));
+			}
+			static Mask ge(Reg a, Reg b) { return _mm_cmpge_ps(a, b); }
+			static Mask eq(Reg a, Reg b) { return _mm_cmpeq_ps(a, b); }
+			static Mask andMask(Mask a, Mask b) { return _mm_and_ps(a, b); }
+			static Mask notMask(Mask a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+			static Reg select(Mask m, Reg a, Reg b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+			static unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+		};
+		using WideOps = SseOps;
+#else
+		using WideOps = ScalarOps;
+#endif
+
+		// Runs kernel<Ops>(i) for each block of Ops::width elements, wide first, then the remainder one at a time.
+		template <template <typename> typename Kernel, typename... Args>
+		void run(size_t count, Args&&... args) {
+			size_t i = 0;
+			if constexpr (WideOps::width > 1) {
+				for (; i + WideOps::width <= count; i += WideOps::width) {
+					Kernel<WideOps>::apply(i, args...);
+				}
+			}
+			for (; i < count; i++) {
+				Kernel<ScalarOps>::apply(i, args...);
+			}
+		}
+
+		template <typename Ops>
+		struct DistanceSquared {
+			static void apply(size_t i, Vec3Array const& points, Vec3 const& to, float* out, bool root) {
+				auto dx = Ops::sub(Ops::load(&points.x[i]), Ops::set(to.x));
+				auto dy = Ops::sub(Ops::load(&points.y[i]), Ops::set(to.y));
+				auto dz = Ops::sub(Ops::load(&points.z[i]), Ops::set(to.z));
+				auto d2 = Ops::add(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)), Ops::mul(dz, dz));
+				Ops::store(&out[i], root ? Ops::sqrt(d2) : d2);
+			}
+		};
+
+		template <typename Ops>
+		struct AABBDistanceSquared {
+			static void apply(size_t i, AABBArray const& boxes, Vec3 const& to, float* out) {
+				auto axis = [i](std::vector<float> const& lo, std::vector<float> const& hi, float p) {
+					auto pt = Ops::set(p);
+					auto closest = Ops::min(Ops::max(pt, Ops::load(&lo[i])), Ops::load(&hi[i]));
+					auto d = Ops::sub(closest, pt);
+					return Ops::mul(d, d);
+				};
+				auto d2 = Ops::add(Ops::add(
+					axis(boxes.lower.x, boxes.higher.x, to.x),
+					axis(boxes.lower.y, boxes.higher.y, to.y)),
+					axis(boxes.lower.z, boxes.higher.z, to.z));
+				Ops::store(&out[i], d2);
+			}
+		};
+
+		template <typename Ops>
+		struct CullAABBs {
+			static void apply(size_t i, AABBArray const& boxes, std::span<Vec4 const> planes, uint8_t* visible, size_t& visibleCount) {
+				auto inside = Ops::eq(Ops::set(0.f), Ops::set(0.f));
+				for (auto& plane : planes) {
+					// the corner furthest along the plane normal; if that's behind the plane, the whole box is
+					auto& px = plane.x >= 0.f ? boxes.higher.x : boxes.lower.x;
+					auto& py = plane.y >= 0.f ? boxes.higher.y : boxes.lower.y;
+					auto& pz = plane.z >= 0.f ? boxes.higher.z : boxes.lower.z;
+					auto dist = Ops::add(Ops::add(
+						Ops::mul(Ops::load(&px[i]), Ops::set(plane.x)),
+						Ops::mul(Ops::load(&py[i]), Ops::set(plane.y))),
+						Ops::add(Ops::mul(Ops::load(&pz[i]), Ops::set(plane.z)), Ops::set(plane.w)));
+					inside = Ops::andMask(inside, Ops::ge(dist, Ops::set(0.f)));
+				}
+				unsigned bits = Ops::bits(inside);
+				for (size_t lane = 0; lane < Ops::width; lane++) {
+					uint8_t vis = (bits >> lane) & 1;
+					visible[i + lane] = vis;
+					visibleCount += vis;
+				}
+			}
+		};
+
+		template <typename Ops>
+		struct Lerp {
+			static void apply(size_t i, Vec3Array const& from, Vec3Array const& to, float t, Vec3Array& out) {
+				auto tt = Ops::set(t);
+				auto component = [i, tt](std::vector<float> const& a, std::vector<float> const& b, std::vector<float>& o) {
+					auto va = Ops::load(&a[i]);
+					Ops::store(&o[i], Ops::add(va, Ops::mul(Ops::sub(Ops::load(&b[i]), va), tt)));
+				};
+				component(from.x, to.x, out.x);
+				component(from.y, to.y, out.y);
+				component(from.z, to.z, out.z);
+			}
+		};
+
+		template <typename Ops>
+		struct HSVToRGB {
+			// channel n of the hue hexagon: v - v * s * clamp(min(k, 4 - k), 0, 1) with k = (n + h / 60) mod 6
+			static typename Ops::Reg channel(float n, typename Ops::Reg h6, typename Ops::Reg s, typename Ops::Reg v) {
+				auto k = Ops::add(Ops::set(n), h6);
+				k = Ops::select(Ops::ge(k, Ops::set(6.f)), Ops::sub(k, Ops::set(6.f)), k);
+				auto f = Ops::max(Ops::set(0.f), Ops::min(Ops::min(k, Ops::sub(Ops::set(4.f), k)), Ops::set(1.f)));
+				return Ops::sub(v, Ops::mul(Ops::mul(v, s), f));
+			}
+
+			static void apply(size_t i, float const* h, float const* s, float const* v, float* r, float* g, float* b) {
+				auto hue = Ops::load(&h[i]);
+				// hue wrapped into [0, 360)
+				hue = Ops::sub(hue, Ops::mul(Ops::floor(Ops::mul(hue, Ops::set(1.f / 360.f))), Ops::set(360.f)));
+				auto h6 = Ops::mul(hue, Ops::set(1.f / 60.f));
+				auto sat = Ops::load(&s[i]);
+				auto val = Ops::load(&v[i]);
+				Ops::store(&r[i], channel(5.f, h6, sat, val));
+				Ops::store(&g[i], channel(3.f, h6, sat, val));
+				Ops::store(&b[i], channel(1.f, h6, sat, val));
+			}
+		};
+
+		template <typename Ops>
+		struct RGBToHSV {
+			static void apply(size_t i, float const* r, float const* g, float const* b, float* h, float* s, float* v) {
+				auto red = Ops::load(&r[i]);
+				auto green = Ops::load(&g[i]);
+				auto blue = Ops::load(&b[i]);
+				auto maxVal = Ops::max(red, Ops::max(green, blue));
+				auto minVal = Ops::min(red, Ops::min(green, blue));
+				auto delta = Ops::sub(maxVal, minVal);
+				auto gray = Ops::eq(delta, Ops::set(0.f));
+
+				// lanes where delta is 0 divide by zero here, and are replaced by the select below
+				auto hr = Ops::div(Ops::sub(green, blue), delta);
+				auto hg = Ops::add(Ops::set(2.f), Ops::div(Ops::sub(blue, red), delta));
+				auto hb = Ops::add(Ops::set(4.f), Ops::div(Ops::sub(red, green), delta));
+				auto hue = Ops::select(Ops::eq(red, maxVal), hr, Ops::select(Ops::eq(green, maxVal), hg, hb));
+				hue = Ops::mul(hue, Ops::set(60.f));
+				hue = Ops::select(Ops::ge(hue, Ops::set(0.f)), hue, Ops::add(hue, Ops::set(360.f)));
+
+				auto zero = Ops::set(0.f);
+				Ops::store(&h[i], Ops::select(gray, zero, hue));
+				Ops::store(&s[i], Ops::select(gray, zero, Ops::div(delta, maxVal)));
+				Ops::store(&v[i], maxVal);
+			}
+		};
+	}
+
+	// Squared distance from every point to `to`, written to out[0..points.size())
+	inline void distanceSquared(Vec3Array const& points, Vec3 const& to, float* out) {
+		detail::run<detail::DistanceSquared>(points.size(), points, to, out, false);
+	}
+
+	inline void distance(Vec3Array const& points, Vec3 const& to, float* out) {
+		detail::run<detail::DistanceSquared>(points.size(), points, to, out, true);
+	}
+
+	// Squared distance from `to` to the closest point of every box (0 if it's inside)
+	inline void aabbDistanceSquared(AABBArray const& boxes, Vec3 const& to, float* out) {
+		detail::run<detail::AABBDistanceSquared>(boxes.size(), boxes, to, out);
+	}
+
+	// Tests every box against planes (normal in xyz, distance in w, normals pointing inwards).
+	// visible[i] is 1 if box i is at least partly in front of every plane. Returns the number of visible boxes.
+	inline size_t cullAABBs(AABBArray const& boxes, std::span<Vec4 const> planes, uint8_t* visible) {
+		size_t count = 0;
+		detail::run<detail::CullAABBs>(boxes.size(), boxes, planes, visible, count);
+		return count;
+	}
+
+	// out = from + (to - from) * t; out is resized to match
+	inline void lerp(Vec3Array const& from, Vec3Array const& to, float t, Vec3Array& out) {
+		size_t count = std::min(from.size(), to.size());
+		out.resize(count);
+		detail::run<detail::Lerp>(count, from, to, t, out);
+	}
+
+	// Same results as util::HSVToColor (hue in degrees, wrapped into [0, 360)), for `count` colors
+	inline void hsvToRgb(float const* h, float const* s, float const* v, float* r, float* g, float* b, size_t count) {
+		detail::run<detail::HSVToRGB>(count, h, s, v, r, g, b);
+	}
+
+	// Same results as util::ColorToHSV, for `count` colors
+	inline void rgbToHsv(float const* r, float const* g, float const* b, float* h, float* s, float* v, size_t count) {
+		detail::run<detail::RGBToHSV>(count, r, g, b, h, s, v);
+	}
+}
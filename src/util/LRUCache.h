@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <functional>
+
+// A size-bounded least-recently-used cache.
+// Lookups can use any type the hasher and comparator accept (transparent hashing), so a cheap
+// view key can be used to find an entry without building the owning key.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LRUCache {
+public:
+	struct Stats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		size_t size = 0;
+		size_t capacity = 0;
+	};
+
+	explicit LRUCache(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+	LRUCache(LRUCache&) = delete;
+	LRUCache(LRUCache&&) = delete;
+
+	// Returns the cached value and marks it as most recently used, or nullptr on a miss.
+	template <typename K>
+	[[nodiscard]] Value* get(K const& key) {
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			stats.misses++;
+			return nullptr;
+		}
+		stats.hits++;
+		order.splice(order.begin(), order, it->second.order);
+		return &it->second.value;
+	}
+
+	// Inserts or replaces a value, evicting the least recently used entries if over capacity.
+	Value& put(Key key, Value value) {
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			it->second.value = std::move(value);
+			order.splice(order.begin(), order, it->second.order);
+			return it->second.value;
+		}
+
+		auto [inserted, _] = entries.emplace(std::move(key), Entry{ std::move(value), {} });
+		order.push_front(&inserted->first);
+		inserted->second.order = order.begin();
+		trim();
+		return inserted->second.value;
+	}
+
+	// Returns the cached value, or creates it with factory() (given the lookup key) on a miss.
+	template <typename K, typename Factory>
+	Value& getOrCreate(K const& key, Factory&& factory) {
+		if (auto val = get(key)) return *val;
+		return put(Key(key), factory(key));
+	}
+
+	void clear() {
+		order.clear();
+		entries.clear();
+	}
+
+	void setCapacity(size_t newCapacity) {
+		capacity = newCapacity > 0 ? newCapacity : 1;
+		trim();
+	}
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+	[[nodiscard]] size_t getCapacity() const { return capacity; }
+
+	[[nodiscard]] Stats getStats() const {
+		Stats ret = stats;
+		ret.size = entries.size();
+		ret.capacity = capacity;
+		return ret;
+	}
+
+	void resetStats() {
+		stats = {};
+	}
+private:
+	using OrderList = std::list<Key const*>;
+
+	struct Entry {
+		Value value;
+		typename OrderList::iterator order;
+	};
+
+	void trim() {
+		while (entries.size() > capacity) {
+			auto oldest = order.back();
+			order.pop_back();
+			entries.erase(entries.find(*oldest));
+			stats.evictions++;
+		}
+	}
+
+	size_t capacity;
+	Stats stats{};
+	// Most recently used at the front. Points at the keys owned by entries (node-based, so stable).
+	OrderList order;
+	std::unordered_map<Key, Entry, Hash, KeyEqual> entries;
+};
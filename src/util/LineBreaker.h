@@ -0,0 +1,125 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Wraps text to a width using cached per-glyph advances, so a message is measured once per glyph
+// instead of once per prefix. It doesn't depend on any renderer: advances come from a
+// measure(wchar_t) -> float callable, which only runs for glyphs that aren't cached yet.
+//
+// Lines break at the last space that fits; words longer than a line are broken anywhere.
+// A section sign (§) and the character after it are formatting codes and have no width.
+class LineBreaker {
+public:
+	static constexpr wchar_t formatCode = L'\u00A7';
+
+	struct Line {
+		size_t begin;
+		size_t end;
+		float width;
+	};
+
+	LineBreaker() {
+		clear();
+	}
+
+	// Forget cached advances, call when the font or its size changes.
+	void clear() {
+		asciiAdvances.fill(-1.f);
+		advances.clear();
+	}
+
+	template <typename Measure>
+	float getAdvance(wchar_t ch, Measure&& measure) {
+		if (static_cast<size_t>(ch) < asciiAdvances.size()) {
+			float& adv = asciiAdvances[static_cast<size_t>(ch)];
+			if (adv < 0.f) adv = measure(ch);
+			return adv;
+		}
+		auto it = advances.find(ch);
+		if (it != advances.end()) return it->second;
+		return advances.emplace(ch, measure(ch)).first->second;
+	}
+
+	template <typename Measure>
+	std::vector<Line> wrap(std::wstring_view text, float maxWidth, Measure&& measure) {
+		std::vector<Line> lines;
+
+		size_t lineStart = 0;
+		float width = 0.f;
+		// last space on the current line, and the line width up to (not including) it
+		size_t lastSpace = std::wstring_view::npos;
+		float widthBeforeSpace = 0.f;
+
+		for (size_t i = 0; i < text.size(); i++) {
+			wchar_t ch = text[i];
+			if (ch == L'\n') {
+				lines.push_back({ lineStart, i, width });
+				lineStart = i + 1;
+				width = 0.f;
+				lastSpace = std::wstring_view::npos;
+				continue;
+			}
+
+			if (ch == formatCode) {
+				if (i + 1 < text.size()) i++;
+				continue;
+			}
+
+			float adv = getAdvance(ch, measure);
+			if (ch == L' ' && width + adv > maxWidth && i > lineStart) {
+				// a space that doesn't fit ends the line and is dropped
+				lines.push_back({ lineStart, i, width });
+				lineStart = i + 1;
+				width = 0.f;
+				lastSpace = std::wstring_view::npos;
+				continue;
+			}
+
+			while (width + adv > maxWidth && i > lineStart) {
+				if (lastSpace != std::wstring_view::npos && lastSpace > lineStart) {
+					// the width of the word after the space moves to the next line
+					float spaceAdv = getAdvance(L' ', measure);
+					lines.push_back({ lineStart, lastSpace, widthBeforeSpace });
+					width -= widthBeforeSpace + spaceAdv;
+					lineStart = lastSpace + 1;
+					lastSpace = std::wstring_view::npos;
+				}
+				else {
+					lines.push_back({ lineStart, i, width });
+					lineStart = i;
+					width = 0.f;
+					lastSpace = std::wstring_view::npos;
+				}
+			}
+
+			if (ch == L' ') {
+				lastSpace = i;
+				widthBeforeSpace = width;
+			}
+			width += adv;
+		}
+
+		lines.push_back({ lineStart, text.size(), width });
+		return lines;
+	}
+
+	// Wraps text and joins the lines with '\n'
+	template <typename Measure>
+	std::wstring wrapToString(std::wstring_view text, float maxWidth, Measure&& measure) {
+		auto lines = wrap(text, maxWidth, measure);
+		std::wstring ret;
+		ret.reserve(text.size() + lines.size());
+		for (size_t i = 0; i < lines.size(); i++) {
+			if (i > 0) ret += L'\n';
+			ret.append(text.substr(lines[i].begin, lines[i].end - lines[i].begin));
+		}
+		return ret;
+	}
+private:
+	std::array<float, 0x100> asciiAdvances;
+	std::unordered_map<wchar_t, float> advances;
+};
@@ -0,0 +1,263 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Replaces any number of patterns in UTF-8 text in one pass, for rewriting chat.
+//
+// The rules are compiled once into an Aho-Corasick automaton (a DFA over the bytes the patterns use, folded to
+// lower case), so the cost of a rewrite depends on the length of the text, not on how many rules there are.
+// Where matches overlap, the leftmost one wins, then the longest, then the rule that was added first.
+//
+// Formatting codes (a section sign and the character after it) are never matched and split the text: a pattern
+// can't match across one, and they count as word boundaries, so a coloured name is still a whole word.
+class TextRewriter {
+public:
+	struct Rule {
+		std::string pattern;
+		std::string replacement;
+		// only folds ASCII letters
+		bool ignoreCase = false;
+		// only match where the pattern isn't part of a longer word
+		bool wholeWord = false;
+	};
+
+	TextRewriter() = default;
+	explicit TextRewriter(std::vector<Rule> rules) { compile(std::move(rules)); }
+
+	// Replaces the rules. Empty patterns are skipped.
+	void compile(std::vector<Rule> newRules) {
+		rules = std::move(newRules);
+		states.clear();
+		transitions.clear();
+		ruleIds.clear();
+		classes.fill(0);
+		classCount = 1;
+
+		std::vector<std::vector<uint32_t>> stateRules;
+		// trie over folded bytes; transitions are filled in as a DFA below, so start them all at "none"
+		std::vector<std::vector<uint32_t>> trie;
+		auto addState = [&](uint32_t depth) {
+			states.push_back({ depth, 0, 0, 0, 0 });
+			stateRules.emplace_back();
+			trie.emplace_back();
+			return static_cast<uint32_t>(states.size() - 1);
+		};
+		addState(0);
+
+		for (auto& rule : rules) {
+			for (auto c : rule.pattern) {
+				auto& cls = classes[fold(static_cast<uint8_t>(c))];
+				if (!cls) cls = static_cast<uint8_t>(classCount++);
+			}
+		}
+		// so the scan doesn't have to fold anything
+		for (int c = 'A'; c <= 'Z'; c++) classes[c] = classes[c - 'A' + 'a'];
+
+		auto edge = [&](uint32_t state, uint8_t cls) -> uint32_t& {
+			if (trie[state].empty()) trie[state].assign(classCount, none);
+			return trie[state][cls];
+		};
+
+		for (uint32_t i = 0; i < rules.size(); i++) {
+			if (rules[i].pattern.empty()) continue;
+			uint32_t state = 0;
+			for (auto c : rules[i].pattern) {
+				auto cls = classes[fold(static_cast<uint8_t>(c))];
+				if (edge(state, cls) == none) {
+					auto next = addState(states[state].depth + 1);
+					edge(state, cls) = next;
+				}
+				state = trie[state][cls];
+			}
+			stateRules[state].push_back(i);
+		}
+
+		// breadth first, so every state's fallback is done before it's needed
+		transitions.assign(states.size() * classCount, 0);
+		std::vector<uint32_t> queue;
+		for (uint32_t cls = 1; cls < classCount; cls++) {
+			auto next = trie[0].empty() ? none : trie[0][cls];
+			if (next == none) continue;
+			transitions[cls] = next;
+			states[next].fallback = 0;
+			queue.push_back(next);
+		}
+		for (size_t q = 0; q < queue.size(); q++) {
+			auto state = queue[q];
+			auto fallback = states[state].fallback;
+			states[state].output = stateRules[fallback].empty() ? states[fallback].output : fallback;
+			for (uint32_t cls = 1; cls < classCount; cls++) {
+				auto next = trie[state].empty() ? none : trie[state][cls];
+				if (next == none) {
+					transitions[state * classCount + cls] = transitions[fallback * classCount + cls];
+					continue;
+				}
+				transitions[state * classCount + cls] = next;
+				states[next].fallback = transitions[fallback * classCount + cls];
+				queue.push_back(next);
+			}
+		}
+
+		for (auto& state : states) {
+			auto index = static_cast<size_t>(&state - states.data());
+			state.firstRule = static_cast<uint32_t>(ruleIds.size());
+			ruleIds.insert(ruleIds.end(), stateRules[index].begin(), stateRules[index].end());
+			state.ruleCount = static_cast<uint32_t>(stateRules[index].size());
+		}
+
+		// Point transitions straight at the target's row, and tag them with whether it ends any pattern,
+		// so most bytes never look at the state itself
+		for (auto& next : transitions) {
+			auto& target = states[next];
+			next = next * classCount << 1 | (target.ruleCount || target.output ? 1 : 0);
+		}
+	}
+
+	[[nodiscard]] bool empty() const { return states.size() <= 1; }
+	[[nodiscard]] std::vector<Rule> const& getRules() const { return rules; }
+
+	// Writes the rewritten text to `out` and returns true if anything matched. Otherwise, `out` isn't touched.
+	bool rewrite(std::string_view text, std::string& out) const {
+		if (empty()) return false;
+
+		Pass pass{ text, out };
+		auto table = transitions.data();
+		auto width = classCount;
+		uint32_t row = 0;
+		for (size_t i = 0; i < text.size(); i++) {
+			if (isCode(text, i)) {
+				// nothing matches across a code, so whatever's pending is final
+				commit(pass, SIZE_MAX);
+				row = 0;
+				i += std::min<size_t>(2, text.size() - i - 1);
+				continue;
+			}
+
+			auto next = table[row + classes[static_cast<uint8_t>(text[i])]];
+			row = next >> 1;
+			if (!(next & 1)) {
+				if (!pass.pending.empty()) commit(pass, i + 1 - states[row / width].depth);
+				continue;
+			}
+
+			auto state = row / width;
+			auto end = i + 1;
+			for (auto s = states[state].ruleCount ? state : states[state].output; s != 0; s = states[s].output) {
+				auto start = end - states[s].depth;
+				// overlaps a replacement that's already been made
+				if (start < pass.copied) continue;
+
+				for (uint32_t r = 0; r < states[s].ruleCount; r++) {
+					auto id = ruleIds[states[s].firstRule + r];
+					if (accepts(rules[id], text, start, end)) {
+						addPending(pass, { start, end, id });
+						break;
+					}
+				}
+			}
+			// no match can start before the longest partial match that's still going
+			if (!pass.pending.empty()) commit(pass, end - states[state].depth);
+		}
+		commit(pass, SIZE_MAX);
+
+		if (!pass.matched) return false;
+		out.append(text.substr(pass.copied));
+		return true;
+	}
+
+	[[nodiscard]] std::optional<std::string> rewrite(std::string_view text) const {
+		std::string out;
+		if (!rewrite(text, out)) return std::nullopt;
+		return out;
+	}
+private:
+	static constexpr uint32_t none = UINT32_MAX;
+
+	struct State {
+		uint32_t depth;
+		uint32_t fallback;
+		// the nearest state down the fallback chain that ends a pattern, or 0
+		uint32_t output;
+		uint32_t firstRule;
+		uint32_t ruleCount;
+	};
+
+	struct Match {
+		size_t start;
+		size_t end;
+		uint32_t rule;
+	};
+
+	struct Pass {
+		std::string_view text;
+		std::string& out;
+		// matches that could still lose to one that hasn't ended yet, by start; at most one per start
+		std::vector<Match> pending = {};
+		// everything before this is in `out`
+		size_t copied = 0;
+		bool matched = false;
+	};
+
+	static uint8_t fold(uint8_t c) {
+		return c >= 'A' && c <= 'Z' ? static_cast<uint8_t>(c - 'A' + 'a') : c;
+	}
+
+	// the section sign is C2 A7 in UTF-8
+	static bool isCode(std::string_view text, size_t i) {
+		return static_cast<uint8_t>(text[i]) == 0xC2 && i + 1 < text.size() && static_cast<uint8_t>(text[i + 1]) == 0xA7;
+	}
+
+	// Anything that isn't ASCII is taken to be part of a word (other than a formatting code)
+	static bool isWordByte(uint8_t c) {
+		return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+	}
+
+	static bool accepts(Rule const& rule, std::string_view text, size_t start, size_t end) {
+		if (!rule.ignoreCase && text.substr(start, end - start) != rule.pattern) return false;
+		if (rule.wholeWord) {
+			bool codeBefore = start >= 3 && isCode(text, start - 3);
+			if (start > 0 && !codeBefore && isWordByte(static_cast<uint8_t>(text[start - 1]))) return false;
+			if (end < text.size() && !isCode(text, end) && isWordByte(static_cast<uint8_t>(text[end]))) return false;
+		}
+		return true;
+	}
+
+	static void addPending(Pass& pass, Match match) {
+		auto it = std::lower_bound(pass.pending.begin(), pass.pending.end(), match.start,
+			[](Match const& m, size_t start) { return m.start < start; });
+		// matches arrive by where they end, so one with the same start is always shorter
+		if (it != pass.pending.end() && it->start == match.start) *it = match;
+		else pass.pending.insert(it, match);
+	}
+
+	// Replaces pending matches that start before `limit`, leftmost first
+	void commit(Pass& pass, size_t limit) const {
+		while (!pass.pending.empty() && pass.pending.front().start < limit) {
+			auto match = pass.pending.front();
+			if (!pass.matched) {
+				pass.out.clear();
+				pass.matched = true;
+			}
+			pass.out.append(pass.text.substr(pass.copied, match.start - pass.copied));
+			pass.out.append(rules[match.rule].replacement);
+			pass.copied = match.end;
+
+			auto overlapped = std::find_if(pass.pending.begin(), pass.pending.end(), [&](Match const& m) { return m.start >= match.end; });
+			pass.pending.erase(pass.pending.begin(), overlapped);
+		}
+	}
+
+	std::vector<Rule> rules;
+	std::vector<State> states;
+	// A row of classCount entries per state. Each is where the next state's row starts, shifted left once, with the
+	// low bit set if that state ends a pattern. Class 0 is every byte no pattern uses.
+	std::vector<uint32_t> transitions;
+	std::vector<uint32_t> ruleIds;
+	std::array<uint8_t, 256> classes = {};
+	uint32_t classCount = 1;
+};
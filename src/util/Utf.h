@@ -0,0 +1,277 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LATITE_UTF_SSE2 1
+#endif
+
+// UTF-8 <-> wchar_t conversion (UTF-16 where wchar_t is 16 bits, UTF-32 where it's 32), with no platform dependency.
+// The output length is measured exactly first, then written straight into the destination, so converting into
+// a string allocates at most once and appending into a reused buffer usually doesn't allocate at all.
+// Runs of ASCII are checked and copied 16 bytes at a time with SSE2 when available.
+//
+// Malformed input (bad or truncated UTF-8 sequences, overlong encodings, unpaired surrogates) is either
+// replaced with U+FFFD, one per maximal invalid subsequence as the Unicode standard recommends, or skipped.
+namespace utf {
+	enum class Policy {
+		Replace,
+		Skip,
+	};
+
+	inline constexpr char32_t replacementChar = 0xFFFD;
+
+	namespace detail {
+		struct Decoded {
+			char32_t cp;
+			size_t len;
+			bool valid;
+		};
+
+		inline Decoded decodeUtf8(unsigned char const* p, unsigned char const* end) {
+			unsigned char lead = p[0];
+			if (lead < 0x80) return { lead, 1, true };
+
+			size_t need;
+			char32_t cp;
+			// valid range of the second byte, which rules out overlong forms, surrogates and values past U+10FFFF
+			unsigned char lo = 0x80, hi = 0xBF;
+			if (lead >= 0xC2 && lead <= 0xDF) {
+				need = 1;
+				cp = lead & 0x1F;
+			}
+			else if (lead >= 0xE0 && lead <= 0xEF) {
+				need = 2;
+				cp = lead & 0x0F;
+				if (lead == 0xE0) lo = 0xA0;
+				else if (lead == 0xED) hi = 0x9F;
+			}
+			else if (lead >= 0xF0 && lead <= 0xF4) {
+				need = 3;
+				cp = lead & 0x07;
+				if (lead == 0xF0) lo = 0x90;
+				else if (lead == 0xF4) hi = 0x8F;
+			}
+			else {
+				return { replacementChar, 1, false };
+			}
+
+			for (size_t i = 1; i <= need; i++) {
+				if (p + i >= end) return { replacementChar, i, false };
+				unsigned char byte = p[i];
+				if (byte < lo || byte > hi) return { replacementChar, i, false };
+				lo = 0x80;
+				hi = 0xBF;
+				cp = (cp << 6) | (byte & 0x3F);
+			}
+			return { cp, need + 1, true };
+		}
+
+		inline Decoded decodeWide(wchar_t const* p, wchar_t const* end) {
+			auto unit = static_cast<char32_t>(p[0]);
+			if constexpr (sizeof(wchar_t) == 2) {
+				unit &= 0xFFFF;
+				if (unit < 0xD800 || unit > 0xDFFF) return { unit, 1, true };
+				if (unit <= 0xDBFF && p + 1 < end) {
+					auto low = static_cast<char32_t>(p[1]) & 0xFFFF;
+					if (low >= 0xDC00 && low <= 0xDFFF) {
+						return { 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00), 2, true };
+					}
+				}
+				return { replacementChar, 1, false };
+			}
+			else {
+				if (unit > 0x10FFFF || (unit >= 0xD800 && unit <= 0xDFFF)) return { replacementChar, 1, false };
+				return { unit, 1, true };
+			}
+		}
+
+		inline size_t wideUnits(char32_t cp) {
+			return (sizeof(wchar_t) == 2 && cp >= 0x10000) ? 2 : 1;
+		}
+
+		inline size_t utf8Units(char32_t cp) {
+			if (cp < 0x80) return 1;
+			if (cp < 0x800) return 2;
+			if (cp < 0x10000) return 3;
+			return 4;
+		}
+
+		inline wchar_t* putWide(wchar_t* out, char32_t cp) {
+			if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+				cp -= 0x10000;
+				*out++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+				*out++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+			}
+			else {
+				*out++ = static_cast<wchar_t>(cp);
+			}
+			return out;
+		}
+
+		inline char* putUtf8(char* out, char32_t cp) {
+			if (cp < 0x80) {
+				*out++ = static_cast<char>(cp);
+			}
+			else if (cp < 0x800) {
+				*out++ = static_cast<char>(0xC0 | (cp >> 6));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else if (cp < 0x10000) {
+				*out++ = static_cast<char>(0xE0 | (cp >> 12));
+				*out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			else {
+				*out++ = static_cast<char>(0xF0 | (cp >> 18));
+				*out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+				*out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+				*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			}
+			return out;
+		}
+
+		// Length of the ASCII run at the start of [p, end). If out is set, the run is also widened into it.
+		inline size_t asciiRun(unsigned char const* p, unsigned char const* end, wchar_t* out) {
+			size_t count = 0;
+			size_t size = static_cast<size_t>(end - p);
+#if LATITE_UTF_SSE2
+			__m128i zero = _mm_setzero_si128();
+			for (; count + 16 <= size; count += 16) {
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + count));
+				if (_mm_movemask_epi8(bytes) != 0) break;
+				if (out) {
+					__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+					__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+					if constexpr (sizeof(wchar_t) == 2) {
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), lo);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 8), hi);
+					}
+					else {
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), _mm_unpacklo_epi16(lo, zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 4), _mm_unpackhi_epi16(lo, zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 8), _mm_unpacklo_epi16(hi, zero));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count + 12), _mm_unpackhi_epi16(hi, zero));
+					}
+				}
+			}
+#endif
+			for (; count < size && p[count] < 0x80; count++) {
+				if (out) out[count] = static_cast<wchar_t>(p[count]);
+			}
+			return count;
+		}
+
+		// Length of the ASCII run at the start of [p, end). If out is set, the run is also narrowed into it.
+		inline size_t asciiRun(wchar_t const* p, wchar_t const* end, char* out) {
+			size_t count = 0;
+			size_t size = static_cast<size_t>(end - p);
+#if LATITE_UTF_SSE2
+			__m128i zero = _mm_setzero_si128();
+			if constexpr (sizeof(wchar_t) == 2) {
+				__m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+				for (; count + 8 <= size; count += 8) {
+					__m128i units = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + count));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, nonAscii), zero)) != 0xFFFF) break;
+					if (out) _mm_storel_epi64(reinterpret_cast<__m128i*>(out + count), _mm_packus_epi16(units, units));
+				}
+			}
+			else {
+				__m128i nonAscii = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+				for (; count + 4 <= size; count += 4) {
+					__m128i units = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + count));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(units, nonAscii), zero)) != 0xFFFF) break;
+					if (out) {
+						__m128i words = _mm_packs_epi32(units, units);
+						int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+						std::memcpy(out + count, &bytes, 4);
+					}
+				}
+			}
+#endif
+			for (; count < size && static_cast<char32_t>(p[count]) < 0x80; count++) {
+				if (out) out[count] = static_cast<char>(p[count]);
+			}
+			return count;
+		}
+
+		// Walks the input and returns the number of output units. When out is set, the output is also
+		// written into it, so it must have room for the length measured by a previous pass.
+		template <typename In, typename Out, typename Decode, typename Units, typename Put>
+		size_t transcode(In const* p, In const* end, Out* out, Policy policy, Decode decode, Units units, Put put) {
+			size_t count = 0;
+			while (p < end) {
+				size_t run = asciiRun(p, end, out ? out + count : nullptr);
+				p += run;
+				count += run;
+				if (p >= end) break;
+
+				auto dec = decode(p, end);
+				p += dec.len;
+				if (!dec.valid && policy == Policy::Skip) continue;
+				if (out) put(out + count, dec.cp);
+				count += units(dec.cp);
+			}
+			return count;
+		}
+	}
+
+	// Number of wchar_t units the UTF-8 string converts to
+	[[nodiscard]] inline size_t wideLength(std::string_view str, Policy policy = Policy::Replace) {
+		auto p = reinterpret_cast<unsigned char const*>(str.data());
+		return detail::transcode(p, p + str.size(), static_cast<wchar_t*>(nullptr), policy, detail::decodeUtf8, detail::wideUnits, detail::putWide);
+	}
+
+	// Number of UTF-8 bytes the wide string converts to
+	[[nodiscard]] inline size_t utf8Length(std::wstring_view str, Policy policy = Policy::Replace) {
+		return detail::transcode(str.data(), str.data() + str.size(), static_cast<char*>(nullptr), policy, detail::decodeWide, detail::utf8Units, detail::putUtf8);
+	}
+
+	// Converts into a caller-provided buffer (not null terminated). Returns the converted length;
+	// if that's more than out.size(), nothing is written.
+	inline size_t toWide(std::string_view str, std::span<wchar_t> out, Policy policy = Policy::Replace) {
+		size_t len = wideLength(str, policy);
+		if (len > out.size()) return len;
+		auto p = reinterpret_cast<unsigned char const*>(str.data());
+		detail::transcode(p, p + str.size(), out.data(), policy, detail::decodeUtf8, detail::wideUnits, detail::putWide);
+		return len;
+	}
+
+	inline size_t toUtf8(std::wstring_view str, std::span<char> out, Policy policy = Policy::Replace) {
+		size_t len = utf8Length(str, policy);
+		if (len > out.size()) return len;
+		detail::transcode(str.data(), str.data() + str.size(), out.data(), policy, detail::decodeWide, detail::utf8Units, detail::putUtf8);
+		return len;
+	}
+
+	// Converts onto the end of `out`, keeping what's already there
+	inline void appendWide(std::string_view str, std::wstring& out, Policy policy = Policy::Replace) {
+		size_t old = out.size();
+		out.resize(old + wideLength(str, policy));
+		auto p = reinterpret_cast<unsigned char const*>(str.data());
+		detail::transcode(p, p + str.size(), out.data() + old, policy, detail::decodeUtf8, detail::wideUnits, detail::putWide);
+	}
+
+	inline void appendUtf8(std::wstring_view str, std::string& out, Policy policy = Policy::Replace) {
+		size_t old = out.size();
+		out.resize(old + utf8Length(str, policy));
+		detail::transcode(str.data(), str.data() + str.size(), out.data() + old, policy, detail::decodeWide, detail::utf8Units, detail::putUtf8);
+	}
+
+	[[nodiscard]] inline std::wstring toWide(std::string_view str, Policy policy = Policy::Replace) {
+		std::wstring ret;
+		appendWide(str, ret, policy);
+		return ret;
+	}
+
+	[[nodiscard]] inline std::string toUtf8(std::wstring_view str, Policy policy = Policy::Replace) {
+		std::string ret;
+		appendUtf8(str, ret, policy);
+		return ret;
+	}
+}
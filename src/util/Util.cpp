@@ -6,6 +6,8 @@
 #include "sdk/common/client/renderer/game/LevelRenderer.h"
 #include "client/Latite.h"
 #include "client/render/Renderer.h"
+#include "client/input/KeybindTable.h"
+#include "FormatTemplate.h"
 
 #ifdef min
 #undef min
@@ -158,73 +160,41 @@ std::filesystem::path util::GetLatitePath() {
 }
 
 std::wstring util::StrToWStr(std::string const& s) {
-    int slength = static_cast<int>(s.length()) + 1;
-    int len = MultiByteToWideChar(CP_UTF8, 0, s.c_str(), slength, 0, 0);
-    wchar_t* buf = new wchar_t[len];
-    MultiByteToWideChar(CP_UTF8, 0, s.c_str(), slength, buf, len);
-    std::wstring r(buf);
-    delete[] buf;
-    return r;
+    return utf::toWide(s);
 }
 
 std::string util::WStrToStr(std::wstring const& ws) {
-    std::string ret;
-    int len = WideCharToMultiByte(CP_UTF8, 0, ws.c_str(), static_cast<int>(ws.size()), NULL, 0, NULL, NULL);
-    if (len > 0) {
-        ret.resize(len);
-        WideCharToMultiByte(CP_UTF8, 0, ws.c_str(), static_cast<int>(ws.size()), &ret[0], len, NULL, NULL);
-    }
-    return ret;
+    return utf::toUtf8(ws);
 }
 
 std::string util::Format(std::string const& s) {
     std::string out;
-
-    for (auto& ch : s) {
-        if (ch == '&') {
-            out += (char)0xC2;
-            out += (char)0xA7;
-        }
-        else out += ch;
+    out.reserve(s.size() + std::count(s.begin(), s.end(), '&'));
+
+    size_t start = 0;
+    for (size_t amp = s.find('&'); amp != std::string::npos; amp = s.find('&', start)) {
+        out.append(s, start, amp - start);
+        out += (char)0xC2;
+        out += (char)0xA7;
+        start = amp + 1;
     }
+    out.append(s, start);
     return out;
 }
 
 std::wstring util::WFormat(std::wstring const& s) {
-    std::wstring out;
-
-    for (auto& ch : s) {
-        if (ch == L'&') {
-            out += L'';
-        }
-        else out += ch;
-    }
+    std::wstring out = s;
+    std::replace(out.begin(), out.end(), L'&', FormatTemplate::colorCode);
     return out;
 }
 
 std::wstring util::FormatWString(std::wstring const& formatString, std::vector<std::wstring> const& formatArgs) {
-    std::wstringstream result;
-    size_t argIndex = 0;
-    size_t pos = 0;
-
-    while (pos < formatString.length()) {
-        if (formatString[pos] == L'{' && (pos + 1 < formatString.length()) && formatString[pos + 1] == L'}') {
-            if (argIndex >= formatArgs.size()) {
-                throw std::invalid_argument("Not enough arguments provided for the format string.");
-            }
-            result << formatArgs[argIndex++];
-            pos += 2; // Skip over the "{}"
-        }
-        else {
-            result << formatString[pos++];
-        }
-    }
+    // the same few templates are formatted over and over, so keep them parsed
+    thread_local FormatTemplateCache cache;
 
-    if (argIndex < formatArgs.size()) {
-        throw std::invalid_argument("Too many arguments provided for the format string.");
-    }
-
-    return result.str();
+    std::wstring result;
+    cache.get(formatString).render(result, formatArgs);
+    return result;
 }
 
 std::wstring util::GetClipboardText() {
@@ -273,6 +243,14 @@ void util::SetClipboardText(std::wstring const& text) {
 }
 
 std::string util::KeyToString(int key) {
+    if (keybind::getModifiers(key) != keybind::None) {
+        std::string prefix;
+        if (key & keybind::Ctrl) prefix += "Ctrl + ";
+        if (key & keybind::Shift) prefix += "Shift + ";
+        if (key & keybind::Alt) prefix += "Alt + ";
+        return prefix + KeyToString(keybind::getKey(key));
+    }
+
     if (key > 0x40 && key < 0x5B) {
         return std::string(1, (char)key);
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <filesystem>
+#include "Utf.h"
 #include "api/scanner/Scanner.h"
 
 namespace d2d {
@@ -1,5 +1,6 @@
 #pragma once
 #include "xorstr.hpp"
+#include "Utf.h"
 
 #ifdef LATITE_DEBUG
 #define XOR_STRING
@@ -7,4 +8,4 @@
 #define XOR_STRING xorstr_
 #endif
 
-#define XW(x) util::StrToWStr(XOR_STRING(x))
+#define XW(x) utf::toWide(XOR_STRING(x))
@@ -0,0 +1,54 @@
+#include "client/feature/command/CommandParser.h"
+#include <cassert>
+#include <cstdio>
+#include <initializer_list>
+#include <string_view>
+
+namespace {
+	bool tokensAre(std::string_view line, std::initializer_list<std::string_view> expected) {
+		CommandLine parsed{ line };
+		if (parsed.size() != expected.size()) return false;
+		size_t i = 0;
+		for (auto token : expected) {
+			if (parsed[i++] != token) return false;
+		}
+		return true;
+	}
+
+	void testCommandLine() {
+		assert(tokensAre("", {}));
+		assert(tokensAre("  \t ", {}));
+		assert(tokensAre("toggle  Zoom\tnow ", { "toggle", "Zoom", "now" }));
+		assert(tokensAre(R"(say "hello world" "")", { "say", "hello world", "" }));
+		assert(tokensAre(R"(a"b c"d)", { "ab cd" }));
+		assert(tokensAre(R"(a\ b \"c\" d\)", { "a b", "\"c\"", "d\\" }));
+
+		CommandLine unterminated{ R"(say "hello world)" };
+		assert(unterminated.hasUnterminatedQuote() && unterminated.size() == 2 && unterminated[1] == "hello world");
+		assert(!CommandLine{ R"(say "hi")" }.hasUnterminatedQuote());
+	}
+
+	void testIndex() {
+		CommandIndex<int> index;
+		assert(index.add("toggle", 1));
+		assert(index.add("t", 1));
+		assert(index.add("Help", 2));
+		// taken, whatever the case
+		assert(!index.add("TOGGLE", 3));
+
+		assert(index.find("Toggle") && *index.find("Toggle") == 1);
+		assert(index.find("T") && *index.find("T") == 1);
+		assert(index.find("help") && *index.find("help") == 2);
+		assert(!index.find("tog") && !index.find(""));
+		assert(index.size() == 3);
+
+		index.clear();
+		assert(index.size() == 0 && !index.find("toggle"));
+	}
+}
+
+int main() {
+	testCommandLine();
+	testIndex();
+	std::puts("ok");
+}
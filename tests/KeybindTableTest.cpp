@@ -0,0 +1,107 @@
+#include "client/input/KeybindTable.h"
+#include <cassert>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace {
+	constexpr int shift = 0x10, ctrl = 0x11, alt = 0x12, lctrl = 0xA2, k = 'K', j = 'J';
+
+	struct Key {
+		int key;
+		bool down;
+	};
+
+	// Feeds a key sequence to a capture like ClickGUI does, with the modifier state from a table fed the same keys
+	int capture(bool allowChords, std::vector<Key> const& keys) {
+		KeybindTable<int> state;
+		keybind::Capture capture;
+		capture.start(allowChords);
+		for (auto [key, down] : keys) {
+			state.updateKeyState(key, down);
+			if (int bind = capture.onKey(key, down, state.getHeldModifiers())) return bind;
+		}
+		return 0;
+	}
+
+	void testCapture() {
+		// Ctrl then K is Ctrl+K, not Ctrl
+		assert(capture(true, { { ctrl, true }, { k, true } }) == keybind::makeChord(k, keybind::Ctrl));
+		assert(capture(true, { { lctrl, true }, { shift, true }, { k, true } }) == keybind::makeChord(k, keybind::Ctrl | keybind::Shift));
+		assert(capture(true, { { k, true } }) == k);
+		// held modifiers repeat their keydown
+		assert(capture(true, { { alt, true }, { alt, true }, { alt, true }, { k, true } }) == keybind::makeChord(k, keybind::Alt));
+
+		// a modifier on its own, once it's released
+		assert(capture(true, { { ctrl, true } }) == 0);
+		assert(capture(true, { { ctrl, true }, { ctrl, false } }) == ctrl);
+		// a modifier let go of before the key isn't part of it
+		assert(capture(true, { { shift, true }, { ctrl, true }, { shift, false }, { ctrl, false }, { k, true } }) == k);
+		// nor is a key still held from before
+		assert(capture(true, { { k, false }, { j, true } }) == j);
+
+		// without chords it's whatever is pressed first
+		assert(capture(false, { { ctrl, true }, { k, true } }) == ctrl);
+		assert(capture(false, { { k, false }, { j, true } }) == j);
+	}
+
+	using Event = std::pair<int, KeybindTable<int>::Action>;
+
+	std::vector<Event> press(KeybindTable<int>& table, int key, bool down) {
+		std::vector<Event> events;
+		table.onKey(key, down, [&](int target, KeybindTable<int>::Action action) { events.emplace_back(target, action); });
+		return events;
+	}
+
+	std::vector<Event> only(int target, KeybindTable<int>::Action action) {
+		return { { target, action } };
+	}
+
+	void testDispatch() {
+		using Action = KeybindTable<int>::Action;
+		KeybindTable<int> table;
+		table.bind(k, 1);
+		table.bind(keybind::makeChord(k, keybind::Ctrl), 2);
+		table.bind(keybind::makeChord(k, keybind::Ctrl | keybind::Shift), 3);
+		table.bind(j, 4, true);
+		table.bind(0, 5);
+
+		assert(press(table, k, true) == only(1, Action::Toggle));
+		assert(press(table, k, false).empty());
+
+		// a chord takes the key from the plain binding
+		press(table, lctrl, true);
+		assert(table.getHeldModifiers() == keybind::Ctrl);
+		assert(press(table, k, true) == only(2, Action::Toggle));
+		press(table, shift, true);
+		assert(press(table, k, true) == only(3, Action::Toggle));
+
+		// no chord for Ctrl+Alt, so it's the plain binding
+		press(table, shift, false);
+		press(table, alt, true);
+		assert(press(table, k, true) == only(1, Action::Toggle));
+		press(table, alt, false);
+		press(table, lctrl, false);
+		assert(table.getHeldModifiers() == keybind::None);
+
+		// hold to toggle is released whatever is held by then
+		assert(press(table, j, true) == only(4, Action::Enable));
+		press(table, ctrl, true);
+		assert(press(table, j, false) == only(4, Action::Disable));
+		press(table, ctrl, false);
+
+		// binding 0 is ignored
+		for (int key = 0; key < 0x100; key++) {
+			for (auto& binding : table.getBindings(key)) assert(binding.target != 5);
+		}
+
+		table.clear();
+		assert(press(table, k, true).empty());
+	}
+}
+
+int main() {
+	testCapture();
+	testDispatch();
+	std::puts("ok");
+}
@@ -0,0 +1,69 @@
+#include "util/LMathBatch.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LatiteMath::batch;
+
+namespace {
+	// keeps results alive so the loops aren't optimized away
+	volatile float sink;
+
+	template <typename Fn>
+	double nanosPerElement(size_t count, Fn&& fn) {
+		// enough repeats for about ten million elements in total
+		size_t repeats = std::max<size_t>(10'000'000 / count, 1);
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < repeats; i++) fn();
+		auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		return elapsed / static_cast<double>(repeats * count);
+	}
+}
+
+int main() {
+	std::mt19937 rng{ 35 };
+	std::uniform_real_distribution<float> coord(-100.f, 100.f);
+	std::uniform_real_distribution<float> extent(0.f, 2.f);
+	Vec3 to = { 1.f, 2.f, 3.f };
+
+	std::printf("%zu wide\n%8s %22s %22s\n", detail::WideOps::width, "count", "distance ns/elem", "aabb distance ns/elem");
+	for (size_t count : { 10, 100, 10'000 }) {
+		std::vector<Vec3> points;
+		std::vector<AABB> boxes;
+		Vec3Array pointArray;
+		AABBArray boxArray;
+		for (size_t i = 0; i < count; i++) {
+			Vec3 point = { coord(rng), coord(rng), coord(rng) };
+			AABB box = { point, { point.x + extent(rng), point.y + extent(rng), point.z + extent(rng) } };
+			points.push_back(point);
+			boxes.push_back(box);
+			pointArray.push_back(point);
+			boxArray.push_back(box);
+		}
+		std::vector<float> out(count);
+
+		double scalarDistance = nanosPerElement(count, [&] {
+			for (size_t i = 0; i < count; i++) out[i] = points[i].distanceSquared(to);
+			sink = out[count - 1];
+			});
+		double batchDistance = nanosPerElement(count, [&] {
+			distanceSquared(pointArray, to, out.data());
+			sink = out[count - 1];
+			});
+		double scalarBox = nanosPerElement(count, [&] {
+			for (size_t i = 0; i < count; i++) {
+				auto& bb = boxes[i];
+				Vec3 closest = { std::clamp(to.x, bb.lower.x, bb.higher.x), std::clamp(to.y, bb.lower.y, bb.higher.y), std::clamp(to.z, bb.lower.z, bb.higher.z) };
+				out[i] = closest.distanceSquared(to);
+			}
+			sink = out[count - 1];
+			});
+		double batchBox = nanosPerElement(count, [&] {
+			aabbDistanceSquared(boxArray, to, out.data());
+			sink = out[count - 1];
+			});
+
+		std::printf("%8zu %10.3f -> %-9.3f %10.3f -> %-9.3f\n", count, scalarDistance, batchDistance, scalarBox, batchBox);
+	}
+}
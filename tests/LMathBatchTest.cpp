@@ -0,0 +1,190 @@
+#include "util/LMathBatch.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LatiteMath::batch;
+
+namespace {
+	std::mt19937 rng{ 35 };
+
+	float random(float lo, float hi) {
+		return std::uniform_real_distribution<float>(lo, hi)(rng);
+	}
+
+	bool near(float a, float b, float tolerance = 1e-4f) {
+		return std::fabs(a - b) <= tolerance * std::max(1.f, std::fabs(b));
+	}
+
+	// The kernel run one element at a time with ScalarOps, to compare the wide path against
+	template <template <typename> typename Kernel, typename... Args>
+	void runScalar(size_t count, Args&&... args) {
+		for (size_t i = 0; i < count; i++) Kernel<detail::ScalarOps>::apply(i, args...);
+	}
+
+	Vec3 randomPoint() {
+		return { random(-100.f, 100.f), random(-64.f, 320.f), random(-100.f, 100.f) };
+	}
+
+	AABBArray randomBoxes(size_t count) {
+		AABBArray boxes;
+		for (size_t i = 0; i < count; i++) {
+			Vec3 lower = randomPoint();
+			boxes.push_back({ lower, { lower.x + random(0.f, 2.f), lower.y + random(0.f, 2.f), lower.z + random(0.f, 2.f) } });
+		}
+		return boxes;
+	}
+
+	// util::ColorToHSV and util::HSVToColor, which the colour kernels have to match
+	void referenceToHsv(float r, float g, float b, float& h, float& s, float& v) {
+		float minVal = std::min(r, std::min(g, b));
+		float maxVal = std::max(r, std::max(g, b));
+		float delta = maxVal - minVal;
+		v = maxVal;
+		if (delta == 0) {
+			h = 0;
+			s = 0;
+			return;
+		}
+		s = delta / maxVal;
+		if (r == maxVal) h = (g - b) / delta;
+		else if (g == maxVal) h = 2 + (b - r) / delta;
+		else h = 4 + (r - g) / delta;
+		h *= 60;
+		if (h < 0) h += 360;
+	}
+
+	void referenceToRgb(float h, float s, float v, float& r, float& g, float& b) {
+		while (h >= 360.f) h -= 360.f;
+		if (s == 0) {
+			r = g = b = v;
+			return;
+		}
+		int i = static_cast<int>(std::floor(h / 60.f));
+		float f = h / 60.f - i;
+		float p = v * (1.f - s);
+		float q = v * (1.f - s * f);
+		float t = v * (1.f - s * (1.f - f));
+		switch (i) {
+		case 0: r = v; g = t; b = p; break;
+		case 1: r = q; g = v; b = p; break;
+		case 2: r = p; g = v; b = t; break;
+		case 3: r = p; g = q; b = v; break;
+		case 4: r = t; g = p; b = v; break;
+		default: r = v; g = p; b = q; break;
+		}
+	}
+
+	// every count around the vector width, so both the wide blocks and the remainder are covered
+	constexpr size_t counts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 100, 1027 };
+
+	void testDistance() {
+		for (size_t count : counts) {
+			Vec3Array points;
+			for (size_t i = 0; i < count; i++) points.push_back(randomPoint());
+			Vec3 to = randomPoint();
+
+			std::vector<float> wide(count), scalar(count), root(count);
+			distanceSquared(points, to, wide.data());
+			distance(points, to, root.data());
+			runScalar<detail::DistanceSquared>(count, points, to, scalar.data(), false);
+			for (size_t i = 0; i < count; i++) {
+				assert(wide[i] == scalar[i]);
+				assert(near(wide[i], points.get(i).distanceSquared(to)));
+				assert(near(root[i], points.get(i).distance(to)));
+			}
+		}
+	}
+
+	void testAABBs() {
+		for (size_t count : counts) {
+			auto boxes = randomBoxes(count);
+			Vec3 to = randomPoint();
+
+			std::vector<float> wide(count), scalar(count);
+			aabbDistanceSquared(boxes, to, wide.data());
+			runScalar<detail::AABBDistanceSquared>(count, boxes, to, scalar.data());
+			for (size_t i = 0; i < count; i++) {
+				assert(wide[i] == scalar[i]);
+				auto bb = boxes.get(i);
+				Vec3 closest = { std::clamp(to.x, bb.lower.x, bb.higher.x), std::clamp(to.y, bb.lower.y, bb.higher.y), std::clamp(to.z, bb.lower.z, bb.higher.z) };
+				assert(near(wide[i], closest.distanceSquared(to)));
+			}
+
+			// inside a box is distance 0
+			if (count) {
+				auto bb = boxes.get(0);
+				aabbDistanceSquared(boxes, (bb.lower + bb.higher) * 0.5f, wide.data());
+				assert(wide[0] == 0.f);
+			}
+
+			// the half-space x >= 0, and y <= 100
+			Vec4 planes[] = { { 1.f, 0.f, 0.f, 0.f }, { 0.f, -1.f, 0.f, 100.f } };
+			std::vector<uint8_t> visible(count), scalarVisible(count);
+			size_t visibleCount = cullAABBs(boxes, planes, visible.data());
+			size_t scalarCount = 0;
+			runScalar<detail::CullAABBs>(count, boxes, std::span<Vec4 const>(planes), scalarVisible.data(), scalarCount);
+			assert(visible == scalarVisible && visibleCount == scalarCount);
+			size_t expected = 0;
+			for (size_t i = 0; i < count; i++) {
+				auto bb = boxes.get(i);
+				bool inside = bb.higher.x >= 0.f && bb.lower.y <= 100.f;
+				assert(visible[i] == inside);
+				expected += inside;
+			}
+			assert(visibleCount == expected);
+		}
+	}
+
+	void testLerp() {
+		for (size_t count : counts) {
+			Vec3Array from, to, out;
+			for (size_t i = 0; i < count; i++) {
+				from.push_back(randomPoint());
+				to.push_back(randomPoint());
+			}
+			lerp(from, to, 0.3f, out);
+			assert(out.size() == count);
+			for (size_t i = 0; i < count; i++) {
+				auto a = from.get(i), b = to.get(i), o = out.get(i);
+				assert(near(o.x, std::lerp(a.x, b.x, 0.3f)) && near(o.y, std::lerp(a.y, b.y, 0.3f)) && near(o.z, std::lerp(a.z, b.z, 0.3f)));
+			}
+		}
+	}
+
+	void testColors() {
+		for (size_t count : counts) {
+			std::vector<float> h(count), s(count), v(count), r(count), g(count), b(count);
+			for (size_t i = 0; i < count; i++) {
+				// some grays and hues past 360, which the kernels wrap
+				h[i] = random(0.f, 720.f);
+				s[i] = i % 5 == 0 ? 0.f : random(0.f, 1.f);
+				v[i] = random(0.f, 1.f);
+			}
+			hsvToRgb(h.data(), s.data(), v.data(), r.data(), g.data(), b.data(), count);
+			for (size_t i = 0; i < count; i++) {
+				float er, eg, eb;
+				referenceToRgb(h[i], s[i], v[i], er, eg, eb);
+				assert(near(r[i], er) && near(g[i], eg) && near(b[i], eb));
+			}
+
+			std::vector<float> h2(count), s2(count), v2(count);
+			rgbToHsv(r.data(), g.data(), b.data(), h2.data(), s2.data(), v2.data(), count);
+			for (size_t i = 0; i < count; i++) {
+				float eh, es, ev;
+				referenceToHsv(r[i], g[i], b[i], eh, es, ev);
+				assert(near(h2[i], eh, 1e-3f) && near(s2[i], es) && near(v2[i], ev));
+			}
+		}
+	}
+}
+
+int main() {
+	testDistance();
+	testAABBs();
+	testLerp();
+	testColors();
+	std::printf("ok (%zu wide)\n", detail::WideOps::width);
+}
@@ -0,0 +1,109 @@
+#include "util/LRUCache.h"
+#include "client/render/TextLayoutKey.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace {
+	void testLRU() {
+		LRUCache<int, std::string> cache{ 3 };
+		cache.put(1, "one");
+		cache.put(2, "two");
+		cache.put(3, "three");
+		assert(cache.get(1) && *cache.get(1) == "one");
+
+		// 2 is the least recently used now
+		cache.put(4, "four");
+		assert(!cache.get(2));
+		assert(cache.get(1) && cache.get(3) && cache.get(4));
+
+		cache.put(3, "drei");
+		assert(*cache.get(3) == "drei" && cache.size() == 3);
+
+		cache.setCapacity(1);
+		assert(cache.size() == 1 && cache.get(3));
+
+		auto stats = cache.getStats();
+		assert(stats.evictions == 3 && stats.capacity == 1 && stats.size == 1);
+		assert(stats.misses == 1);
+
+		cache.clear();
+		assert(cache.size() == 0 && !cache.get(3));
+
+		LRUCache<int, int> zero{ 0 };
+		zero.put(1, 1);
+		assert(zero.getCapacity() == 1 && zero.size() == 1);
+	}
+
+	// Stands in for IDWriteTextLayout
+	struct FakeLayout {
+		std::wstring text;
+		float size;
+	};
+
+	struct LayoutCache {
+		LRUCache<TextLayoutKey, std::shared_ptr<FakeLayout>, TextLayoutKeyHash, TextLayoutKeyEqual> cache{ 4 };
+		int created = 0;
+
+		std::shared_ptr<FakeLayout> get(TextLayoutKeyView const& key) {
+			return cache.getOrCreate(key, [&](TextLayoutKeyView const& key) {
+				created++;
+				return std::make_shared<FakeLayout>(FakeLayout{ std::wstring(key.text), key.size });
+				});
+		}
+	};
+
+	TextLayoutKeyView keyFor(std::wstring_view text, float size, float maxWidth = 100.f) {
+		return { text, nullptr, size, maxWidth, 50.f, DWRITE_TEXT_ALIGNMENT_LEADING, DWRITE_PARAGRAPH_ALIGNMENT_NEAR };
+	}
+
+	void testLayoutCache() {
+		LayoutCache layouts;
+
+		// found again from a view into a different string
+		std::wstring text = L"Hello";
+		auto hello = layouts.get(keyFor(text, 12.f));
+		assert(layouts.get(keyFor(std::wstring(L"Hello"), 12.f)) == hello && layouts.created == 1);
+
+		// every field is part of the key
+		assert(layouts.get(keyFor(text, 13.f)) != hello);
+		assert(layouts.get(keyFor(text, 12.f, 101.f)) != hello);
+		auto centered = keyFor(text, 12.f);
+		centered.alignment = DWRITE_TEXT_ALIGNMENT_CENTER;
+		assert(layouts.get(centered) != hello);
+		assert(layouts.created == 4);
+
+		// a key that's equal has to hash the same, or the map loses it: -0 and NaN compare differently to their bits
+		TextLayoutKeyHash hash;
+		TextLayoutKeyEqual equal;
+		auto zero = keyFor(text, 0.f), negativeZero = keyFor(text, -0.f);
+		assert(!equal(zero, negativeZero) || hash(zero) == hash(negativeZero));
+		auto nan = keyFor(text, std::numeric_limits<float>::quiet_NaN());
+		assert(equal(nan, nan) && equal(TextLayoutKey(nan), nan));
+
+		int before = layouts.created;
+		auto nanLayout = layouts.get(nan);
+		assert(layouts.get(nan) == nanLayout && layouts.created == before + 1);
+		auto zeroLayout = layouts.get(zero);
+		auto negativeZeroLayout = layouts.get(negativeZero);
+		assert(layouts.get(zero) == zeroLayout && layouts.get(negativeZero) == negativeZeroLayout);
+
+		// evicted past capacity, least recently used first
+		layouts.cache.clear();
+		layouts.created = 0;
+		for (int i = 0; i < 6; i++) layouts.get(keyFor(std::to_wstring(i), 12.f));
+		assert(layouts.cache.size() == 4 && layouts.created == 6);
+		layouts.get(keyFor(L"2", 12.f));
+		layouts.get(keyFor(L"0", 12.f));
+		assert(layouts.created == 7);
+	}
+}
+
+int main() {
+	testLRU();
+	testLayoutCache();
+	std::puts("ok");
+}
@@ -0,0 +1,17 @@
+#pragma once
+// The little of DirectWrite that the headers under test name, so they build without the Windows SDK
+
+struct IDWriteTextFormat;
+
+enum DWRITE_TEXT_ALIGNMENT {
+	DWRITE_TEXT_ALIGNMENT_LEADING,
+	DWRITE_TEXT_ALIGNMENT_TRAILING,
+	DWRITE_TEXT_ALIGNMENT_CENTER,
+	DWRITE_TEXT_ALIGNMENT_JUSTIFIED,
+};
+
+enum DWRITE_PARAGRAPH_ALIGNMENT {
+	DWRITE_PARAGRAPH_ALIGNMENT_NEAR,
+	DWRITE_PARAGRAPH_ALIGNMENT_FAR,
+	DWRITE_PARAGRAPH_ALIGNMENT_CENTER,
+};